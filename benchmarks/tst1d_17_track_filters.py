@@ -0,0 +1,89 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Track filters: the same filter compiled and evaluated by python on two identical
+# electron species, and a filter depending on Main.iteration on frozen ions
+
+import math
+L  = 1.12			# wavelength=simulation box length
+dx = 0.01			# cell length
+dn = 0.01			# amplitude of the perturbation
+T  = 4000			# number of timesteps
+
+
+Main(
+    geometry = "1Dcartesian",
+     
+    interpolation_order = 2,
+     
+    cell_length = [dx],
+    grid_length  = [L],
+    
+    number_of_patches = [ 16 ],
+    
+    timestep = 0.0095,
+    number_of_timesteps = T,
+     
+    EM_boundary_conditions = [ ['periodic'] ],
+     
+    random_seed = smilei_mpi_rank
+)
+
+
+Species(
+	name = "ion",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 8,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = 1.,
+	boundary_conditions = [
+		["periodic", "periodic"],
+	],
+	time_frozen = 100.
+)
+for name in ["eon_compiled", "eon_python"]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "cold",
+		particles_per_cell = 16,
+		mass = 1.0,
+		charge = -1.0,
+		number_density = cosine(0.5,xamplitude=dn,xlength=L, xnumber=1),
+		boundary_conditions = [
+			["periodic", "periodic"],
+		],
+	)
+
+
+DiagScalar(
+    every = 100,
+)
+
+# This filter is compiled
+DiagTrackParticles(
+	species = "eon_compiled",
+	every = [250, 250],
+	filter = lambda particles: (particles.px>0.) & (particles.x<L/2.),
+	attributes = ["x", "px", "Ex"]
+)
+
+# Reading Main.iteration prevents the compilation: this filter is evaluated by python
+DiagTrackParticles(
+	species = "eon_python",
+	every = [250, 250],
+	filter = lambda particles: (particles.px>0.) & (particles.x<L/2.) | (Main.iteration<0),
+	attributes = ["x", "px", "Ex"],
+	buffered_steps = 3
+)
+
+# The selected region grows with the iteration
+DiagTrackParticles(
+	species = "ion",
+	every = [500, 500],
+	filter = lambda particles: particles.x < L * Main.iteration / T,
+	attributes = ["x"],
+	buffered_steps = 2
+)
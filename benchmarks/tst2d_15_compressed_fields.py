@@ -0,0 +1,84 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Same fields written without compression, with lossless compression
+# (with and without aggregation of the fields) and with lossy compression
+
+from math import pi
+
+l0 = 2.0*pi             # laser wavelength
+t0 = l0                 # optical cycle
+Lsim = [10.*l0,10.*l0]  # length of the simulation
+Tsim = 12.*t0           # duration of the simulation
+resx = 16.              # nb of cells in on laser wavelength
+rest = 24.              # time of timestep in one optical cycle
+
+Main(
+    geometry = "2Dcartesian",
+    
+    interpolation_order = 2 ,
+    
+    cell_length = [l0/resx,l0/resx],
+    grid_length  = Lsim,
+    
+    number_of_patches = [ 4, 4 ],
+    
+    timestep = t0/rest,
+    simulation_time = Tsim,
+     
+    EM_boundary_conditions = [
+        ['silver-muller'],
+        ['periodic'],
+    ],
+    
+    random_seed = smilei_mpi_rank
+)
+
+LaserGaussian2D(
+    a0              = 2.,
+    omega           = 1.,
+    focus           = [3.*l0, Lsim[1]/2.],
+    waist           = 2.*l0,
+    time_envelope   = tgaussian(fwhm=3.*t0, center=4.*t0)
+)
+
+Species(
+	name = "eon",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 4,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = trapezoidal(0.05, xvacuum=3.*l0, xplateau=10.*l0),
+	boundary_conditions = [
+		["remove", "remove"],
+		["periodic", "periodic"],
+	],
+)
+
+
+globalEvery = int(rest)
+fields = ['Ex','Ey','Bz','Jx','Rho_eon']
+
+DiagFields(
+    every = globalEvery,
+    fields = fields
+)
+DiagFields(
+    every = globalEvery,
+    fields = fields,
+    compression = "deflate"
+)
+DiagFields(
+    every = globalEvery,
+    fields = fields,
+    compression = "deflate",
+    compression_level = 9,
+    aggregate_fields = True
+)
+DiagFields(
+    every = globalEvery,
+    fields = fields,
+    compression = "scaleoffset",
+    compression_level = 4
+)
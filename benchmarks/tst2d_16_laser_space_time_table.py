@@ -0,0 +1,66 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# The same non-separable laser enters from both sides of the box: tabulated
+# (space_time_table) from xmin and evaluated by python from xmax.
+# The fields must be symmetric with respect to the middle of the box.
+
+from math import pi, sin, exp
+
+l0 = 2.0*pi             # laser wavelength
+t0 = l0                 # optical cycle
+Lsim = [16.*l0,8.*l0]   # length of the simulation
+Tsim = 11.*t0           # duration of the simulation
+resx = 16.              # nb of cells in on laser wavelength
+rest = 32.              # time of timestep in one optical cycle
+Tlaser = 6.*t0          # duration of the laser
+
+Main(
+    geometry = "2Dcartesian",
+    
+    interpolation_order = 2 ,
+    
+    cell_length = [l0/resx,l0/resx],
+    grid_length  = Lsim,
+    
+    number_of_patches = [ 8, 4 ],
+    
+    timestep = t0/rest,
+    simulation_time = Tsim,
+     
+    EM_boundary_conditions = [
+        ['silver-muller'],
+        ['periodic'],
+    ],
+    
+    random_seed = smilei_mpi_rank
+)
+
+# Tilted pulse with a different profile on each component
+def profile(phase, waist):
+	def f(y, t):
+		if t<0. or t>Tlaser: return 0.
+		y0 = y - Lsim[1]/2.
+		return sin(pi*t/Tlaser)**2 * exp(-(y0/waist)**2) * sin(t - 0.2*y0 + phase)
+	return f
+
+space_time_profile = [ profile(0., 1.5*l0), profile(pi/3., 2.*l0) ]
+
+Laser(
+    box_side = "xmin",
+    space_time_profile = space_time_profile,
+    space_time_table = [0., Tlaser, 48*6+1]
+)
+
+Laser(
+    box_side = "xmax",
+    space_time_profile = space_time_profile
+)
+
+
+globalEvery = int(rest)
+
+DiagFields(
+    every = globalEvery,
+    fields = ['Ex','Ey','Ez']
+)
@@ -0,0 +1,72 @@
+# ------------------------------------------------------------------------------
+# Thermal plasma filling half of a 3D box, with the adaptive vectorization
+# driven by a cost model measured at startup and cached in a file
+# ------------------------------------------------------------------------------
+
+import math as m
+
+Te = 100./511.   # electron & ion temperature in me c^2
+n0 = 1.
+
+# Debye length in units of c/\omega_{pe}
+Lde = m.sqrt(Te)
+
+cell_length = [0.5*Lde,0.5*Lde,0.5*Lde]
+
+# timestep (0.95 x CFL)
+dt  = 0.95 * cell_length[0]/m.sqrt(3.)
+
+# Small patches that can fit in cache
+cells_per_patch = [8,8,8]
+patches = [4,4,4]
+
+# grid length
+grid_length = [cells_per_patch[i]*patches[i]*cell_length[i] for i in range(3)]
+
+def n0_(x,y,z):
+  if x > grid_length[0]*0.5:
+    return n0
+  else:
+    return 0.
+
+Main(
+    geometry = "3Dcartesian",
+
+    interpolation_order = 2,
+
+    timestep = dt,
+    simulation_time = 100*dt,
+
+    cell_length  = cell_length,
+    grid_length = grid_length,
+
+    number_of_patches = patches,
+
+    EM_boundary_conditions = [["periodic"]],
+
+    random_seed = smilei_mpi_rank
+)
+
+Vectorization(
+    mode = "adaptive",
+    reconfigure_every = 20,
+    cost_model = "benchmark",
+    cost_model_file = "cost_model.txt",
+)
+
+for name, charge in [["positron", 1.], ["electron", -1.]]:
+    Species(
+        name = name,
+        position_initialization = "random",
+        momentum_initialization = "mj",
+        particles_per_cell = 8,
+        mass = 1.0,
+        charge = charge,
+        charge_density = n0_,
+        mean_velocity = [0., 0.0, 0.0],
+        temperature = [Te],
+        pusher = "boris",
+        boundary_conditions = [["periodic"]],
+    )
+
+DiagScalar(every = 5)
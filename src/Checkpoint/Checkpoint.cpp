@@ -9,6 +9,7 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <cstdio>
 
 #include <mpi.h>
 
@@ -46,7 +47,10 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     keep_n_dumps_max( 10000 ),
     dump_deflate( 0 ),
     dump_request( smpi->getSize() ),
-    file_grouping( 0 )
+    file_grouping( 0 ),
+    async_dump( false ),
+    dump_image_size( 0 ),
+    dump_thread_error( false )
 {
 
     if( PyTools::nComponents( "Checkpoints" ) > 0 ) {
@@ -84,6 +88,11 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             MESSAGE( 1, "Code will group checkpoint files by "<< file_grouping );
         }
         
+        PyTools::extract( "async_dump", async_dump, "Checkpoints" );
+        if( async_dump ) {
+            MESSAGE( 1, "Dumps are built in memory and written on disk asynchronously" );
+        }
+        
         if( params.restart ) {
             std::vector<std::string> restart_files;
             PyTools::extract( "restart_files", restart_files, "Checkpoints" );
@@ -145,6 +154,13 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     nDim_particle=params.nDim_particle;
 }
 
+Checkpoint::~Checkpoint()
+{
+    if( dump_thread.joinable() ) {
+        dump_thread.join();
+    }
+}
+
 void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *smpi, SimWindow *simWindow, Params &params )
 {
 
@@ -186,6 +202,7 @@ void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *s
 void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin,  Params &params )
 {
     unsigned int num_dump=dump_number % keep_n_dumps;
+    unsigned int ibuffer=dump_number % 2;
     
     ostringstream nameDumpTmp( "" );
     nameDumpTmp << "checkpoints" << PATH_SEPARATOR;
@@ -197,7 +214,16 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     std::string dumpName=nameDumpTmp.str();
     
     
-    hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+    // In the asynchronous mode, the file is built in memory (HDF5 core driver).
+    // The memory grows by increments of the size of the previous dump.
+    hid_t fapl = H5P_DEFAULT;
+    if( async_dump ) {
+        size_t increment = max( ( size_t )( 64<<20 ), dump_image_size );
+        fapl = H5Pcreate( H5P_FILE_ACCESS );
+        H5Pset_fapl_core( fapl, increment, 0 );
+    }
+    
+    hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
     dump_number++;
     
 #ifdef  __DEBUG
@@ -242,6 +268,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
             if( DiagnosticScreen *screen = dynamic_cast<DiagnosticScreen *>( vecPatches.globalDiags[idiag] ) ) {
                 diagName.str( "" );
                 diagName << "DiagScreen" << screen->screen_id;
+                screen->reduceThreads();
                 H5::vect( fid, diagName.str(), screen->data_sum );
             }
         }
@@ -259,7 +286,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         dumpPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, vecPatches( ipatch )->vecCollisions, params, patch_gid );
         
         // Random number generator state
-        H5::attr( patch_gid, "xorshift32_state", vecPatches( ipatch )->xorshift32_state );
+        H5::attr( patch_gid, "random_state", vecPatches( ipatch )->rand_->getState() );
         
         // Close a group
         H5Gclose( patch_gid );
@@ -269,6 +296,8 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     // Write the latest Id that the MPI processes have given to each species
     for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
         if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
+            // Tracked particles held in memory would be lost at restart
+            track->writeBuffer();
             ostringstream n( "" );
             n<< "latest_ID_" << vecPatches( 0 )->vecSpecies[track->speciesId_]->name_;
             H5::attr( fid, n.str().c_str(), track->latest_Id, H5T_NATIVE_UINT64 );
@@ -280,10 +309,52 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         dumpMovingWindow( fid, simWin );
     }
     
-    H5Fclose( fid );
+    if( async_dump ) {
+        // Copy the file image: the simulation may now modify the data
+        H5Fflush( fid, H5F_SCOPE_GLOBAL );
+        ssize_t image_size = H5Fget_file_image( fid, NULL, 0 );
+        if( image_size < 0 ) {
+            ERROR( "Cannot get the image of the dump file " << dumpName );
+        }
+        dump_image_size = image_size;
+        dump_image[ibuffer].resize( image_size );
+        H5Fget_file_image( fid, &dump_image[ibuffer][0], image_size );
+        H5Fclose( fid );
+        H5Pclose( fapl );
+        
+        // The previous dump must be complete before starting a new one
+        waitDump();
+        dump_thread_file = dumpName;
+        dump_thread = std::thread( writeDumpImage, &dump_image[ibuffer], dumpName, &dump_thread_error );
+    } else {
+        H5Fclose( fid );
+    }
     
 }
 
+void Checkpoint::waitDump()
+{
+    if( ! dump_thread.joinable() ) {
+        return;
+    }
+    dump_thread.join();
+    if( dump_thread_error ) {
+        ERROR( "Cannot write the dump file " << dump_thread_file );
+    }
+}
+
+void Checkpoint::writeDumpImage( std::vector<char> *image, std::string file_name, bool *error )
+{
+    *error = true;
+    FILE *file = fopen( file_name.c_str(), "wb" );
+    if( file ) {
+        size_t written = fwrite( image->data(), 1, image->size(), file );
+        *error = ( fclose( file ) != 0 ) || ( written != image->size() );
+    }
+    // Release the memory until the next dump
+    std::vector<char>().swap( *image );
+}
+
 void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpecies, std::vector<Collisions *> &vecCollisions, Params &params, hid_t patch_gid )
 {
     if (  params.geometry != "AMcylindrical" ) {
@@ -418,20 +489,20 @@ void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpe
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Position-" << i;
-                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Position[i], dump_deflate );
+                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Position[i][0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE, dump_deflate );
             }
             
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Momentum-" << i;
-                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Momentum[i], dump_deflate );
+                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Momentum[i][0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE, dump_deflate );
             }
             
-            H5::vect( gid, "Weight", vecSpecies[ispec]->particles->Weight, dump_deflate );
-            H5::vect( gid, "Charge", vecSpecies[ispec]->particles->Charge, dump_deflate );
+            H5::vect( gid, "Weight", vecSpecies[ispec]->particles->Weight[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE, dump_deflate );
+            H5::vect( gid, "Charge", vecSpecies[ispec]->particles->Charge[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_SHORT, dump_deflate );
             
             if( vecSpecies[ispec]->particles->tracked ) {
-                H5::vect( gid, "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64, dump_deflate );
+                H5::vect( gid, "Id", vecSpecies[ispec]->particles->Id[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_UINT64, dump_deflate );
             }
             
             
@@ -550,7 +621,11 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI *smpi, SimWindo
         restartPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, vecPatches( ipatch )->vecCollisions, params, patch_gid );
         
         // Random number generator state
-        H5::getAttr( patch_gid, "xorshift32_state", vecPatches( ipatch )->xorshift32_state );
+        if( H5::hasAttr( patch_gid, "random_state" ) ) {
+            vector<unsigned int> random_state;
+            H5::getAttr( patch_gid, "random_state", random_state, H5T_NATIVE_UINT );
+            vecPatches( ipatch )->rand_->setState( random_state );
+        }
         
         H5Gclose( patch_gid );
         
@@ -733,21 +808,21 @@ void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &ve
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++ ) {
                 ostringstream namePos( "" );
                 namePos << "Position-" << i;
-                H5::getVect( gid, namePos.str(), vecSpecies[ispec]->particles->Position[i] );
+                H5::getVect( gid, namePos.str(), vecSpecies[ispec]->particles->Position[i][0], partSize, H5T_NATIVE_DOUBLE );
             }
             
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++ ) {
                 ostringstream namePos( "" );
                 namePos << "Momentum-" << i;
-                H5::getVect( gid, namePos.str(), vecSpecies[ispec]->particles->Momentum[i] );
+                H5::getVect( gid, namePos.str(), vecSpecies[ispec]->particles->Momentum[i][0], partSize, H5T_NATIVE_DOUBLE );
             }
             
-            H5::getVect( gid, "Weight", vecSpecies[ispec]->particles->Weight );
+            H5::getVect( gid, "Weight", vecSpecies[ispec]->particles->Weight[0], partSize, H5T_NATIVE_DOUBLE );
             
-            H5::getVect( gid, "Charge", vecSpecies[ispec]->particles->Charge );
+            H5::getVect( gid, "Charge", vecSpecies[ispec]->particles->Charge[0], partSize, H5T_NATIVE_SHORT );
             
             if( vecSpecies[ispec]->particles->tracked ) {
-                H5::getVect( gid, "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64 );
+                H5::getVect( gid, "Id", vecSpecies[ispec]->particles->Id[0], partSize, H5T_NATIVE_UINT64 );
             }
             
             if( params.vectorization_mode == "off" || params.vectorization_mode == "on" || params.cell_sorting ) {
@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include <thread>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -35,7 +36,7 @@ class Checkpoint
 public:
     Checkpoint( Params &params, SmileiMPI *smpi );
     //! Destructor for Checkpoint
-    virtual ~Checkpoint() {};
+    virtual ~Checkpoint();
     
     //! Space dimension of a particle
     unsigned int nDim_particle;
@@ -61,6 +62,9 @@ public:
     void dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin, Params &params );
     void dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpecies, std::vector<Collisions *> &vecCollisions, Params &params, hid_t patch_gid );
     
+    //! wait until the asynchronous dump, if any, is written on disk
+    void waitDump();
+    
     //! incremental number of times we've done a dump
     unsigned int dump_number;
     
@@ -139,6 +143,27 @@ private:
     //! group checkpoint files in subdirs of file_grouping files
     unsigned int file_grouping;
     
+    //! dump files are built in memory and written on disk by a separate thread
+    bool async_dump;
+    
+    //! in-memory images of the dump files: one is filled while the other may still be written
+    std::vector<char> dump_image[2];
+    
+    //! size of the last dump image (used to size the next one)
+    size_t dump_image_size;
+    
+    //! thread writing the last dump image on disk
+    std::thread dump_thread;
+    
+    //! name of the file written by dump_thread
+    std::string dump_thread_file;
+    
+    //! set by dump_thread when the file could not be written
+    bool dump_thread_error;
+    
+    //! write a dump image on disk and release its memory (run by dump_thread)
+    static void writeDumpImage( std::vector<char> *image, std::string file_name, bool *error );
+    
     //! restart file
     std::string restart_file;
     
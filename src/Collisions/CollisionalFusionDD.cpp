@@ -81,6 +81,21 @@ bool CollisionalFusionDD::occurs( double U, double coeff, double m1, double m2,
     }
 }
 
+// Same interpolation as in ::occurs, in a vectorized loop
+// (the extrapolation above the table range is the interpolation between the last two points)
+void CollisionalFusionDD::probabilities( unsigned int n, const double *ekin, const double *coeff, double *prob )
+{
+    const double rate_multiplier = rate_multiplier_;
+    #pragma omp simd
+    for( unsigned int j=0; j<n; j++ ) {
+        double x = a2*( a1 + log( ekin[j] ) );
+        int i = x >= 0. ? ( int ) min( x, npointsm1-1. ) : 0;
+        double a = x - ( double )i;
+        double cs = exp( ( DB_log_crossSection[i+1]-DB_log_crossSection[i] )*a + DB_log_crossSection[i] );
+        prob[j] = x >= 0. ? coeff[j] * cs * rate_multiplier : 0.;
+    }
+}
+
 void CollisionalFusionDD::makeProducts(
     double U, double ekin, double log_ekin, double q, 
     Particles *&p3, Particles *&p4,
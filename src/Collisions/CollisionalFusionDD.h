@@ -19,6 +19,8 @@ public:
     
     //! Method to apply the nuclear reaction
     bool occurs( double U, double coeff, double m1, double m2, double g1, double g2, double &ekin, double &log_ekin, double &W ) override;
+    //! Method to calculate the probabilities of the reaction for many pairs
+    void probabilities( unsigned int n, const double *ekin, const double *coeff, double *prob ) override;
     //! Method to prepare the products of the reaction
     void makeProducts( double U, double etot, double log_ekin, double q, Particles *&p3, Particles *&p4, double &p3_COM, double &p4_COM, double &q3, double &q4, double &cosX ) override;
     
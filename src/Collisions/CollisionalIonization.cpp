@@ -4,6 +4,7 @@
 #include "Species.h"
 #include "Patch.h"
 #include "IonizationTables.h"
+#include "Random.h"
 
 #include <cmath>
 
@@ -56,6 +57,7 @@ vector<int> CollisionalIonization::DB_Z;
 vector<vector<vector<double> > > CollisionalIonization::DB_crossSection;
 vector<vector<vector<double> > > CollisionalIonization::DB_transferredEnergy;
 vector<vector<vector<double> > > CollisionalIonization::DB_lostEnergy;
+vector<vector<double> > CollisionalIonization::DB_interleaved;
 
 // Initializes the databases (by patch master only)
 unsigned int CollisionalIonization::createDatabase( double reference_angular_frequency_SI )
@@ -128,11 +130,22 @@ unsigned int CollisionalIonization::createDatabase( double reference_angular_fre
         }
     }
     
+    // Same data interleaved, so that one pair reads the 3 tables in the same cache line
+    vector<double> interleaved( 3*atomic_number*npoints );
+    for( int Zstar=0; Zstar<atomic_number; Zstar++ ) {
+        for( int i=0; i<npoints; i++ ) {
+            interleaved[( Zstar*npoints+i )*3  ] = cs[Zstar][i];
+            interleaved[( Zstar*npoints+i )*3+1] = te[Zstar][i];
+            interleaved[( Zstar*npoints+i )*3+2] = le[Zstar][i];
+        }
+    }
+    
     // Add the new arrays to the static database
     DB_Z                .push_back( atomic_number );
     DB_crossSection     .push_back( cs );
     DB_transferredEnergy.push_back( te );
     DB_lostEnergy       .push_back( le );
+    DB_interleaved      .push_back( interleaved );
     
     return DB_Z.size()-1;
 }
@@ -145,6 +158,7 @@ void CollisionalIonization::assignDatabase( unsigned int index )
     crossSection      = &( DB_crossSection     [index] );
     transferredEnergy = &( DB_transferredEnergy[index] );
     lostEnergy        = &( DB_lostEnergy       [index] );
+    interleavedTable  = &( DB_interleaved      [index] );
     
 }
 
@@ -213,24 +227,65 @@ void CollisionalIonization::prepare3( double timestep, double inv_cell_volume )
     }
 }
 
-// Method to apply the ionization
-void CollisionalIonization::apply( Patch *patch, Particles *p1, int i1, Particles *p2, int i2 )
+// Method to apply the ionization to n pairs
+// Most pairs do not ionize: the first ionization of each pair is tested in a vectorized loop,
+// and ::calculate is only called for the pairs that pass this test
+void CollisionalIonization::apply( Random *rand, unsigned int n, Particles **p1, unsigned int *i1, Particles **p2, unsigned int *i2 )
 {
-    double gamma1 = p1->lor_fac( i1 );
-    double gamma2 = p2->lor_fac( i2 );
-    // Calculate lorentz factor in the frame of ion
-    double gamma_s = gamma1*gamma2
-                     - p1->momentum( 0, i1 )*p2->momentum( 0, i2 )
-                     - p1->momentum( 1, i1 )*p2->momentum( 1, i2 )
-                     - p1->momentum( 2, i1 )*p2->momentum( 2, i2 );
+    if( buffer_.size() < 6*n ) {
+        buffer_.resize( 6*n );
+    }
+    double *gammae  = &buffer_[0];
+    double *gammai  = gammae  + n;
+    double *gamma_s = gammai  + n;
+    double *Zstar   = gamma_s + n;
+    double *U1      = Zstar   + n;
+    double *U2      = U1      + n;
+    
+    // Gather the Lorentz factors (in the lab frame and in the frame of the ion) and the ion charges
+    for( unsigned int j=0; j<n; j++ ) {
+        double gamma1 = p1[j]->lor_fac( i1[j] );
+        double gamma2 = p2[j]->lor_fac( i2[j] );
+        gamma_s[j] = gamma1*gamma2
+                     - p1[j]->momentum( 0, i1[j] )*p2[j]->momentum( 0, i2[j] )
+                     - p1[j]->momentum( 1, i1[j] )*p2[j]->momentum( 1, i2[j] )
+                     - p1[j]->momentum( 2, i1[j] )*p2[j]->momentum( 2, i2[j] );
+        gammae[j] = electronFirst ? gamma1 : gamma2;
+        gammai[j] = electronFirst ? gamma2 : gamma1;
+        Zstar [j] = electronFirst ? p2[j]->charge( i2[j] ) : p1[j]->charge( i1[j] );
+    }
     // Random numbers
-    double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-    double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-    // Calculate the rest of the stuff
-    if( electronFirst ) {
-        calculate( gamma_s, gamma1, gamma2, p1, i1, p2, i2, U1, U2 );
-    } else {
-        calculate( gamma_s, gamma2, gamma1, p2, i2, p1, i1, U1, U2 );
+    rand->uniform( U1, n );
+    rand->uniform( U2, n );
+    
+    // First ionization, as in ::calculate (k=0). Pairs that cannot ionize get U1 = -1
+    const double *table = &( *interleavedTable )[0];
+    const double Zmax = atomic_number;
+    const double K0 = coeff;
+    #pragma omp simd
+    for( unsigned int j=0; j<n; j++ ) {
+        double x = a2*log( a1*( gamma_s[j]-1. ) );
+        bool valid = Zstar[j] < Zmax && x >= 0.;
+        int Z = valid ? ( int ) Zstar[j] : 0;
+        int i = valid ? ( int ) min( x, npointsm1-1. ) : 0;
+        double a = valid ? x - ( double )i : 0.;
+        int i0 = ( Z*npoints + i )*3;
+        double cs = ( table[i0+3]-table[i0] )*a + table[i0];
+        double e  = x < npointsm1 ? ( table[i0+5]-table[i0+2] )*a + table[i0+2] : table[i0+5];
+        double rate = K0 * sqrt( gamma_s[j]*gamma_s[j]-1. ) / gammai[j] * cs / gammae[j];
+        U1[j] = ( valid && e <= gamma_s[j]-1. && U1[j] >= exp( -rate ) ) ? U1[j] : -1.;
+    }
+    
+    // Full calculation for the pairs that ionize at least once
+    for( unsigned int j=0; j<n; j++ ) {
+        if( U1[j] < 0. ) {
+            continue;
+        }
+        if( electronFirst ) {
+            calculate( gamma_s[j], gammae[j], gammai[j], p1[j], i1[j], p2[j], i2[j], U1[j], U2[j] );
+        } else {
+            calculate( gamma_s[j], gammae[j], gammai[j], p2[j], i2[j], p1[j], i1[j], U1[j], U2[j] );
+        }
     }
 }
 
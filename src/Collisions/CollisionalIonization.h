@@ -9,6 +9,7 @@
 #include "Params.h"
 
 class Patch;
+class Random;
 
 class CollisionalIonization
 {
@@ -43,8 +44,9 @@ public:
     };
     virtual void prepare2( Particles *p1, int i1, Particles *p2, int i2, bool );
     virtual void prepare3( double, double );
-    //! Method to apply the ionization
-    virtual void apply( Patch *patch, Particles *p1, int i1, Particles *p2, int i2 );
+    //! Method to apply the ionization to n pairs (particles p1[j], i1[j] and p2[j], i2[j]).
+    //! A particle must not appear twice in the n pairs.
+    virtual void apply( Random *rand, unsigned int n, Particles **p1, unsigned int *i1, Particles **p2, unsigned int *i2 );
     //! Method to finish the ionization and put new electrons in place
     virtual void finish( Params &, Patch *, std::vector<Diagnostic *> & );
     
@@ -54,6 +56,8 @@ public:
     std::vector<std::vector<double> > *transferredEnergy;
     //! Local table of average incident electron energy lost
     std::vector<std::vector<double> > *lostEnergy;
+    //! Local table of the 3 quantities above, interleaved: [(Zstar*npoints+i)*3 + {0,1,2}]
+    std::vector<double> *interleavedTable;
     
     //! New electrons temporary species
     Particles new_electrons;
@@ -77,6 +81,8 @@ private:
     static std::vector<std::vector<std::vector<double> > > DB_transferredEnergy;
     //! Global table of average incident electron energy lost
     static std::vector<std::vector<std::vector<double> > > DB_lostEnergy;
+    //! Global interleaved tables, for the gathers of the vectorized loops
+    static std::vector<std::vector<double> > DB_interleaved;
     
     //! True if first group of species is the electron
     bool electronFirst;
@@ -95,6 +101,9 @@ private:
     //! Current ionization probability array (one cell per number of ionization events)
     std::vector<double> prob;
     
+    //! Scratch arrays of apply
+    std::vector<double> buffer_;
+    
     //! Method called by ::apply to calculate the ionization, being sure that electrons are the first species
     void calculate( double, double, double, Particles *pe, int ie, Particles *pi, int ii, double U1, double U2 );
     
@@ -115,7 +124,7 @@ public:
     
     void prepare2( Particles *, int, Particles *, int, bool ) override {};
     void prepare3( double, double ) override {};
-    void apply( Patch *, Particles *, int, Particles *, int ) override {};
+    void apply( Random *, unsigned int, Particles **, unsigned int *, Particles **, unsigned int * ) override {};
     //void finish(Species*, Species*, Params&, Patch*) override {};
     void finish( Params &, Patch *, std::vector<Diagnostic *> & ) override {};
 };
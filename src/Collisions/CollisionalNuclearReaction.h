@@ -26,6 +26,8 @@ public:
     };
     //! Test the occurence of the nuclear reaction
     virtual bool occurs( double U, double coeff, double m1, double m2, double g1, double g2, double &etot, double &log_ekin, double &W ) = 0;
+    //! Probabilities of the reaction for n pairs, from the kinetic energies and coefficients (same as occurs, without the test)
+    virtual void probabilities( unsigned int n, const double *ekin, const double *coeff, double *prob ) = 0;
     //! Prepare the products of the reaction
     virtual void makeProducts( double U, double ekin, double log_ekin, double q, Particles *&p3, Particles *&p4, double &p3_COM, double &p4_COM, double &q3, double &q4, double &cosX ) = 0;
     //! Finish the nuclear reaction and put new electrons in place
@@ -64,6 +66,11 @@ public:
     bool occurs( double U, double coeff, double m1, double m2, double g1, double g2, double &etot, double &log_ekin, double &W ) override {
         return false;
     };
+    void probabilities( unsigned int n, const double *ekin, const double *coeff, double *prob ) override {
+        for( unsigned int j=0; j<n; j++ ) {
+            prob[j] = 0.;
+        }
+    };
     void makeProducts( double U, double ekin, double log_ekin, double q, Particles *&p3, Particles *&p4, double &p3_COM, double &p4_COM, double &q3, double &q4, double &cosX ) override {};
     void finish( Params &params, Patch *patch, std::vector<Diagnostic *> &diags, bool, std::vector<unsigned int>, std::vector<unsigned int>, double npairs, int itime ) override {};
     std::string name() { return ""; }
@@ -11,6 +11,7 @@
 #include "H5.h"
 #include "Patch.h"
 #include "VectorPatch.h"
+#include "Random.h"
 
 using namespace std;
 
@@ -40,6 +41,8 @@ Collisions::Collisions(
 {
     coeff1_ = 4.046650232e-21*params.reference_angular_frequency_SI; // h*omega/(2*me*c^2)
     coeff2_ = 2.817940327e-15*params.reference_angular_frequency_SI/299792458.; // re omega / c
+    
+    has_nuclear_reaction_ = ! dynamic_cast<CollisionalNoNuclearReaction *>( NuclearReaction );
 }
 
 
@@ -68,6 +71,8 @@ Collisions::Collisions( Collisions *coll )
     } else if ( dynamic_cast<CollisionalFusionDD *>( coll->NuclearReaction ) ) {
         NuclearReaction = new CollisionalFusionDD( coll->NuclearReaction );
     }
+    
+    has_nuclear_reaction_ = coll->has_nuclear_reaction_;
 }
 
 
@@ -178,7 +183,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
     unsigned int i1=0, i2, ispec1, ispec2, N2max;
     Species   *s1, *s2;
     Particles *p1=NULL, *p2;
-    double coeff3, coeff4, logL, s, ncol, debye2=0.;
+    double coeff3, coeff4, ncol, debye2=0.;
     bool not_duplicated_particle;
     
     sg1 = &species_group1_;
@@ -242,7 +247,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         }
         // shuffle the index array
         for( unsigned int i=npart1; i>1; i-- ) {
-            unsigned int p = patch->xorshift32() % i;
+            unsigned int p = patch->rand_->integer() % i;
             swap( index1[i-1], index1[p] );
         }
         if( intra_collisions_ ) { // In the case of collisions within one species
@@ -268,6 +273,8 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         // Prepare the ionization
         Ionization->prepare1( patch->vecSpecies[( *sg1 )[0]]->atomic_number_ );
         
+        resizePairs( npairs );
+        
         // Calculate the densities
         n1  = 0.; // density of group 1
         n2  = 0.; // density of group 2
@@ -300,6 +307,13 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             n12 += min( p1->weight( i1 ),  p2->weight( i2 ) );
             // Same for ionization
             Ionization->prepare2( p1, i1, p2, i2, not_duplicated_particle );
+            // Keep the pair for the vectorized collisions
+            pair_particles1_[i] = p1;
+            pair_index1_    [i] = i1;
+            pair_mass1_     [i] = s1->mass_;
+            pair_particles2_[i] = p2;
+            pair_index2_    [i] = i2;
+            pair_mass2_     [i] = s2->mass_;
         }
         if( intra_collisions_ ) {
             n1 += n2;
@@ -320,46 +334,11 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         // Prepare the ionization & nuclear reaction
         Ionization->prepare3( params.timestep, inv_cell_volume );
         
-        // Now start the real loop on pairs of particles
-        // See equations in http://dx.doi.org/10.1063/1.4742167
-        // ----------------------------------------------------
-        for( unsigned int i=0; i<npairs; i++ ) {
+        // Collisions, nuclear reactions and ionization, vectorized over the pairs
+        // (the particles of group 2 repeat every N2max pairs)
+        collidePairs( patch->rand_, npairs, N2max, coeff3, coeff4, n123, n223, debye2, debug );
+        ncol += npairs;
         
-            // find species and index i1 of particle "1"
-            i1 = index1[i];
-            for( ispec1=0 ; i1>=np1[ispec1]; ispec1++ ) {
-                i1 -= np1[ispec1];
-            }
-            // find species and index i2 of particle "2"
-            i2 = index2[i];
-            for( ispec2=0 ; i2>=np2[ispec2]; ispec2++ ) {
-                i2 -= np2[ispec2];
-            }
-            
-            s1 = patch->vecSpecies[( *sg1 )[ispec1]];
-            s2 = patch->vecSpecies[( *sg2 )[ispec2]];
-            i1 += s1->first_index[ibin];
-            i2 += s2->first_index[ibin];
-            p1 = s1->particles;
-            p2 = s2->particles;
-            
-            logL = coulomb_log_;
-            double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-            double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-            double phi = patch->xorshift32() * patch->xorshift32_invmax * twoPi;
-            s = one_collision( p1, i1, s1->mass_, p2, i2, s2->mass_, coeff1_, coeff2_, coeff3, coeff4, n123, n223, debye2, logL, U1, U2, phi );
-            
-            // Handle ionization & nuclear reaction
-            Ionization->apply( patch, p1, i1, p2, i2 );
-            
-            ncol ++;
-            if( debug ) {
-                smean_    += s;
-                logLmean_ += logL;
-                //temperature += m1 * (sqrt(1.+pow(p1->momentum(0,i1),2)+pow(p1->momentum(1,i1),2)+pow(p1->momentum(2,i1),2))-1.);
-            }
-            
-        } // end loop on pairs of particles
         
     } // end loop on bins
     
@@ -374,6 +353,236 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
 }
 
 
+void Collisions::resizePairs( unsigned int npairs )
+{
+    pair_particles1_.resize( npairs );
+    pair_index1_    .resize( npairs );
+    pair_mass1_     .resize( npairs );
+    pair_particles2_.resize( npairs );
+    pair_index2_    .resize( npairs );
+    pair_mass2_     .resize( npairs );
+}
+
+
+// Same physics as one_collision, written for a SIMD loop over the pairs:
+// the branches of one_collision are replaced by selections.
+// The few pairs that undergo a nuclear reaction are masked out of the SIMD loop and handled by one_collision.
+void Collisions::collidePairs( Random *rand, unsigned int npairs, unsigned int nsingle, double coeff3, double coeff4,
+                               double n123, double n223, double debye2, bool debug )
+{
+    unsigned int nchunk = min( npairs, nsingle );
+    
+    // Scratch arrays: momentum, weight, charge and mass of the 2 particles, random numbers and results
+    const unsigned int narrays = 23;
+    if( pair_buffer_.size() < narrays*nchunk ) {
+        pair_buffer_.resize( narrays*nchunk );
+    }
+    double *px1 = &pair_buffer_[0];
+    double *py1 = px1 + nchunk;
+    double *pz1 = py1 + nchunk;
+    double *w1  = pz1 + nchunk;
+    double *q1  = w1  + nchunk;
+    double *m1  = q1  + nchunk;
+    double *px2 = m1  + nchunk;
+    double *py2 = px2 + nchunk;
+    double *pz2 = py2 + nchunk;
+    double *w2  = pz2 + nchunk;
+    double *q2  = w2  + nchunk;
+    double *m2  = q2  + nchunk;
+    double *U1  = m2  + nchunk;
+    double *U2  = U1  + nchunk;
+    double *phi = U2  + nchunk;
+    double *s   = phi + nchunk;
+    double *logL = s  + nchunk;
+    double *deflect1 = logL + nchunk;
+    double *deflect2 = deflect1 + nchunk;
+    double *ekin     = deflect2 + nchunk;
+    double *nr_coeff = ekin     + nchunk;
+    double *nr_prob  = nr_coeff + nchunk;
+    double *react    = nr_prob  + nchunk;
+    
+    const double coulomb_log = coulomb_log_;
+    const double coeff1 = coeff1_;
+    const double coeff2 = coeff2_;
+    
+    for( unsigned int istart=0 ; istart<npairs ; istart+=nsingle ) {
+        unsigned int n = min( nsingle, npairs-istart );
+        
+        // Gather the particles of the pairs
+        for( unsigned int j=0 ; j<n ; j++ ) {
+            Particles *p = pair_particles1_[istart+j];
+            unsigned int i = pair_index1_[istart+j];
+            px1[j] = p->momentum( 0, i );
+            py1[j] = p->momentum( 1, i );
+            pz1[j] = p->momentum( 2, i );
+            w1 [j] = p->weight( i );
+            q1 [j] = p->charge( i );
+            m1 [j] = pair_mass1_[istart+j];
+            p = pair_particles2_[istart+j];
+            i = pair_index2_[istart+j];
+            px2[j] = p->momentum( 0, i );
+            py2[j] = p->momentum( 1, i );
+            pz2[j] = p->momentum( 2, i );
+            w2 [j] = p->weight( i );
+            q2 [j] = p->charge( i );
+            m2 [j] = pair_mass2_[istart+j];
+        }
+        rand->uniform( U1, n );
+        rand->uniform( U2, n );
+        rand->uniform( phi, n );
+        
+        #pragma omp simd
+        for( unsigned int j=0 ; j<n ; j++ ) {
+            // Gammas and center-of-mass (COM) frame
+            double m12 = m1[j] / m2[j];
+            double gamma1 = sqrt( 1. + px1[j]*px1[j] + py1[j]*py1[j] + pz1[j]*pz1[j] );
+            double gamma2 = sqrt( 1. + px2[j]*px2[j] + py2[j]*py2[j] + pz2[j]*pz2[j] );
+            double gamma12_inv = 1./( m12 * gamma1 + gamma2 );
+            double COM_vx = ( m12 * px1[j] + px2[j] ) * gamma12_inv;
+            double COM_vy = ( m12 * py1[j] + py2[j] ) * gamma12_inv;
+            double COM_vz = ( m12 * pz1[j] + pz2[j] ) * gamma12_inv;
+            double COM_vsquare = COM_vx*COM_vx + COM_vy*COM_vy + COM_vz*COM_vz;
+            
+            // Particle 1 in the COM frame (a COM at rest only requires term1 to be selected)
+            double COM_gamma = 1./sqrt( 1.-COM_vsquare );
+            double term1 = COM_vsquare > 0. ? ( COM_gamma - 1. ) / COM_vsquare : 0.5;
+            double vcv1  = ( COM_vx*px1[j] + COM_vy*py1[j] + COM_vz*pz1[j] )/gamma1;
+            double vcv2  = ( COM_vx*px2[j] + COM_vy*py2[j] + COM_vz*pz2[j] )/gamma2;
+            double term2 = ( term1*vcv1 - COM_gamma ) * gamma1;
+            double px_COM = px1[j] + term2*COM_vx;
+            double py_COM = py1[j] + term2*COM_vy;
+            double pz_COM = pz1[j] + term2*COM_vz;
+            double gamma1_COM = ( 1.-vcv1 )*COM_gamma*gamma1;
+            double gamma2_COM = ( 1.-vcv2 )*COM_gamma*gamma2;
+            double p2_COM = px_COM*px_COM + py_COM*py_COM + pz_COM*pz_COM;
+            double p_COM  = sqrt( p2_COM );
+            
+            double term3 = COM_gamma * gamma12_inv;
+            double term4 = gamma1_COM * gamma2_COM;
+            double term5 = term4/p2_COM + m12;
+            double vrel = p_COM/term3/term4;
+            double qqm  = q1[j] * q2[j] / m1[j];
+            double qqm2 = qqm * qqm;
+            
+            // Coulomb log
+            double logLj = coulomb_log;
+            if( coulomb_log <= 0. ) {
+                double bmin = max( coeff1/m1[j]/p_COM, abs( coeff2*qqm*term3*term5 ) );
+                logLj = max( 2., 0.5*log( 1.+debye2/( bmin*bmin ) ) );
+            }
+            
+            // Collision parameter s12, with the low-temperature correction
+            double sj = coeff3 * logLj * qqm2 * term3 * p_COM * term5*term5 / ( gamma1*gamma2 );
+            double smax = coeff4 * ( m12+1. ) * vrel / max( m12*n123, n223 );
+            sj = min( sj, smax );
+            
+            // Deflection angle (Nanbu), all the branches are evaluated
+            double cosX_small = 1. + sj*log( max( U1[j], 0.0001 ) );
+            double invA = 0.00569578 +( 0.95602 + ( -0.508139 + ( 0.479139 + ( -0.12789 + 0.0238957*sj )*sj )*sj )*sj )*sj;
+            double A = 1./invA;
+            double cosX_medium = invA * log( exp( -A ) + 2.*U1[j]*sinh( A ) );
+            double A2 = 3.*exp( -sj );
+            double cosX_large = ( 1./A2 ) * log( exp( -A2 ) + 2.*U1[j]*sinh( A2 ) );
+            double cosX = sj < 0.1 ? cosX_small : ( sj < 3. ? cosX_medium : ( sj < 6. ? cosX_large : 2.*U1[j] - 1. ) );
+            double sinX = sqrt( 1. - cosX*cosX );
+            double sinXcosPhi = sinX*cos( 6.283185307179586*phi[j] );
+            double sinXsinPhi = sinX*sin( 6.283185307179586*phi[j] );
+            
+            // Apply the deflection
+            double p_perp = sqrt( px_COM*px_COM + py_COM*py_COM );
+            bool large_p_perp = p_perp > 1.e-10*p_COM;
+            double inv_p_perp = 1./p_perp;
+            double newpx_COM = large_p_perp ? ( px_COM * pz_COM * sinXcosPhi - py_COM * p_COM * sinXsinPhi ) * inv_p_perp + px_COM * cosX : p_COM * sinXcosPhi;
+            double newpy_COM = large_p_perp ? ( py_COM * pz_COM * sinXcosPhi + px_COM * p_COM * sinXsinPhi ) * inv_p_perp + py_COM * cosX : p_COM * sinXsinPhi;
+            double newpz_COM = large_p_perp ? -p_perp * sinXcosPhi  +  pz_COM * cosX : p_COM * cosX;
+            
+            // Go back to the lab frame
+            double vcp = COM_vx * newpx_COM + COM_vy * newpy_COM + COM_vz * newpz_COM;
+            double term6 = term1*vcp + gamma1_COM * COM_gamma;
+            px1[j] = newpx_COM + COM_vx * term6;
+            py1[j] = newpy_COM + COM_vy * term6;
+            pz1[j] = newpz_COM + COM_vz * term6;
+            term6 = -m12 * term1*vcp + gamma2_COM * COM_gamma;
+            px2[j] = -m12 * newpx_COM + COM_vx * term6;
+            py2[j] = -m12 * newpy_COM + COM_vy * term6;
+            pz2[j] = -m12 * newpz_COM + COM_vz * term6;
+            
+            // Each particle is deflected with some probability. Pairs with a zero weight are skipped
+            bool skip = min( w1[j], w2[j] ) <= 0.;
+            deflect1[j] = ( !skip && U2[j] < w2[j]/w1[j] ) ? 1. : 0.;
+            deflect2[j] = ( !skip && U2[j] < w1[j]/w2[j] ) ? 1. : 0.;
+            s   [j] = skip ? 0. : sj;
+            logL[j] = skip ? coulomb_log : logLj;
+            
+            // Inputs of the nuclear reaction
+            ekin    [j] = m1[j] * ( gamma1_COM-1. ) + m2[j] * ( gamma2_COM-1. );
+            nr_coeff[j] = vrel * coeff3;
+        }
+        
+        // Nuclear reactions: the pairs that react are not deflected here
+        bool any_reaction = false;
+        if( has_nuclear_reaction_ ) {
+            NuclearReaction->probabilities( n, ekin, nr_coeff, nr_prob );
+            double tot_probability = 0.;
+            int nreact = 0;
+            #pragma omp simd reduction(+:tot_probability,nreact)
+            for( unsigned int j=0 ; j<n ; j++ ) {
+                bool skip = min( w1[j], w2[j] ) <= 0.;
+                bool reacts = !skip && U1[j] > exp( -nr_prob[j] );
+                react   [j] = reacts ? 1. : 0.;
+                deflect1[j] = reacts ? 0. : deflect1[j];
+                deflect2[j] = reacts ? 0. : deflect2[j];
+                tot_probability += ( skip || reacts ) ? 0. : nr_prob[j];
+                nreact += reacts ? 1 : 0;
+            }
+            NuclearReaction->tot_probability_ += tot_probability;
+            any_reaction = nreact > 0;
+        }
+        
+        // Scatter the new momenta
+        for( unsigned int j=0 ; j<n ; j++ ) {
+            if( deflect1[j] > 0. ) {
+                Particles *p = pair_particles1_[istart+j];
+                unsigned int i = pair_index1_[istart+j];
+                p->momentum( 0, i ) = px1[j];
+                p->momentum( 1, i ) = py1[j];
+                p->momentum( 2, i ) = pz1[j];
+            }
+            if( deflect2[j] > 0. ) {
+                Particles *p = pair_particles2_[istart+j];
+                unsigned int i = pair_index2_[istart+j];
+                p->momentum( 0, i ) = px2[j];
+                p->momentum( 1, i ) = py2[j];
+                p->momentum( 2, i ) = pz2[j];
+            }
+        }
+        
+        // Reacting pairs: reaction and collision with the scalar method (same random numbers)
+        if( any_reaction ) {
+            for( unsigned int j=0 ; j<n ; j++ ) {
+                if( react[j] > 0. ) {
+                    logL[j] = coulomb_log;
+                    s[j] = one_collision( pair_particles1_[istart+j], pair_index1_[istart+j], m1[j],
+                                          pair_particles2_[istart+j], pair_index2_[istart+j], m2[j],
+                                          coeff1, coeff2, coeff3, coeff4, n123, n223, debye2, logL[j],
+                                          U1[j], U2[j], 6.283185307179586*phi[j] );
+                }
+            }
+        }
+        
+        // Ionization of the chunk, after the collisions
+        Ionization->apply( rand, n, &pair_particles1_[istart], &pair_index1_[istart], &pair_particles2_[istart], &pair_index2_[istart] );
+        
+        if( debug ) {
+            for( unsigned int j=0 ; j<n ; j++ ) {
+                smean_    += s[j];
+                logLmean_ += logL[j];
+            }
+        }
+    }
+}
+
+
 void Collisions::debug( Params &params, int itime, unsigned int icoll, VectorPatch &vecPatches )
 {
 
@@ -14,6 +14,7 @@ class Patch;
 class Params;
 class Species;
 class VectorPatch;
+class Random;
 
 class Collisions
 {
@@ -77,9 +78,29 @@ protected:
     //! Temporary variables for the debugging file
     double smean_, logLmean_;//, ncol;//, temperature
     
-    const double twoPi = 2. * 3.14159265358979323846;
     double coeff1_, coeff2_;
     
+    //! True if a nuclear reaction may occur in the pairs
+    bool has_nuclear_reaction_;
+    
+    //! Particles of the pairs of the current bin (species, index and mass of each particle)
+    std::vector<Particles *> pair_particles1_, pair_particles2_;
+    std::vector<unsigned int> pair_index1_, pair_index2_;
+    std::vector<double> pair_mass1_, pair_mass2_;
+    
+    //! Scratch arrays of collidePairs
+    std::vector<double> pair_buffer_;
+    
+    //! Sizes the pair arrays for npairs pairs
+    void resizePairs( unsigned int npairs );
+    
+    //! Collides the pairs of the current bin, vectorized over the pairs.
+    //! The pairs are treated by chunks of nsingle pairs, in which a particle never appears twice:
+    //! the momenta of a chunk are gathered in contiguous arrays, updated, and scattered back.
+    //! The nuclear reactions and the ionization are then applied to the whole chunk.
+    void collidePairs( Random *rand, unsigned int npairs, unsigned int nsingle, double coeff3, double coeff4,
+                       double n123, double n223, double debye2, bool debug );
+    
     // Collide one particle with another
     // See equations in http://dx.doi.org/10.1063/1.4742167
     inline double one_collision(
@@ -29,7 +29,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
     unsigned int i1=0, i2, N2max, first_index1, first_index2;
     Species   *s1, *s2;
     Particles *p1=NULL, *p2;
-    double coeff3, coeff4, logL, s, ncol, debye2=0.;
+    double coeff3, coeff4, ncol, debye2=0.;
     
     s1 = patch->vecSpecies[species_group1_[0]];
     s2 = patch->vecSpecies[species_group2_[0]];
@@ -91,10 +91,10 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             index1[i] = first_index1 + i;
         }
         for( unsigned int i=npairs; i>1; i-- ) {
-            unsigned int p = patch->xorshift32() % i;
+            unsigned int p = patch->rand_->integer() % i;
             swap( index1[i-1], index1[p] );
         }
-        p1->swap_parts( index1 ); // exchange particles along the cycle defined by the shuffle
+        resizePairs( npairs ); // the particles are not moved: the pairs are gathered by collidePairs
         
         // Prepare the ionization
         Ionization->prepare1( s1->atomic_number_ );
@@ -110,10 +110,16 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             n2 += p2->weight( i );
         }
         for( unsigned int i=0; i<npairs; i++ ) {
-            i1 = first_index1 + i;
+            i1 = index1[i];
             i2 = first_index2 + i%N2max;
             n12 += min( p1->weight( i1 ),  p2->weight( i2 ) );
             Ionization->prepare2( p1, i1, p2, i2, i<N2max );
+            pair_particles1_[i] = p1;
+            pair_index1_    [i] = i1;
+            pair_mass1_     [i] = s1->mass_;
+            pair_particles2_[i] = p2;
+            pair_index2_    [i] = i2;
+            pair_mass2_     [i] = s2->mass_;
         }
         if( intra_collisions_ ) {
             n1 += n2;
@@ -134,30 +140,10 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
         // Prepare the ionization
         Ionization->prepare3( params.timestep, inv_cell_volume );
         
-        // Now start the real loop on pairs of particles
-        // ----------------------------------------------------
-        for( unsigned int i=0; i<npairs; i++ ) {
-            i1 = first_index1 + i;
-            i2 = first_index2 + i%N2max;
-            
-            logL = coulomb_log_;
-            double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-            double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-            double phi = patch->xorshift32() * patch->xorshift32_invmax * twoPi;
-            
-            s = one_collision( p1, i1, s1->mass_, p2, i2, s2->mass_, coeff1_, coeff2_, coeff3, coeff4, n123, n223, debye2, logL, U1, U2, phi );
-            
-            // Handle ionization
-            Ionization->apply( patch, p1, i1, p2, i2 );
-            
-            ncol ++;
-            if( debug ) {
-                smean_    += s;
-                logLmean_ += logL;
-                //temperature += m1 * (sqrt(1.+pow(p1->momentum(0,i1),2)+pow(p1->momentum(1,i1),2)+pow(p1->momentum(2,i1),2))-1.);
-            }
-            
-        } // end loop on pairs of particles
+        // Collisions, nuclear reactions and ionization, vectorized over the pairs
+        collidePairs( patch->rand_, npairs, N2max, coeff3, coeff4, n123, n223, debye2, debug );
+        ncol += npairs;
+        
         
     } // end loop on bins
     
@@ -1,5 +1,6 @@
 
 #include <string>
+#include <algorithm>
 
 #include "DiagnosticFields.h"
 #include "VectorPatch.h"
@@ -169,6 +170,30 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
     H5Pset_dxpl_mpio( write_plist, H5FD_MPIO_COLLECTIVE );
     dcreate = H5Pcreate( H5P_DATASET_CREATE );
     
+    // Extract the aggregation, compression and MPI-IO aggregators parameters
+    PyTools::extract( "aggregate_fields", aggregate_fields, "DiagFields", ndiag );
+    n_buffered_fields = ( aggregate_fields && fields_indexes.size() > 0 ) ? fields_indexes.size() : 1;
+    PyTools::extract( "compression", compression, "DiagFields", ndiag );
+    PyTools::extract( "compression_level", compression_level, "DiagFields", ndiag );
+    if( compression == "deflate" ) {
+        if( compression_level < 0 || compression_level > 9 ) {
+            ERROR( "Diagnostic Fields #"<<ndiag<<" `compression_level` must be between 0 and 9 for deflate" );
+        }
+        if( H5Zfilter_avail( H5Z_FILTER_DEFLATE ) <= 0 ) {
+            ERROR( "Diagnostic Fields #"<<ndiag<<" requires deflate compression, not available in this HDF5 library" );
+        }
+    } else if( compression == "scaleoffset" ) {
+        if( compression_level < 0 ) {
+            ERROR( "Diagnostic Fields #"<<ndiag<<" `compression_level` must be positive for scaleoffset" );
+        }
+    } else if( compression != "none" ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `compression` must be \"none\", \"deflate\" or \"scaleoffset\"" );
+    }
+    PyTools::extract( "aggregators", aggregators, "DiagFields", ndiag );
+    if( aggregators < 0 ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `aggregators` must be positive" );
+    }
+    
     // Prepare some openPMD parameters
     field_type.resize( fields_names.size() );
     for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
@@ -223,8 +248,7 @@ void DiagnosticFields::openFile( Params &params, SmileiMPI *smpi, bool newfile )
     
     if( newfile ) {
         // Create file
-        hid_t pid = H5Pcreate( H5P_FILE_ACCESS );
-        H5Pset_fapl_mpio( pid, MPI_COMM_WORLD, MPI_INFO_NULL );
+        hid_t pid = fileAccessList();
         fileId_  = H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, pid );
         H5Pclose( pid );
         
@@ -235,14 +259,56 @@ void DiagnosticFields::openFile( Params &params, SmileiMPI *smpi, bool newfile )
         data_group_id = H5::group( fileId_, "data" );
     } else {
         // Open the existing file
-        hid_t pid = H5Pcreate( H5P_FILE_ACCESS );
-        H5Pset_fapl_mpio( pid, MPI_COMM_WORLD, MPI_INFO_NULL );
+        hid_t pid = fileAccessList();
         fileId_ = H5Fopen( filename.c_str(), H5F_ACC_RDWR, pid );
         H5Pclose( pid );
         data_group_id = H5Gopen( fileId_, "data", H5P_DEFAULT );
     }
 }
 
+hid_t DiagnosticFields::fileAccessList()
+{
+    hid_t pid = H5Pcreate( H5P_FILE_ACCESS );
+    if( aggregators > 0 ) {
+        // Collective buffering: only `aggregators` processes access the file
+        MPI_Info info;
+        MPI_Info_create( &info );
+        MPI_Info_set( info, "cb_nodes", to_string( aggregators ).c_str() );
+        MPI_Info_set( info, "romio_cb_write", "enable" );
+        H5Pset_fapl_mpio( pid, MPI_COMM_WORLD, info );
+        MPI_Info_free( &info );
+    } else {
+        H5Pset_fapl_mpio( pid, MPI_COMM_WORLD, MPI_INFO_NULL );
+    }
+    return pid;
+}
+
+void DiagnosticFields::setCompression( hid_t plist, int ndim, hsize_t *dims )
+{
+    if( compression == "none" ) {
+        return;
+    }
+    
+    // Filters require chunks: unless already chunked, chunks span all dimensions
+    // but the first one, which is cut so that a chunk holds about 2^20 points
+    if( H5Pget_layout( plist ) != H5D_CHUNKED ) {
+        vector<hsize_t> chunk( dims, dims+ndim );
+        hsize_t slice_size = 1;
+        for( int i=1; i<ndim; i++ ) {
+            slice_size *= dims[i];
+        }
+        chunk[0] = min( dims[0], max( ( hsize_t )1, ( ( hsize_t )1<<20 ) / slice_size ) );
+        H5Pset_chunk( plist, ndim, &chunk[0] );
+    }
+    
+    if( compression == "deflate" ) {
+        H5Pset_shuffle( plist );
+        H5Pset_deflate( plist, compression_level );
+    } else if( compression == "scaleoffset" ) {
+        H5Pset_scaleoffset( plist, H5Z_SO_FLOAT_DSCALE, compression_level );
+    }
+}
+
 void DiagnosticFields::closeFile()
 {
     if( filespace_firstwrite>0 ) {
@@ -350,33 +416,42 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     
     unsigned int nPatches( vecPatches.size() );
     
-    // For each field, combine all patches and write out
-    for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
+    if( aggregate_fields ) {
     
-        // Copy the patch field to the buffer
-        #pragma omp barrier
+        // Copy all fields of each patch to the buffer in a single pass
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-            getField( vecPatches( ipatch ), ifield );
+            for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
+                getField( vecPatches( ipatch ), ifield );
+            }
         }
         
+        // Write all fields at once
         #pragma omp master
         {
-            // Create field dataset in HDF5
-            hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, dcreate, H5P_DEFAULT );
-            
-            // Write
-            writeField( dset_id, itime );
-            
-            // Attributes for openPMD
-            openPMD_->writeFieldAttributes( dset_id, subgrid_start_, subgrid_step_ );
-            openPMD_->writeRecordAttributes( dset_id, field_type[ifield] );
-            openPMD_->writeFieldRecordAttributes( dset_id );
-            openPMD_->writeComponentAttributes( dset_id, field_type[ifield] );
+            for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
+                writeDataset( ifield, itime );
+            }
+        }
+        
+    } else {
+    
+        // For each field, combine all patches and write out
+        for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
+        
+            // Copy the patch field to the buffer
+            #pragma omp barrier
+            #pragma omp for schedule(static)
+            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+                getField( vecPatches( ipatch ), ifield );
+            }
             
-            // Close dataset
-            H5Dclose( dset_id );
+            #pragma omp master
+            {
+                writeDataset( ifield, itime );
+            }
         }
+        
     }
     
     #pragma omp master
@@ -396,6 +471,24 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     }
 }
 
+void DiagnosticFields::writeDataset( unsigned int ifield, int itime )
+{
+    // Create field dataset in HDF5
+    hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, dcreate, H5P_DEFAULT );
+    
+    // Write
+    writeField( dset_id, itime, ifield );
+    
+    // Attributes for openPMD
+    openPMD_->writeFieldAttributes( dset_id, subgrid_start_, subgrid_step_ );
+    openPMD_->writeRecordAttributes( dset_id, field_type[ifield] );
+    openPMD_->writeFieldRecordAttributes( dset_id );
+    openPMD_->writeComponentAttributes( dset_id, field_type[ifield] );
+    
+    // Close dataset
+    H5Dclose( dset_id );
+}
+
 bool DiagnosticFields::needsRhoJs( int itime )
 {
     return hasRhoJs && timeSelection->theTimeIsNow( itime );
@@ -23,7 +23,8 @@ public :
     
     virtual void run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers ) override;
     
-    virtual void writeField( hid_t, int ) = 0;
+    //! Write the buffer of field #ifield to the dataset dset_id
+    virtual void writeField( hid_t dset_id, int itime, unsigned int ifield ) = 0;
     
     virtual bool needsRhoJs( int itime ) override;
     
@@ -106,6 +107,36 @@ protected :
     
     //! Save the field type (needed for OpenPMD units dimensionality)
     std::vector<unsigned int> field_type;
+    
+    //! True if all fields of an output step are buffered and written together
+    bool aggregate_fields;
+    
+    //! Number of fields held at once in the buffers
+    unsigned int n_buffered_fields;
+    
+    //! Position, in a buffer of the given total size, of the part holding field #ifield
+    inline unsigned int bufferOffset( unsigned int ifield, unsigned int buffer_size )
+    {
+        return aggregate_fields ? ifield * ( buffer_size / n_buffered_fields ) : 0;
+    }
+    
+    //! Compression filter ("none", "deflate" or "scaleoffset") and its level
+    std::string compression;
+    int compression_level;
+    
+    //! Number of MPI processes accessing the file (0 lets MPI-IO decide)
+    int aggregators;
+    
+    //! Set chunks and compression filter on a dataset creation property list
+    void setCompression( hid_t plist, int ndim, hsize_t *dims );
+    
+private :
+
+    //! Create the file access property list, with MPI-IO hints
+    hid_t fileAccessList();
+    
+    //! Create, write and close the dataset of field #ifield
+    void writeDataset( unsigned int ifield, int itime );
 };
 
 #endif
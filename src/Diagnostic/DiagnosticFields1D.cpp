@@ -33,6 +33,8 @@ DiagnosticFields1D::DiagnosticFields1D( Params &params, SmileiMPI *smpi, VectorP
     total_dataset_size = nsteps;
     filespace = H5Screate_simple( 1, &file_size, NULL );
     memspace  = H5Screate_simple( 1, &file_size, NULL );
+    
+    setCompression( dcreate, 1, &file_size );
 }
 
 DiagnosticFields1D::~DiagnosticFields1D()
@@ -62,7 +64,7 @@ void DiagnosticFields1D::setFileSplitting( SmileiMPI *smpi, VectorPatch &vecPatc
     );
     
     if( nsteps > 0 ) {
-        data.resize( nsteps );
+        data.resize( nsteps * n_buffered_fields );
         
         // Define offset and size for HDF5 file
         hsize_t offset[1], block[1], count[1];
@@ -111,6 +113,7 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
         ix--;
     }
     iout -= MPI_start_in_file;
+    iout += bufferOffset( ifield, data.size() );
     unsigned int ix_max = ix + nsteps * subgrid_step_[0];
     
     // Copy this patch field into buffer
@@ -127,10 +130,10 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
 
 
 // Write current buffer to file
-void DiagnosticFields1D::writeField( hid_t dset_id, int itime )
+void DiagnosticFields1D::writeField( hid_t dset_id, int itime, unsigned int ifield )
 {
 
-    H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, write_plist, &( data[0] ) );
+    H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, write_plist, &( data[bufferOffset( ifield, data.size() )] ) );
     
 }
 
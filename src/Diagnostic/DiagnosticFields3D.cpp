@@ -42,7 +42,9 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
         );
     }
     one_patch_buffer_size = nsteps[0] * nsteps[1] * nsteps[2];
-    hsize_t file_size = ( hsize_t )one_patch_buffer_size * ( hsize_t )tot_number_of_patches;
+    hsize_t field_file_size = ( hsize_t )one_patch_buffer_size * ( hsize_t )tot_number_of_patches;
+    // All buffered fields are stored one after the other
+    hsize_t file_size = field_file_size * n_buffered_fields;
     filespace_firstwrite = H5Screate_simple( 1, &file_size, NULL );
     memspace_firstwrite  = H5Screate_simple( 1, &file_size, NULL );
     
@@ -72,11 +74,12 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
     filespace_reread = H5Screate_simple( 1, &file_size, NULL );
     hsize_t offset = ( hsize_t )one_patch_buffer_size * ( hsize_t )first_patch_of_this_proc;
     hsize_t block  = ( hsize_t )one_patch_buffer_size * ( hsize_t )npatch_local;
-    hsize_t count  = 1;
-    H5Sselect_hyperslab( filespace_reread, H5S_SELECT_SET, &offset, NULL, &count, &block );
+    hsize_t count  = n_buffered_fields;
+    H5Sselect_hyperslab( filespace_reread, H5S_SELECT_SET, &offset, &field_file_size, &count, &block );
     // Define space in memory for re-reading
-    memspace_reread = H5Screate_simple( 1, &block, NULL );
-    data_reread.resize( block );
+    hsize_t reread_size = block * count;
+    memspace_reread = H5Screate_simple( 1, &reread_size, NULL );
+    data_reread.resize( reread_size );
     // Define the list of patches for re-writing
     rewrite_npatch = ( unsigned int )npatch_local;
     rewrite_patch.resize( rewrite_npatch );
@@ -182,6 +185,7 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
         H5Pset_layout( dcreate, H5D_CHUNKED );
         H5Pset_chunk( dcreate, 3, chunk_size );
     }
+    setCompression( dcreate, 3, final_array_size );
     
     tmp_dset_id=0;
 }
@@ -198,16 +202,18 @@ void DiagnosticFields3D::setFileSplitting( SmileiMPI *smpi, VectorPatch &vecPatc
     unsigned int buffer_size = one_patch_buffer_size * vecPatches.size();
     
     // Resize the data
-    data.resize( buffer_size );
+    data.resize( buffer_size * n_buffered_fields );
     
     // Define offset and size for HDF5 file
     hsize_t offset = one_patch_buffer_size * refHindex;
+    hsize_t stride = ( hsize_t )one_patch_buffer_size * ( hsize_t )tot_number_of_patches;
     hsize_t block  = buffer_size;
-    hsize_t count  = 1;
+    hsize_t count  = n_buffered_fields;
     // Select portion of the file where this MPI will write to
-    H5Sselect_hyperslab( filespace_firstwrite, H5S_SELECT_SET, &offset, NULL, &count, &block );
+    H5Sselect_hyperslab( filespace_firstwrite, H5S_SELECT_SET, &offset, &stride, &count, &block );
     // define space in memory
-    H5Sset_extent_simple( memspace_firstwrite, 1, &block, &block );
+    hsize_t size = block * count;
+    H5Sset_extent_simple( memspace_firstwrite, 1, &size, &size );
     
     // Create/Open temporary dataset
     status = H5Lexists( fileId_, "tmp", H5P_DEFAULT );
@@ -255,7 +261,7 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
     unsigned int ix_max = istart_in_patch[0] + subgrid_step_[0]*nsteps[0];
     unsigned int iy_max = istart_in_patch[1] + subgrid_step_[1]*nsteps[1];
     unsigned int iz_max = istart_in_patch[2] + subgrid_step_[2]*nsteps[2];
-    unsigned int iout = one_patch_buffer_size * ( patch->Hindex()-refHindex );
+    unsigned int iout = bufferOffset( ifield, data.size() ) + one_patch_buffer_size * ( patch->Hindex()-refHindex );
     for( unsigned int ix = istart_in_patch[0]; ix < ix_max; ix += subgrid_step_[0] ) {
         for( unsigned int iy = istart_in_patch[1]; iy < iy_max; iy += subgrid_step_[1] ) {
             for( unsigned int iz = istart_in_patch[2]; iz < iz_max; iz += subgrid_step_[2] ) {
@@ -272,14 +278,17 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
 
 
 // Write current buffer to file
-void DiagnosticFields3D::writeField( hid_t dset_id, int itime )
+void DiagnosticFields3D::writeField( hid_t dset_id, int itime, unsigned int ifield )
 {
 
-    // Write the buffer in a temporary location
-    H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( data[0] ) );
-    
-    // Read the file with the previously defined partition
-    H5Dread( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_reread, filespace_reread, write_plist, &( data_reread[0] ) );
+    // When fields are aggregated, they all go through the temporary location with the first one
+    if( ! aggregate_fields || ifield == 0 ) {
+        // Write the buffer in a temporary location
+        H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( data[0] ) );
+        
+        // Read the file with the previously defined partition
+        H5Dread( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_reread, filespace_reread, write_plist, &( data_reread[0] ) );
+    }
     
     // Fold the data according to the Hilbert curve
     unsigned int read_position, write_position, write_skip_y, write_skip_z;
@@ -300,7 +309,7 @@ void DiagnosticFields3D::writeField( hid_t dset_id, int itime )
             istart_in_file[i] -= rewrite_start_in_file[i];
         }
         
-        read_position = one_patch_buffer_size * h;
+        read_position = bufferOffset( ifield, data_reread.size() ) + one_patch_buffer_size * h;
         write_position = istart_in_file[2] + rewrite_size[2] * ( istart_in_file[1] + rewrite_size[1]*istart_in_file[0] );
         write_skip_z = rewrite_size[2] - nsteps[2];
         write_skip_y = rewrite_size[2]* ( rewrite_size[1] - nsteps[1] + 1 ) - nsteps[2] - write_skip_z;
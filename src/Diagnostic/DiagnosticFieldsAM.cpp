@@ -57,8 +57,10 @@ DiagnosticFieldsAM::DiagnosticFieldsAM( Params &params, SmileiMPI *smpi, VectorP
     // define space in file
     hsize_t global_size[1];
     global_size[0] = tot_number_of_patches * one_patch_buffer_size;
+    // All buffered fields are stored one after the other
+    hsize_t ifield_size = factor_ * global_size[0];
     hsize_t iglobal_size[1];
-    iglobal_size[0] = factor_ * global_size[0];
+    iglobal_size[0] = ifield_size * n_buffered_fields;
     filespace_firstwrite = H5Screate_simple( 1, iglobal_size, NULL );
     memspace_firstwrite = H5Screate_simple( 1, iglobal_size, NULL ); // redefined later
     
@@ -85,14 +87,15 @@ DiagnosticFieldsAM::DiagnosticFieldsAM( Params &params, SmileiMPI *smpi, VectorP
     block [0] = one_patch_buffer_size * npatch_local;
     ioffset[0] = factor_ * offset[0];
     iblock [0] = factor_ * block [0];
-    count [0] = 1;
-    H5Sselect_hyperslab( filespace_reread, H5S_SELECT_SET, ioffset, NULL, count, iblock );
+    count [0] = n_buffered_fields;
+    H5Sselect_hyperslab( filespace_reread, H5S_SELECT_SET, ioffset, &ifield_size, count, iblock );
     // Define space in memory for re-reading
-    memspace_reread = H5Screate_simple( 1, iblock, NULL );
+    hsize_t ireread_size = iblock[0] * count[0];
+    memspace_reread = H5Screate_simple( 1, &ireread_size, NULL );
     if (factor_==2)
-        idata_reread.resize( block[0] );
+        idata_reread.resize( block[0] * count[0] );
     else if (factor_==1)
-        data_reread.resize( block[0] );
+        data_reread.resize( block[0] * count[0] );
 
     // Define the list of patches for re-writing
     rewrite_npatch = ( unsigned int )npatch_local;
@@ -147,6 +150,8 @@ DiagnosticFieldsAM::DiagnosticFieldsAM( Params &params, SmileiMPI *smpi, VectorP
     else if (factor_==1)
         data_rewrite.resize( block2[0]*block2[1] );
     
+    setCompression( dcreate, 2, ifinal_array_size );
+    
     tmp_dset_id=0;
 }
 
@@ -162,22 +167,24 @@ void DiagnosticFieldsAM::setFileSplitting( SmileiMPI *smpi, VectorPatch &vecPatc
     
     // Resize the data
     if (factor_==2)
-        idata.resize( total_vecPatches_size );
+        idata.resize( total_vecPatches_size * n_buffered_fields );
     else if (factor_==1)
-        data.resize( total_vecPatches_size );
+        data.resize( total_vecPatches_size * n_buffered_fields );
     
     // Define offset and size for HDF5 file
     hsize_t offset[1], block[1], count[1];
     offset[0] = one_patch_buffer_size * refHindex;
     block [0] = total_vecPatches_size;
-    count [0] = 1;
-    hsize_t ioffset[1], iblock[1];
+    count [0] = n_buffered_fields;
+    hsize_t ioffset[1], iblock[1], istride[1];
     ioffset[0] = factor_ * offset[0];
     iblock [0] = factor_ * block [0];
+    istride[0] = ( hsize_t )factor_ * one_patch_buffer_size * tot_number_of_patches;
     // Select portion of the file where this MPI will write to
-    H5Sselect_hyperslab( filespace_firstwrite, H5S_SELECT_SET, ioffset, NULL, count, iblock );
+    H5Sselect_hyperslab( filespace_firstwrite, H5S_SELECT_SET, ioffset, istride, count, iblock );
     // define space in memory
-    H5Sset_extent_simple( memspace_firstwrite, 1, iblock, iblock );
+    hsize_t isize = iblock[0] * count[0];
+    H5Sset_extent_simple( memspace_firstwrite, 1, &isize, &isize );
     
     // Create/Open temporary dataset
     status = H5Lexists( fileId_, "tmp", H5P_DEFAULT );
@@ -221,7 +228,7 @@ void DiagnosticFieldsAM::getField( Patch *patch, unsigned int ifield, F& out_dat
     unsigned int ix_max = ix + patch_size[0];
     unsigned int iy;
     unsigned int iy_max = patch_offset_in_grid[1] + patch_size[1];
-    unsigned int iout = one_patch_buffer_size * ( patch->Hindex()-refHindex );
+    unsigned int iout = bufferOffset( ifield, out_data.size() ) + one_patch_buffer_size * ( patch->Hindex()-refHindex );
     while( ix < ix_max ) {
         iy = patch_offset_in_grid[1];
         while( iy < iy_max ) {
@@ -237,35 +244,38 @@ void DiagnosticFieldsAM::getField( Patch *patch, unsigned int ifield, F& out_dat
 }
 
 // Write current buffer to file
-void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime )
+void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime, unsigned int ifield )
 {
 
     if (factor_==2) {
-        writeField< std::vector< std::complex<double> > >( dset_id, itime, idata, idata_reread, idata_rewrite );
+        writeField< std::vector< std::complex<double> > >( dset_id, itime, ifield, idata, idata_reread, idata_rewrite );
     }
     else if (factor_==1) {
-        writeField< std::vector< double > >( dset_id, itime, data, data_reread, data_rewrite );
+        writeField< std::vector< double > >( dset_id, itime, ifield, data, data_reread, data_rewrite );
     }
 
 }
 
 // Write current buffer to file
 template<typename F>
-void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime, F& linearized_data, F& read_data, F& final_data )
+void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime, unsigned int ifield, F& linearized_data, F& read_data, F& final_data )
 {
 
-    // Write the buffer in a temporary location
-    H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( linearized_data[0] ) );
-
-    // Read the file with the previously defined partition
-    H5Dread( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_reread, filespace_reread, write_plist, &( read_data[0] ) );
+    // When fields are aggregated, they all go through the temporary location with the first one
+    if( ! aggregate_fields || ifield == 0 ) {
+        // Write the buffer in a temporary location
+        H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( linearized_data[0] ) );
+        
+        // Read the file with the previously defined partition
+        H5Dread( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_reread, filespace_reread, write_plist, &( read_data[0] ) );
+    }
     
     // Fold the data according to the Hilbert curve
     unsigned int read_position, write_position, write_skip_y, sx, sy;
     
     unsigned int write_sizey  = ( rewrite_npatchy*( patch_size[1]-1 ) + ( ( rewrite_ymin==0 )?1:0 ) );
     
-    read_position = 0;
+    read_position = bufferOffset( ifield, read_data.size() );
     for( unsigned int h=0; h<rewrite_npatch; h++ ) {
         int write_position0 = ( rewrite_patches_y[h]-rewrite_ymin )*( patch_size[1]-1 )
             + write_sizey *( ( rewrite_patches_x[h]-rewrite_xmin )*( patch_size[0]-1 ) );
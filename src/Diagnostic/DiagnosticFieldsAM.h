@@ -20,8 +20,8 @@ public:
     void getField( Patch *patch, unsigned int ) override;
     template<typename T, typename F>  void getField( Patch *patch, unsigned int, F& out_data );
 
-    void writeField( hid_t, int ) override;
-    template<typename F> void writeField( hid_t dset_id, int itime, F& linearized_data, F& read_data, F& final_data );
+    void writeField( hid_t, int, unsigned int ) override;
+    template<typename F> void writeField( hid_t dset_id, int itime, unsigned int ifield, F& linearized_data, F& read_data, F& final_data );
 
 private:
 
@@ -31,10 +31,18 @@ public :
     //! Clear the array
     void clear();
     
+    //! Sum the histograms of all threads into data_sum
+    void reduceThreads()
+    {
+        histogram->reduce( data_sum );
+    };
+    
     //! Get memory footprint of current diagnostic
     int getMemFootPrint() override
     {
         int size = output_size*sizeof( double );
+        // + private histograms of the threads
+        size += histogram->getMemFootPrint( output_size );
         // + data_array + index_array +  axis_array
         // + nparts_max * (sizeof(double)+sizeof(int)+sizeof(double))
         return size;
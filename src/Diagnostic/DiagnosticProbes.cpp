@@ -540,6 +540,7 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
         // Resize the array with only particles in this patch
         particles->resize( ipart_local, nDim_particle );
         particles->shrink_to_fit();
+        vecPatches( ipatch )->probes[probe_n]->stencil_ready = false;
 
         // Add the local offset
         offset_in_MPI[ipatch] = nPart_MPI;
@@ -567,6 +568,63 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
 
 
 
+// Interpolate one field on all the points of a probe, from their stored stencils
+static void gatherStencils( Field *field, ProbeParticles *probe, unsigned int ndim, unsigned int nnodes, double *FieldLoc )
+{
+    unsigned int npart = probe->particles.size();
+    const double *data = field->data_;
+    // Strides of the field along each dimension
+    int stride[3] = { 1, 1, 1 };
+    for( int idim=( int )ndim-2; idim>=0; idim-- ) {
+        stride[idim] = stride[idim+1] * field->dims_[idim+1];
+    }
+    // Primal or dual stencil along each dimension
+    unsigned int dual[3] = { 0, 0, 0 };
+    for( unsigned int idim=0; idim<ndim; idim++ ) {
+        dual[idim] = field->isDual( idim );
+    }
+
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        const int *index = &probe->stencil_index[ipart*2*ndim];
+        const double *coeff = &probe->stencil_coeff[ipart*2*ndim*nnodes];
+        const double *cx = coeff + dual[0]*nnodes;
+        const double *f0 = data + index[dual[0]]*stride[0];
+        double value = 0.;
+        if( ndim == 1 ) {
+            for( unsigned int i=0; i<nnodes; i++ ) {
+                value += cx[i] * f0[i];
+            }
+        } else if( ndim == 2 ) {
+            const double *cy = coeff + ( 2+dual[1] )*nnodes;
+            f0 += index[2+dual[1]];
+            for( unsigned int i=0; i<nnodes; i++ ) {
+                double vy = 0.;
+                for( unsigned int j=0; j<nnodes; j++ ) {
+                    vy += cy[j] * f0[i*stride[0]+j];
+                }
+                value += cx[i] * vy;
+            }
+        } else {
+            const double *cy = coeff + ( 2+dual[1] )*nnodes;
+            const double *cz = coeff + ( 4+dual[2] )*nnodes;
+            f0 += index[2+dual[1]]*stride[1] + index[4+dual[2]];
+            for( unsigned int i=0; i<nnodes; i++ ) {
+                double vy = 0.;
+                for( unsigned int j=0; j<nnodes; j++ ) {
+                    const double *row = f0 + i*stride[0] + j*stride[1];
+                    double vz = 0.;
+                    for( unsigned int k=0; k<nnodes; k++ ) {
+                        vz += cz[k] * row[k];
+                    }
+                    vy += cy[j] * vz;
+                }
+                value += cx[i] * vy;
+            }
+        }
+        FieldLoc[ipart] = value;
+    }
+}
+
 void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timestep, SimWindow *simWindow, Timers &timers )
 {
     ostringstream name_t;
@@ -672,50 +730,81 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
         // Loop probe ("fake") particles of current patch
         unsigned int iPart_MPI = offset_in_MPI[ipatch];
         unsigned int npart = vecPatches( ipatch )->probes[probe_n]->particles.size();
+        ProbeParticles *probe = vecPatches( ipatch )->probes[probe_n];
+        Interpolator *interp = vecPatches( ipatch )->probesInterp;
+        unsigned int nnodes = interp->stencilSize();
+
+        if( nnodes > 0 ) {
+            // The points only move with the patches: their stencils are computed once, then re-used at each output
+            if( ! probe->stencil_ready ) {
+                probe->stencil_index.resize( npart * 2*nDim_field );
+                probe->stencil_coeff.resize( npart * 2*nDim_field*nnodes );
+                for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                    interp->stencil( probe->particles, ipart, &probe->stencil_index[ipart*2*nDim_field], &probe->stencil_coeff[ipart*2*nDim_field*nnodes] );
+                }
+                probe->stencil_ready = true;
+            }
 
-        LocalFields Jloc_fields;
-        double Rloc_fields;
+            // Gather the usual fields, skipping those not requested
+            ElectroMagn *EMfields = vecPatches( ipatch )->EMfields;
+            Field *fields[10] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m,
+                                  EMfields->Jx_, EMfields->Jy_, EMfields->Jz_, EMfields->rho_ };
+            for( unsigned int ifield=0; ifield<10; ifield++ ) {
+                if( fieldlocation[ifield] < ( unsigned int ) nFields ) {
+                    gatherStencils( fields[ifield], probe, nDim_field, nnodes, &( ( *probesArray )( fieldlocation[ifield], iPart_MPI ) ) );
+                }
+            }
+            // Gather the species-related fields
+            for( unsigned int ifield=0; ifield<fieldindex.size(); ifield++ ) {
+                gatherStencils( EMfields->allFields[fieldindex[ifield]], probe, nDim_field, nnodes, &( ( *probesArray )( fieldlocation[13+ifield], iPart_MPI ) ) );
+            }
+
+        } else {
+
+            LocalFields Jloc_fields;
+            double Rloc_fields;
 
-        int ithread = 0;
+            int ithread = 0;
 #ifdef _OPENMP
-        ithread = omp_get_thread_num();
+            ithread = omp_get_thread_num();
 #endif
 
-        // Interpolate all usual fields
-        smpi->dynamics_resize( ithread, nDim_particle, npart, false );
-        for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-            int iparticle( ipart ); // Compatibility
-            int false_idx( 0 );   // Use in classical interp for now, not for probes
-            vecPatches( ipatch )->probesInterp->fieldsAndCurrents(
-                vecPatches( ipatch )->EMfields,
-                vecPatches( ipatch )->probes[probe_n]->particles, smpi,
-                &iparticle, &false_idx, ithread,
-                &Jloc_fields, &Rloc_fields
-            );
-            //! here we fill the probe data!!!
-            ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
-            ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
-            ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
-            ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
-            iPart_MPI++;
-        }
+            // Interpolate all usual fields
+            smpi->dynamics_resize( ithread, nDim_particle, npart, false );
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                int iparticle( ipart ); // Compatibility
+                int false_idx( 0 );   // Use in classical interp for now, not for probes
+                vecPatches( ipatch )->probesInterp->fieldsAndCurrents(
+                    vecPatches( ipatch )->EMfields,
+                    vecPatches( ipatch )->probes[probe_n]->particles, smpi,
+                    &iparticle, &false_idx, ithread,
+                    &Jloc_fields, &Rloc_fields
+                );
+                //! here we fill the probe data!!!
+                ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
+                ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
+                ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
+                ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
+                iPart_MPI++;
+            }
 
-        // Interpolate the species-related fields
-        for( unsigned int ifield=0; ifield<fieldindex.size(); ifield++ ) {
-            int istart( 0 ), iend( npart );
-            double *FieldLoc = &( ( *probesArray )( fieldlocation[13+ifield], offset_in_MPI[ipatch] ) );
-            vecPatches( ipatch )->probesInterp->oneField(
-                vecPatches( ipatch )->EMfields->allFields[fieldindex[ifield]],
-                vecPatches( ipatch )->probes[probe_n]->particles,
-                &istart, &iend,
-                FieldLoc
-            );
+            // Interpolate the species-related fields
+            for( unsigned int ifield=0; ifield<fieldindex.size(); ifield++ ) {
+                int istart( 0 ), iend( npart );
+                double *FieldLoc = &( ( *probesArray )( fieldlocation[13+ifield], offset_in_MPI[ipatch] ) );
+                vecPatches( ipatch )->probesInterp->oneField(
+                    vecPatches( ipatch )->EMfields->allFields[fieldindex[ifield]],
+                    vecPatches( ipatch )->probes[probe_n]->particles,
+                    &istart, &iend,
+                    FieldLoc
+                );
+            }
         }
 
         // Probes for envelope
@@ -128,8 +128,8 @@ private :
 class ProbeParticles
 {
 public :
-    ProbeParticles() {};
-    ProbeParticles( ProbeParticles *probe )
+    ProbeParticles() : stencil_ready( false ) {};
+    ProbeParticles( ProbeParticles *probe ) : stencil_ready( false )
     {
         offset_in_file=probe->offset_in_file;
     }
@@ -137,6 +137,13 @@ public :
     
     Particles particles;
     int offset_in_file;
+    
+    //! Whether the interpolation stencils below correspond to the current points and patch
+    bool stencil_ready;
+    //! First primal/dual node of each point along each dimension (see Interpolator::stencil)
+    std::vector<int> stencil_index;
+    //! Interpolation coefficients of each point along each dimension (see Interpolator::stencil)
+    std::vector<double> stencil_coeff;
 };
 
 
@@ -5,6 +5,7 @@
 
 #include "ParticleData.h"
 #include "PeekAtSpecies.h"
+#include "Function.h"
 #include "DiagnosticTrack.h"
 #include "VectorPatch.h"
 #include "Params.h"
@@ -31,6 +32,7 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         ERROR( "DiagTrackParticles #" << iDiagTrackParticles << " does not correspond to any existing species" );
     }
     speciesId_ = species_ids[0];
+    species_name_ = species_name;
     
     // Define the transfer type (collective is faster than independent)
     transfer = H5Pcreate( H5P_DATASET_XFER );
@@ -53,6 +55,7 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
     // Get parameter "filter" which gives a python function to select particles
     filter = PyTools::extract_py( "filter", "DiagTrackParticles", iDiagTrackParticles );
     has_filter = ( filter != Py_None );
+    compiled_filter = NULL;
     if( has_filter ) {
 #ifdef SMILEI_USE_NUMPY
         PyTools::setIteration( 0 );
@@ -60,6 +63,8 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         name << " filter:";
         bool *dummy = NULL;
         ParticleData test( nDim_particle, filter, name.str(), dummy );
+        // Try to evaluate the filter without python
+        compiled_filter = compileFilter( name.str(), vecPatches( 0 )->vecSpecies[speciesId_]->particles->isQuantumParameter );
 #else
         ERROR( name.str() << " with a filter requires the numpy package" );
 #endif
@@ -141,6 +146,50 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         ERROR( "DiagTrackParticles #" << iDiagTrackParticles << ": attribute `chi` not available for this species" );
     }
     
+    // List the double attributes, in the order they are written
+    string xyz = "xyz";
+    if( write_weight ) {
+        double_attributes.push_back( { "", "weight", SMILEI_UNIT_DENSITY, ( int )nDim_particle+3, -1 } );
+    }
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        if( write_momentum[idim] ) {
+            double_attributes.push_back( { "momentum", xyz.substr( idim, 1 ), SMILEI_UNIT_MOMENTUM, ( int )( nDim_particle+idim ), -1 } );
+        }
+    }
+    for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+        if( write_position[idim] ) {
+            double_attributes.push_back( { "position", xyz.substr( idim, 1 ), SMILEI_UNIT_POSITION, ( int )idim, -1 } );
+        }
+    }
+    if( write_chi ) {
+// Position old exists in this case
+#ifdef  __DEBUG
+        double_attributes.push_back( { "", "chi", SMILEI_UNIT_NONE, ( int )nDim_particle+3+3+1, -1 } );
+// Else, position old does not exist
+#else
+        double_attributes.push_back( { "", "chi", SMILEI_UNIT_NONE, ( int )nDim_particle+3+1, -1 } );
+#endif
+    }
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        if( write_E[idim] ) {
+            double_attributes.push_back( { "E", xyz.substr( idim, 1 ), SMILEI_UNIT_EFIELD, -1, ( int )idim } );
+        }
+    }
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        if( write_B[idim] ) {
+            double_attributes.push_back( { "B", xyz.substr( idim, 1 ), SMILEI_UNIT_BFIELD, -1, ( int )( 3+idim ) } );
+        }
+    }
+    
+    // Get the number of output steps accumulated in memory
+    int nsteps = 1;
+    PyTools::extract( "buffered_steps", nsteps, "DiagTrackParticles", iDiagTrackParticles );
+    if( nsteps < 1 ) {
+        ERROR( "DiagTrackParticles #" << iDiagTrackParticles << ": argument `buffered_steps` must be at least 1" );
+    }
+    n_buffered_steps = nsteps;
+    buffer_start = 0;
+    
     // Create the filename
     ostringstream hdf_filename( "" );
     hdf_filename << "TrackParticlesDisordered_" << species_name  << ".h5" ;
@@ -150,6 +199,9 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
     if( smpi->isMaster() ) {
         MESSAGE( 1, "Created TrackParticles #" << iDiagTrackParticles << ": species " << species_name );
         MESSAGE( 2, attr_list.str() );
+        if( compiled_filter ) {
+            MESSAGE( 2, "filter compiled" );
+        }
     }
     
     // Obtain the approximate number of particles in the species
@@ -167,6 +219,7 @@ DiagnosticTrack::~DiagnosticTrack()
     delete flush_timeSelection;
     H5Pclose( transfer );
     Py_DECREF( filter );
+    delete compiled_filter;
 }
 
 
@@ -200,6 +253,7 @@ void DiagnosticTrack::openFile( Params &params, SmileiMPI *smpi, bool newfile )
 void DiagnosticTrack::closeFile()
 {
     if( fileId_>0 ) {
+        writeBuffer();
         H5Gclose( data_group_id );
         H5Fclose( fileId_ );
         fileId_=0;
@@ -235,27 +289,50 @@ bool DiagnosticTrack::prepare( int itime )
 
 void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers )
 {
-    uint64_t nParticles_global = 0;
-    string xyz = "xyz";
+    unsigned int nPatches = vecPatches.size();
+    
+    // Select the particles with the compiled filter, in parallel
+    if( compiled_filter ) {
+        #pragma omp master
+        patch_selection.resize( nPatches );
+        #pragma omp barrier
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            selectParticles( vecPatches( ipatch )->vecSpecies[speciesId_]->particles, patch_selection[ipatch] );
+        }
+    }
     
-    hid_t momentum_group=0, position_group=0, iteration_group=0, particles_group=0, species_group=0;
-    hid_t plist=0, file_space=0, mem_space=0;
     #pragma omp master
     {
         // Obtain the particle partition of all the patches in this MPI
         nParticles_local = 0;
-        patch_start.resize( vecPatches.size() );
+        patch_start.resize( nPatches );
         
-        if( has_filter ) {
+        if( compiled_filter ) {
+        
+            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+                Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+                unsigned int nselected = patch_selection[ipatch].size();
+                for( unsigned int i=0; i<nselected; i++ ) {
+                    // If particle not tracked before (ID==0), then set its ID
+                    if( p->id( patch_selection[ipatch][i] ) == 0 ) {
+                        p->id( patch_selection[ipatch][i] ) = ++latest_Id;
+                    }
+                }
+                patch_start[ipatch] = nParticles_local;
+                nParticles_local += nselected;
+            }
+            
+        } else if( has_filter ) {
         
 #ifdef SMILEI_USE_NUMPY
             // Set a python variable "Main.iteration" to itime so that it can be accessed in the filter
             PyTools::setIteration( itime );
             
-            patch_selection.resize( vecPatches.size() );
+            patch_selection.resize( nPatches );
             PyArrayObject *ret;
             ParticleData particleData( 0 );
-            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
                 patch_selection[ipatch].resize( 0 );
                 Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
                 unsigned int npart = p->size();
@@ -289,297 +366,393 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
 #endif
             
         } else {
-            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
                 patch_start[ipatch] = nParticles_local;
                 nParticles_local += vecPatches( ipatch )->vecSpecies[speciesId_]->getNbrOfParticles();
             }
         }
         
-        // Specify the memory dataspace (the size of the local buffer)
-        hsize_t count_ = nParticles_local;
-        mem_space = H5Screate_simple( 1, &count_, NULL );
-        
-        // Get the number of offset for this MPI rank
-        uint64_t np_local = nParticles_local, offset;
-        MPI_Scan( &np_local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
-        nParticles_global = offset;
-        offset -= np_local;
-        MPI_Bcast( &nParticles_global, 1, MPI_UNSIGNED_LONG_LONG, smpi->getSize()-1, MPI_COMM_WORLD );
-        
-        // Make a new group for this iteration
-        ostringstream t( "" );
-        t << setfill( '0' ) << setw( 10 ) << itime;
-        iteration_group = H5::group( data_group_id, t.str().c_str() );
-        particles_group = H5::group( iteration_group, "particles" );
-        species_group = H5::group( particles_group, vecPatches( 0 )->vecSpecies[speciesId_]->name_.c_str() );
-        
-        // Add openPMD attributes ( "basePath" )
-        openPMD_->writeBasePathAttributes( iteration_group, itime );
-        // Add openPMD attributes ( "particles" )
-        openPMD_->writeParticlesAttributes( particles_group );
-        // Add openPMD attributes ( path of a given species )
-        openPMD_->writeSpeciesAttributes( species_group );
-        
-        // Write x_moved
-        H5::attr( iteration_group, "x_moved", simWindow ? simWindow->getXmoved() : 0. );
-        
-        // Set the dataset parameters
-        plist = H5Pcreate( H5P_DATASET_CREATE );
-        H5Pset_alloc_time( plist, H5D_ALLOC_TIME_EARLY ); // necessary for collective dump
-        
-        if( nParticles_global>0 ) {
-            // Set the chunk size
-            unsigned int maximum_chunk_size = 100000000;
-            unsigned int number_of_chunks = nParticles_global/maximum_chunk_size;
-            if( nParticles_global%maximum_chunk_size != 0 ) {
-                number_of_chunks++;
-            }
-            if( number_of_chunks==0 ) {
-                number_of_chunks = 1;
-            }
-            unsigned int chunk_size = nParticles_global/number_of_chunks;
-            if( nParticles_global%number_of_chunks != 0 ) {
-                chunk_size++;
-            }
-            hsize_t chunk_dims = chunk_size;
-            if( number_of_chunks > 1 ) {
-                H5Pset_layout( plist, H5D_CHUNKED );
-                H5Pset_chunk( plist, 1, &chunk_dims );
-            }
+        // Append this step to the buffers
+        BufferedStep step = {
+            itime,
+            simWindow ? simWindow->getXmoved() : 0.,
+            latest_Id,
+            nParticles_local,
+            flush_timeSelection->theTimeIsNow( itime )
+        };
+        buffered_steps.push_back( step );
+        buffer_start = buffer_id.size();
+        buffer_id.resize( buffer_start + nParticles_local );
+        if( write_charge ) {
+            buffer_charge.resize( buffer_start + nParticles_local );
+        }
+        buffer_double.resize( ( buffer_start + nParticles_local ) * double_attributes.size() );
+        if( interpolate ) {
+            data_fields.resize( nParticles_local*6 );
         }
+    }
+    #pragma omp barrier
+    
+    // Copy all attributes of each patch to the buffers
+    unsigned int nattr = double_attributes.size();
+    double mass = vecPatches( 0 )->vecSpecies[speciesId_]->mass_;
+    // Multiply by the mass to obtain an actual momentum (except for photons (mass = 0))
+    bool scale_momentum = ( mass != 1. && mass > 0. );
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+        Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+        vector<unsigned int> *selection = has_filter ? &patch_selection[ipatch] : NULL;
+        unsigned int npart = selection ? selection->size() : p->size();
+        uint64_t start = buffer_start + patch_start[ipatch];
         
-        // Define maximum size
-        hsize_t dims = nParticles_global;
-        file_space = H5Screate_simple( 1, &dims, NULL );
+        copy_property( p, 0, selection, buffer_id.data() + start );
+        if( write_charge ) {
+            copy_property( p, 0, selection, buffer_charge.data() + start );
+        }
         
-        // Select locations that this proc will write
-        if( nParticles_local>0 ) {
-            hsize_t start=offset, count=1, block=nParticles_local;
-            H5Sselect_hyperslab( file_space, H5S_SELECT_SET, &start, NULL, &count, &block );
-        } else {
-            H5Sselect_none( file_space );
+        // Interpolate the fields at the particle positions
+        if( interpolate ) {
+            vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
+                vecPatches.emfields( ipatch ),
+                *p,
+                data_fields.data() + patch_start[ipatch],
+                ( int ) nParticles_local,
+                selection
+            );
         }
         
-        // Create the "latest_IDs" dataset
-        // Create file space and select one element for each proc
-        hsize_t numel = smpi->getSize();
-        hid_t filespace = H5Screate_simple( 1, &numel, NULL );
-        hsize_t offset_ = smpi->getRank(), count=1;
-        H5Sselect_hyperslab( filespace, H5S_SELECT_SET, &offset_, NULL, &count, NULL );
-        // Create dataset
-        hid_t plist_id = H5Pcreate( H5P_DATASET_CREATE );
-        hid_t dset_id  = H5Dcreate( iteration_group, "latest_IDs", H5T_NATIVE_UINT64, filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT );
-        // Create memory space
-        hsize_t size_in_memory = 1;
-        hid_t memspace  = H5Screate_simple( 1, &size_in_memory, NULL );
-        // Parallel write
-        hid_t write_plist = H5Pcreate( H5P_DATASET_XFER );
-        H5Pset_dxpl_mpio( write_plist, H5FD_MPIO_COLLECTIVE );
-        H5Dwrite( dset_id, H5T_NATIVE_UINT64, memspace, filespace, write_plist, &latest_Id );
-        // Close all
-        H5Pclose( write_plist );
-        H5Pclose( plist_id );
-        H5Dclose( dset_id );
-        H5Sclose( filespace );
-        H5Sclose( memspace );
+        for( unsigned int iattr=0; iattr<nattr; iattr++ ) {
+            DoubleAttribute &attr = double_attributes[iattr];
+            double *out = buffer_double.data() + buffer_start*nattr + iattr*nParticles_local + patch_start[ipatch];
+            if( attr.iprop >= 0 ) {
+                copy_property( p, attr.iprop, selection, out );
+                if( scale_momentum && attr.group == "momentum" ) {
+                    for( unsigned int i=0; i<npart; i++ ) {
+                        out[i] *= mass;
+                    }
+                }
+            } else {
+                double *in = data_fields.data() + attr.ifield*nParticles_local + patch_start[ipatch];
+                for( unsigned int i=0; i<npart; i++ ) {
+                    out[i] = in[i];
+                }
+            }
+        }
     }
     
-    // Id
-    #pragma omp master
-    data_uint64.resize( nParticles_local, 1 );
-    #pragma omp barrier
-    fill_buffer( vecPatches, 0, data_uint64 );
+    // Write all buffered steps once the buffers are full
     #pragma omp master
     {
-        write_scalar( species_group, "id", data_uint64[0], H5T_NATIVE_UINT64, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
-        data_uint64.resize( 0 );
+        if( buffered_steps.size() >= n_buffered_steps ) {
+            writeBuffer();
+        }
+    }
+    #pragma omp barrier
+}
+
+
+void DiagnosticTrack::writeBuffer()
+{
+    unsigned int nsteps = buffered_steps.size();
+    if( nsteps == 0 ) {
+        return;
     }
     
-    // Charge
-    if( write_charge ) {
-        #pragma omp master
-        data_short.resize( nParticles_local, 0 );
-        #pragma omp barrier
-        fill_buffer( vecPatches, 0, data_short );
-        #pragma omp master
-        {
-            write_scalar( species_group, "charge", data_short[0], H5T_NATIVE_SHORT, file_space, mem_space, plist, SMILEI_UNIT_CHARGE, nParticles_global );
-            data_short.resize( 0 );
-        }
+    // Get the offset of this MPI rank and the total number of particles, for all steps at once
+    vector<uint64_t> np_local( nsteps ), offset( nsteps ), np_global( nsteps );
+    for( unsigned int istep=0; istep<nsteps; istep++ ) {
+        np_local[istep] = buffered_steps[istep].nParticles;
+    }
+    MPI_Scan( &np_local[0], &offset[0], nsteps, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( &np_local[0], &np_global[0], nsteps, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
+    
+    // Write the steps one after the other
+    uint64_t start = 0;
+    bool flush = false;
+    for( unsigned int istep=0; istep<nsteps; istep++ ) {
+        writeStep( buffered_steps[istep], start, offset[istep]-np_local[istep], np_global[istep] );
+        start += np_local[istep];
+        flush = flush || buffered_steps[istep].flush;
     }
     
-    #pragma omp master
-    data_double.resize( nParticles_local, 0 );
+    // Empty the buffers, but keep their memory for the next steps
+    buffered_steps.resize( 0 );
+    buffer_id.resize( 0 );
+    buffer_charge.resize( 0 );
+    buffer_double.resize( 0 );
     
-    // Weight
-    if( write_weight ) {
-        #pragma omp barrier
-        fill_buffer( vecPatches, nDim_particle+3, data_double );
-        #pragma omp master
-        write_scalar( species_group, "weight", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_DENSITY, nParticles_global );
+    if( flush ) {
+        H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
     }
-    
-    // Momentum
-    if( write_any_momentum ) {
-        #pragma omp master
-        {
-            momentum_group = H5::group( species_group, "momentum" );
-            openPMD_->writeRecordAttributes( momentum_group, SMILEI_UNIT_MOMENTUM );
+}
+
+
+void DiagnosticTrack::writeStep( BufferedStep &step, uint64_t start, uint64_t offset, uint64_t nParticles_global )
+{
+    int rank, size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &size );
+    
+    // Make a new group for this iteration
+    ostringstream t( "" );
+    t << setfill( '0' ) << setw( 10 ) << step.itime;
+    hid_t iteration_group = H5::group( data_group_id, t.str().c_str() );
+    hid_t particles_group = H5::group( iteration_group, "particles" );
+    hid_t species_group = H5::group( particles_group, species_name_.c_str() );
+    
+    // Add openPMD attributes ( "basePath" )
+    openPMD_->writeBasePathAttributes( iteration_group, step.itime );
+    // Add openPMD attributes ( "particles" )
+    openPMD_->writeParticlesAttributes( particles_group );
+    // Add openPMD attributes ( path of a given species )
+    openPMD_->writeSpeciesAttributes( species_group );
+    
+    // Write x_moved
+    H5::attr( iteration_group, "x_moved", step.x_moved );
+    
+    // Set the dataset parameters
+    hid_t plist = H5Pcreate( H5P_DATASET_CREATE );
+    H5Pset_alloc_time( plist, H5D_ALLOC_TIME_EARLY ); // necessary for collective dump
+    
+    if( nParticles_global>0 ) {
+        // Set the chunk size
+        unsigned int maximum_chunk_size = 100000000;
+        unsigned int number_of_chunks = nParticles_global/maximum_chunk_size;
+        if( nParticles_global%maximum_chunk_size != 0 ) {
+            number_of_chunks++;
         }
-        for( unsigned int idim=0; idim<3; idim++ ) {
-            if( write_momentum[idim] ) {
-                #pragma omp barrier
-                fill_buffer( vecPatches, nDim_particle+idim, data_double );
-                #pragma omp master
-                {
-                    // Multiply by the mass to obtain an actual momentum (except for photons (mass = 0))
-                    if( vecPatches( 0 )->vecSpecies[speciesId_]->mass_ != 1. &&
-                        vecPatches( 0 )->vecSpecies[speciesId_]->mass_ > 0) {
-                        for( unsigned int ip=0; ip<nParticles_local; ip++ ) {
-                            data_double[ip] *= vecPatches( 0 )->vecSpecies[speciesId_]->mass_;
-                        }
-                    }
-                    write_component( momentum_group, xyz.substr( idim, 1 ).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_MOMENTUM, nParticles_global );
-                }
-            }
+        if( number_of_chunks==0 ) {
+            number_of_chunks = 1;
         }
-        #pragma omp master
-        H5Gclose( momentum_group );
-    }
-    
-    // Position
-    if( write_any_position ) {
-        #pragma omp master
-        {
-            position_group = H5::group( species_group, "position" );
-            openPMD_->writeRecordAttributes( position_group, SMILEI_UNIT_POSITION );
+        unsigned int chunk_size = nParticles_global/number_of_chunks;
+        if( nParticles_global%number_of_chunks != 0 ) {
+            chunk_size++;
         }
-        for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
-            if( write_position[idim] ) {
-                #pragma omp barrier
-                fill_buffer( vecPatches, idim, data_double );
-                #pragma omp master
-                write_component( position_group, xyz.substr( idim, 1 ).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_POSITION, nParticles_global );
-            }
+        hsize_t chunk_dims = chunk_size;
+        if( number_of_chunks > 1 ) {
+            H5Pset_layout( plist, H5D_CHUNKED );
+            H5Pset_chunk( plist, 1, &chunk_dims );
         }
-        #pragma omp master
-        H5Gclose( position_group );
     }
     
-    // Chi - quantum parameter
-    if( write_chi ) {
-        #pragma omp barrier
-// Position old exists in this case
-#ifdef  __DEBUG
-        fill_buffer( vecPatches, nDim_particle+3+3+1, data_double );
-// Else, position old does not exist
-#else
-        fill_buffer( vecPatches, nDim_particle+3+1, data_double );
-#endif
-        #pragma omp master
-        write_scalar( species_group, "chi", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
+    // Specify the memory dataspace (the size of the local buffer)
+    hsize_t count_ = step.nParticles;
+    hid_t mem_space = H5Screate_simple( 1, &count_, NULL );
+    
+    // Define maximum size
+    hsize_t dims = nParticles_global;
+    hid_t file_space = H5Screate_simple( 1, &dims, NULL );
+    
+    // Select locations that this proc will write
+    if( step.nParticles>0 ) {
+        hsize_t start_in_file=offset, count=1, block=step.nParticles;
+        H5Sselect_hyperslab( file_space, H5S_SELECT_SET, &start_in_file, NULL, &count, &block );
+    } else {
+        H5Sselect_none( file_space );
     }
     
-    #pragma omp barrier
+    // Create the "latest_IDs" dataset
+    // Create file space and select one element for each proc
+    hsize_t numel = size;
+    hid_t filespace = H5Screate_simple( 1, &numel, NULL );
+    hsize_t offset_ = rank, count=1;
+    H5Sselect_hyperslab( filespace, H5S_SELECT_SET, &offset_, NULL, &count, NULL );
+    // Create dataset
+    hid_t plist_id = H5Pcreate( H5P_DATASET_CREATE );
+    hid_t dset_id  = H5Dcreate( iteration_group, "latest_IDs", H5T_NATIVE_UINT64, filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT );
+    // Create memory space
+    hsize_t size_in_memory = 1;
+    hid_t memspace  = H5Screate_simple( 1, &size_in_memory, NULL );
+    // Parallel write
+    H5Dwrite( dset_id, H5T_NATIVE_UINT64, memspace, filespace, transfer, &step.latest_Id );
+    // Close all
+    H5Pclose( plist_id );
+    H5Dclose( dset_id );
+    H5Sclose( filespace );
+    H5Sclose( memspace );
     
-    // If field interpolation necessary
-    if( interpolate ) {
+    // Id
+    write_scalar( species_group, "id", buffer_id.data() + start, H5T_NATIVE_UINT64, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
     
+    // Charge
+    if( write_charge ) {
+        write_scalar( species_group, "charge", buffer_charge.data() + start, H5T_NATIVE_SHORT, file_space, mem_space, plist, SMILEI_UNIT_CHARGE, nParticles_global );
+    }
     
-        #pragma omp master
-        data_double.resize( nParticles_local*6 );
-        
-        // Do the interpolation
-        unsigned int nPatches=vecPatches.size();
-        #pragma omp barrier
-        
-        if( has_filter ) {
-            #pragma omp for schedule(static)
-            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-                vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
-                    vecPatches.emfields( ipatch ),
-                    *( vecPatches.species( ipatch, speciesId_ )->particles ),
-                    &data_double[patch_start[ipatch]],
-                    ( int ) nParticles_local,
-                    &patch_selection[ipatch]
-                );
+    // Double attributes: either scalars, or components of a vector record (momentum, position, E, B)
+    unsigned int nattr = double_attributes.size();
+    string group_name = "";
+    hid_t group = 0;
+    for( unsigned int iattr=0; iattr<nattr; iattr++ ) {
+        DoubleAttribute &attr = double_attributes[iattr];
+        double *data = buffer_double.data() + start*nattr + iattr*step.nParticles;
+        if( attr.group != group_name ) {
+            if( group>0 ) {
+                H5Gclose( group );
+                group = 0;
             }
-        } else {
-            #pragma omp for schedule(static)
-            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-                vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
-                    vecPatches.emfields( ipatch ),
-                    *( vecPatches.species( ipatch, speciesId_ )->particles ),
-                    &data_double[patch_start[ipatch]],
-                    ( int ) nParticles_local,
-                    NULL
-                );
+            group_name = attr.group;
+            if( group_name != "" ) {
+                group = H5::group( species_group, group_name );
+                openPMD_->writeRecordAttributes( group, attr.unit_type );
             }
         }
-        #pragma omp barrier
-        
-        // Write out the fields
-        #pragma omp master
-        {
-            if( write_any_E ) {
-                hid_t Efield_group = H5::group( species_group, "E" );
-                openPMD_->writeRecordAttributes( Efield_group, SMILEI_UNIT_EFIELD );
-                for( unsigned int idim=0; idim<3; idim++ ) {
-                    if( write_E[idim] ) {
-                        write_component( Efield_group, xyz.substr( idim, 1 ).c_str(), data_double[idim*nParticles_local], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_EFIELD, nParticles_global );
-                    }
-                }
-                H5Gclose( Efield_group );
-            }
-            
-            if( write_any_B ) {
-                hid_t Bfield_group = H5::group( species_group, "B" );
-                openPMD_->writeRecordAttributes( Bfield_group, SMILEI_UNIT_BFIELD );
-                for( unsigned int idim=0; idim<3; idim++ ) {
-                    if( write_B[idim] ) {
-                        write_component( Bfield_group, xyz.substr( idim, 1 ).c_str(), data_double[( 3+idim )*nParticles_local], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_BFIELD, nParticles_global );
-                    }
-                }
-                H5Gclose( Bfield_group );
-            }
+        if( group>0 ) {
+            write_component( group, attr.name, data, H5T_NATIVE_DOUBLE, file_space, mem_space, plist, attr.unit_type, nParticles_global );
+        } else {
+            write_scalar( species_group, attr.name, data, H5T_NATIVE_DOUBLE, file_space, mem_space, plist, attr.unit_type, nParticles_global );
         }
-    } // END if interpolate
+    }
+    if( group>0 ) {
+        H5Gclose( group );
+    }
     
-    #pragma omp master
-    {
-        data_double.resize( 0 );
-        
-        // PositionOffset (for OpenPMD)
-        hid_t positionoffset_group = H5::group( species_group, "positionOffset" );
-        openPMD_->writeRecordAttributes( positionoffset_group, SMILEI_UNIT_POSITION );
-        vector<uint64_t> np = {nParticles_global};
-        for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
-            hid_t xyz_group = H5::group( positionoffset_group, xyz.substr( idim, 1 ) );
-            openPMD_->writeComponentAttributes( xyz_group, SMILEI_UNIT_POSITION );
-            H5::attr( xyz_group, "value", 0. );
-            H5::attr( xyz_group, "shape", np, H5T_NATIVE_UINT64 );
-            H5Gclose( xyz_group );
+    // PositionOffset (for OpenPMD)
+    string xyz = "xyz";
+    hid_t positionoffset_group = H5::group( species_group, "positionOffset" );
+    openPMD_->writeRecordAttributes( positionoffset_group, SMILEI_UNIT_POSITION );
+    vector<uint64_t> np = {nParticles_global};
+    for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+        hid_t xyz_group = H5::group( positionoffset_group, xyz.substr( idim, 1 ) );
+        openPMD_->writeComponentAttributes( xyz_group, SMILEI_UNIT_POSITION );
+        H5::attr( xyz_group, "value", 0. );
+        H5::attr( xyz_group, "shape", np, H5T_NATIVE_UINT64 );
+        H5Gclose( xyz_group );
+    }
+    H5Gclose( positionoffset_group );
+    
+    // Close
+    H5Pclose( plist );
+    H5Sclose( file_space );
+    H5Sclose( mem_space );
+    H5Gclose( species_group );
+    H5Gclose( particles_group );
+    H5Gclose( iteration_group );
+}
+
+
+#ifdef SMILEI_USE_NUMPY
+// Convert the python filter into an expression (see _compile_filter in pyprofiles.py)
+// The expression is checked against the python filter on a few test particles
+// Returns NULL if the filter cannot be compiled
+Function_Expression *DiagnosticTrack::compileFilter( string name, bool has_chi )
+{
+    PyObject *compile = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_compile_filter" );
+    if( ! compile ) {
+        PyErr_Clear();
+        return NULL;
+    }
+    PyObject *py_expression = PyObject_CallFunction( compile, const_cast<char *>( "OiO" ), filter, nDim_particle, has_chi ? Py_True : Py_False );
+    Py_DECREF( compile );
+    string expression;
+    bool ok = py_expression && py_expression != Py_None && PyTools::convert( py_expression, expression );
+    Py_XDECREF( py_expression );
+    PyErr_Clear();
+    if( ! ok ) {
+        return NULL;
+    }
+    
+    // Variables are x, (y, z,) px, py, pz, weight, charge, (chi)
+    vector<string> names = { "x", "y", "z" };
+    names.resize( nDim_particle );
+    names.insert( names.end(), { "px", "py", "pz", "weight", "charge" } );
+    if( has_chi ) {
+        names.push_back( "chi" );
+    }
+    unsigned int nvariables = names.size();
+    unsigned int icharge = nDim_particle+4;
+    
+    Function_Expression *f = new Function_Expression( expression, nvariables );
+    if( ! f->isValid() ) {
+        DEBUG( name << " could not be compiled: " << expression );
+        delete f;
+        return NULL;
+    }
+    
+    // Test particles with values spanning several orders of magnitude
+    const unsigned int ntest = 16;
+    const double test_values[8] = { -47.9, -3.1, -0.5, 0., 0.01, 1.7, 10.3, 1031.3 };
+    vector<vector<double> > values( nvariables, vector<double>( ntest ) );
+    vector<short> charge( ntest );
+    vector<uint64_t> id( ntest, 0 );
+    vector<double *> x( nvariables );
+    for( unsigned int ivar=0; ivar<nvariables; ivar++ ) {
+        for( unsigned int i=0; i<ntest; i++ ) {
+            values[ivar][i] = test_values[( i + ( i/8+3 )*ivar )%8];
         }
-        H5Gclose( positionoffset_group );
-        
-        // Close and flush
-        patch_selection.resize( 0 );
-        
-        H5Pclose( plist );
-        H5Sclose( file_space );
-        H5Sclose( mem_space );
-        H5Gclose( species_group );
-        H5Gclose( particles_group );
-        H5Gclose( iteration_group );
-        
-        if( flush_timeSelection->theTimeIsNow( itime ) ) {
-            H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+        x[ivar] = &values[ivar][0];
+    }
+    for( unsigned int i=0; i<ntest; i++ ) {
+        charge[i] = ( short ) round( values[icharge][i] );
+        values[icharge][i] = charge[i];
+    }
+    vector<double> compiled_values( ntest );
+    f->valuesAt( x, &compiled_values[0], ntest );
+    
+    // Compare to the python filter
+    ParticleData particleData( ntest );
+    for( unsigned int ivar=0; ivar<nvariables; ivar++ ) {
+        if( ivar == icharge ) {
+            particleData.setVectorAttr( charge, names[ivar] );
+        } else {
+            particleData.setVectorAttr( values[ivar], names[ivar] );
         }
     }
-    #pragma omp barrier
+    particleData.setVectorAttr( id, "id" );
+    PyArrayObject *ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( filter, particleData.get(), NULL );
+    ok = ret && PyArray_Check( ret ) && PyArray_ISBOOL( ret ) && PyArray_SIZE( ret ) == ntest;
+    for( unsigned int i=0; i<ntest && ok; i++ ) {
+        ok = ( *( bool * ) PyArray_GETPTR1( ret, i ) ) == ( compiled_values[i] != 0. );
+    }
+    Py_XDECREF( ret );
+    PyErr_Clear();
+    if( ! ok ) {
+        DEBUG( name << " does not match its compiled expression: " << expression );
+        delete f;
+        return NULL;
+    }
+    return f;
 }
+#endif
 
 
+void DiagnosticTrack::selectParticles( Particles *particles, vector<unsigned int> &selection )
+{
+    selection.resize( 0 );
+    unsigned int npart = particles->size();
+    if( npart == 0 ) {
+        return;
+    }
+    
+    // Same variables as in compileFilter
+    vector<double *> x;
+    for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+        x.push_back( particles->getPtrPosition( idim ) );
+    }
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        x.push_back( particles->getPtrMomentum( idim ) );
+    }
+    x.push_back( particles->getPtrWeight() );
+    // Charges are short integers
+    vector<double> charge( npart );
+    short *q = particles->getPtrCharge();
+    for( unsigned int i=0; i<npart; i++ ) {
+        charge[i] = q[i];
+    }
+    x.push_back( &charge[0] );
+    if( particles->isQuantumParameter ) {
+        x.push_back( particles->Chi.data() );
+    }
+    
+    vector<double> values( npart );
+    compiled_filter->valuesAt( x, &values[0], npart );
+    for( unsigned int i=0; i<npart; i++ ) {
+        if( values[i] != 0. ) {
+            selection.push_back( i );
+        }
+    }
+}
+
 void DiagnosticTrack::setIDs( Patch *patch )
 {
     // If filter, IDs are set on-the-fly
@@ -611,47 +784,31 @@ void DiagnosticTrack::setIDs( Particles &particles )
 
 
 template<typename T>
-void DiagnosticTrack::fill_buffer( VectorPatch &vecPatches, unsigned int iprop, vector<T> &buffer )
+void DiagnosticTrack::copy_property( Particles *particles, unsigned int iprop, vector<unsigned int> *selection, T *out )
 {
-    unsigned int patch_nParticles, i, j, nPatches=vecPatches.size();
-    vector<T> *property = NULL;
+    ParticleProperty<T> *property = NULL;
+    particles->getProperty( iprop, property );
     
-    if( has_filter ) {
-        #pragma omp for schedule(runtime)
-        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-            patch_nParticles = patch_selection[ipatch].size();
-            vecPatches( ipatch )->vecSpecies[speciesId_]->particles->getProperty( iprop, property );
-            i=0;
-            j=patch_start[ipatch];
-            while( i<patch_nParticles ) {
-                buffer[j] = ( *property )[patch_selection[ipatch][i]];
-                i++;
-                j++;
-            }
+    if( selection ) {
+        unsigned int n = selection->size();
+        for( unsigned int i=0; i<n; i++ ) {
+            out[i] = ( *property )[( *selection )[i]];
         }
     } else {
-        #pragma omp for schedule(runtime)
-        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-            patch_nParticles = vecPatches( ipatch )->vecSpecies[speciesId_]->particles->size();
-            vecPatches( ipatch )->vecSpecies[speciesId_]->particles->getProperty( iprop, property );
-            i=0;
-            j=patch_start[ipatch];
-            while( i<patch_nParticles ) {
-                buffer[j] = ( *property )[i];
-                i++;
-                j++;
-            }
+        unsigned int n = particles->size();
+        for( unsigned int i=0; i<n; i++ ) {
+            out[i] = ( *property )[i];
         }
     }
 }
 
 
 template<typename T>
-void DiagnosticTrack::write_scalar( hid_t location, string name, T &buffer, hid_t dtype, hid_t file_space, hid_t mem_space, hid_t plist, unsigned int unit_type, unsigned int npart_global )
+void DiagnosticTrack::write_scalar( hid_t location, string name, T *buffer, hid_t dtype, hid_t file_space, hid_t mem_space, hid_t plist, unsigned int unit_type, uint64_t npart_global )
 {
     hid_t did = H5Dcreate( location, name.c_str(), dtype, file_space, H5P_DEFAULT, plist, H5P_DEFAULT );
     if( npart_global>0 ) {
-        H5Dwrite( did, dtype, mem_space, file_space, transfer, &buffer );
+        H5Dwrite( did, dtype, mem_space, file_space, transfer, buffer );
     }
     openPMD_->writeRecordAttributes( did, unit_type );
     openPMD_->writeComponentAttributes( did, unit_type );
@@ -659,18 +816,17 @@ void DiagnosticTrack::write_scalar( hid_t location, string name, T &buffer, hid_
 }
 
 template<typename T>
-void DiagnosticTrack::write_component( hid_t location, string name, T &buffer, hid_t dtype, hid_t file_space, hid_t mem_space, hid_t plist, unsigned int unit_type, unsigned int npart_global )
+void DiagnosticTrack::write_component( hid_t location, string name, T *buffer, hid_t dtype, hid_t file_space, hid_t mem_space, hid_t plist, unsigned int unit_type, uint64_t npart_global )
 {
     hid_t did = H5Dcreate( location, name.c_str(), dtype, file_space, H5P_DEFAULT, plist, H5P_DEFAULT );
     if( npart_global>0 ) {
-        H5Dwrite( did, dtype, mem_space, file_space, transfer, &buffer );
+        H5Dwrite( did, dtype, mem_space, file_space, transfer, buffer );
     }
     openPMD_->writeComponentAttributes( did, unit_type );
     H5Dclose( did );
 }
 
 
-
 // SUPPOSED TO BE EXECUTED ONLY BY MASTER MPI
 uint64_t DiagnosticTrack::getDiskFootPrint( int istart, int istop, Patch *patch )
 {
@@ -6,6 +6,7 @@
 class Patch;
 class Params;
 class SmileiMPI;
+class Function_Expression;
 
 
 class DiagnosticTrack : public Diagnostic
@@ -36,14 +37,17 @@ public :
     //! Get disk footprint of current diagnostic
     uint64_t getDiskFootPrint( int istart, int istop, Patch *patch ) override;
     
-    //! Fills a buffer with the required particle property
-    template<typename T> void fill_buffer( VectorPatch &vecPatches, unsigned int iprop, std::vector<T> &buffer );
+    //! Copies a particle property (only the selected particles, if any) to out
+    template<typename T> void copy_property( Particles *particles, unsigned int iprop, std::vector<unsigned int> *selection, T *out );
     
     //! Write a scalar dataset with the given buffer
-    template<typename T> void write_scalar( hid_t, std::string, T &, hid_t, hid_t, hid_t, hid_t, unsigned int, unsigned int );
+    template<typename T> void write_scalar( hid_t, std::string, T *, hid_t, hid_t, hid_t, hid_t, unsigned int, uint64_t );
     
     //! Write a vector component dataset with the given buffer
-    template<typename T> void write_component( hid_t, std::string, T &, hid_t, hid_t, hid_t, hid_t, unsigned int, unsigned int );
+    template<typename T> void write_component( hid_t, std::string, T *, hid_t, hid_t, hid_t, hid_t, unsigned int, uint64_t );
+    
+    //! Write all output steps held in the buffers to the file (collective)
+    void writeBuffer();
     
     //! Set a given patch's particles with the required IDs
     void setIDs( Patch * );
@@ -54,6 +58,9 @@ public :
     //! Index of the species used
     unsigned int speciesId_;
     
+    //! Name of the species used
+    std::string species_name_;
+    
     //! Last ID assigned to a particle by this MPI domain
     uint64_t latest_Id;
     
@@ -77,15 +84,58 @@ private :
     //! Tells whether this diag includes a particle filter
     PyObject *filter;
     
+    //! The filter converted to an expression evaluated without python (NULL if not possible)
+    Function_Expression *compiled_filter;
+    
+    //! Converts the python filter into a compiled expression
+    Function_Expression *compileFilter( std::string name, bool has_chi );
+    
+    //! Selects the particles with the compiled filter
+    void selectParticles( Particles *particles, std::vector<unsigned int> &selection );
+    
     //! Selection of the filtered particles in each patch
     std::vector<std::vector<unsigned int> > patch_selection;
     
-    //! Buffer for the output of double array
-    std::vector<double> data_double;
-    //! Buffer for the output of short array
-    std::vector<short> data_short;
-    //! Buffer for the output of uint64 array
-    std::vector<uint64_t> data_uint64;
+    //! Number of output steps accumulated in memory before writing them together
+    unsigned int n_buffered_steps;
+    
+    //! Output step held in the buffers
+    struct BufferedStep {
+        int itime;
+        double x_moved;
+        uint64_t latest_Id;
+        uint64_t nParticles;
+        //! Whether the file must be flushed after writing this step
+        bool flush;
+    };
+    std::vector<BufferedStep> buffered_steps;
+    
+    //! Double attribute written for each particle
+    struct DoubleAttribute {
+        //! Group ("" for the species group itself) and name of the dataset
+        std::string group, name;
+        unsigned int unit_type;
+        //! Index of the particle property, or -1 for interpolated fields
+        int iprop;
+        //! Index of the interpolated field (Ex, Ey, Ez, Bx, By, Bz)
+        int ifield;
+    };
+    std::vector<DoubleAttribute> double_attributes;
+    
+    //! Buffers accumulating the attributes of all buffered steps, step after step
+    std::vector<uint64_t> buffer_id;
+    std::vector<short> buffer_charge;
+    //! For each step, one array per double attribute
+    std::vector<double> buffer_double;
+    
+    //! Position of the current step in buffer_id
+    uint64_t buffer_start;
+    
+    //! Buffer for the interpolated fields
+    std::vector<double> data_fields;
+    
+    //! Write one of the buffered steps
+    void writeStep( BufferedStep &step, uint64_t start, uint64_t offset, uint64_t nParticles_global );
     
     //! Approximate total number of particles
     double npart_total;
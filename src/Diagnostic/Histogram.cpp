@@ -3,106 +3,166 @@
 #include "Patch.h"
 #include "ParticleData.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 using namespace std;
 
+Histogram::Histogram()
+{
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    private_data.resize( nthreads );
+}
+
+// Convert the axis quantity of each particle into its bin, and accumulate it in the particle index.
+// The axis options are template parameters so that the loop has no branch except the bin test.
+template<bool logscale, bool edge_inclusive, bool first_axis>
+static void binAxis( double *__restrict__ value, int *__restrict__ index, unsigned int npart,
+                     double actual_min, double coeff, int nbins )
+{
+    #pragma omp simd
+    for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+        double v = logscale ? log10( abs( value[ipart] ) ) : value[ipart];
+        int ind = ( int ) floor( ( v-actual_min ) * coeff );
+        // The indexes are "reshaped" in one dimension.
+        // For instance, in 3d, the index has the form  i = i3 + n3*( i2 + n2*i1 )
+        int previous = first_axis ? 0 : index[ipart] * nbins;
+        if( edge_inclusive ) {
+            // move out-of-range indexes back into range
+            ind = std::min( std::max( ind, 0 ), nbins-1 );
+            index[ipart] = index[ipart] < 0 ? -1 : previous + ind;
+        } else {
+            // index valid only if in the "box", otherwise discard particle
+            bool valid = index[ipart] >= 0 && ind >= 0 && ind < nbins;
+            index[ipart] = valid ? previous + ind : -1;
+        }
+    }
+}
+
+typedef void ( *BinAxisKernel )( double *, int *, unsigned int, double, double, int );
+
 // Loop on the different axes requested and compute the output index of each particle
 void Histogram::digitize( Species *s,
                           std::vector<double> &double_buffer,
                           std::vector<int>    &int_buffer,
                           SimWindow *simWindow )
 {
-    unsigned int ipart, npart=s->particles->size();
-    int ind;
+    static const BinAxisKernel kernels[8] = {
+        binAxis<false, false, false>, binAxis<false, false, true>,
+        binAxis<false, true,  false>, binAxis<false, true,  true>,
+        binAxis<true,  false, false>, binAxis<true,  false, true>,
+        binAxis<true,  true,  false>, binAxis<true,  true,  true>
+    };
     
-    for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
+    unsigned int npart=s->particles->size();
     
+    for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
+        HistogramAxis *axis = axes[iaxis];
+        
         // first loop on particles to store the indexing (axis) quantity
-        axes[iaxis]->digitize( s, double_buffer, int_buffer, npart, simWindow );
+        axis->digitize( s, double_buffer, int_buffer, npart, simWindow );
         // Now, double_buffer has the location of each particle along the axis
         
-        // if log scale, loop again and convert to log
-        if( axes[iaxis]->logscale ) {
-            for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                double_buffer[ipart] = log10( abs( double_buffer[ipart] ) );
-            }
-        }
-        
-        // The indexes are "reshaped" in one dimension.
-        // For instance, in 3d, the index has the form  i = i3 + n3*( i2 + n2*i1 )
-        // Here we do the multiplication by n3 or n2 (etc.)
-        if( iaxis>0 ) {
-            for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                int_buffer[ipart] *= axes[iaxis]->nbins;
-            }
-        }
-        
-        // loop again on the particles and calculate the index
-        // This is separated in two cases: edge_inclusive and edge_exclusive
-        if( !axes[iaxis]->edge_inclusive ) { // if the particles out of the "box" must be excluded
-        
-            for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                // skip already discarded particles
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                // calculate index
-                ind = floor( ( double_buffer[ipart]-axes[iaxis]->actual_min ) * axes[iaxis]->coeff );
-                // index valid only if in the "box"
-                if( ind >= 0  &&  ind < axes[iaxis]->nbins ) {
-                    int_buffer[ipart] += ind;
-                } else {
-                    int_buffer[ipart] = -1;    // discard particle
-                }
-            }
-            
-        } else { // if the particles out of the "box" must be included
-        
-            for( ipart = 0 ; ipart < npart ; ipart++ ) {
-                // skip already discarded particles
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                // calculate index
-                ind = floor( ( double_buffer[ipart]-axes[iaxis]->actual_min ) * axes[iaxis]->coeff );
-                // move out-of-range indexes back into range
-                if( ind < 0 ) {
-                    ind = 0;
-                }
-                if( ind >= axes[iaxis]->nbins ) {
-                    ind = axes[iaxis]->nbins-1;
-                }
-                int_buffer[ipart] += ind;
-            }
-            
-        }
+        // second loop to convert the location into the bin index, in a single pass
+        unsigned int k = 4*axis->logscale + 2*axis->edge_inclusive + ( iaxis==0 );
+        kernels[k]( double_buffer.data(), int_buffer.data(), npart, axis->actual_min, axis->coeff, axis->nbins );
         
     } // loop axes
 }
 
+// Sum the data into the private histogram of this thread according to the indexes
+// No atomic is needed, as each thread owns its histogram (except for large histograms)
 void Histogram::distribute(
     std::vector<double> &double_buffer,
     std::vector<int>    &int_buffer,
     std::vector<double> &output_array )
 {
-
-    unsigned int ipart, npart=double_buffer.size();
-    int ind;
+    unsigned int npart=double_buffer.size();
+    unsigned int output_size = output_array.size();
+    
+    // Large histograms are summed directly in the output array
+    if( output_size > max_private_size ) {
+        for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+            int ind = int_buffer[ipart];
+            if( ind<0 ) {
+                continue;    // skip discarded particles
+            }
+            #pragma omp atomic
+            output_array[ind] += double_buffer[ipart];
+        }
+        return;
+    }
     
-    // Sum the data into the data_sum according to the indexes
-    // ---------------------------------------------------------------
-    for( ipart = 0 ; ipart < npart ; ipart++ ) {
-        ind = int_buffer[ipart];
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    
+    // The thread allocates its own histogram, so that it lies in its local memory
+    std::vector<double> &histogram = private_data[ithread];
+    if( histogram.size() != output_size ) {
+        histogram.resize( output_size, 0. );
+    }
+    
+    double *data = histogram.data();
+    for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+        int ind = int_buffer[ipart];
         if( ind<0 ) {
             continue;    // skip discarded particles
         }
-        #pragma omp atomic
-        output_array[ind] += double_buffer[ipart];
+        data[ind] += double_buffer[ipart];
     }
-    
+}
+
+// Pairwise (tree) reduction of the private histograms, then addition to the output array
+// The private histograms are freed afterwards, so that they only exist between two reductions
+// Must be called when no thread is depositing
+void Histogram::reduce( std::vector<double> &output_array )
+{
+    unsigned int n = private_data.size();
+    unsigned int output_size = output_array.size();
+    for( unsigned int stride = 1 ; stride < n ; stride *= 2 ) {
+        for( unsigned int i = 0 ; i + stride < n ; i += 2*stride ) {
+            std::vector<double> &a = private_data[i];
+            std::vector<double> &b = private_data[i+stride];
+            if( b.size() != output_size ) {
+                continue;
+            }
+            if( a.size() != output_size ) {
+                a.swap( b );
+                continue;
+            }
+            #pragma omp simd
+            for( unsigned int j = 0 ; j < output_size ; j++ ) {
+                a[j] += b[j];
+            }
+            std::vector<double>().swap( b );
+        }
+    }
+    if( n > 0 && private_data[0].size() == output_size ) {
+        std::vector<double> &a = private_data[0];
+        #pragma omp simd
+        for( unsigned int j = 0 ; j < output_size ; j++ ) {
+            output_array[j] += a[j];
+        }
+    }
+    for( unsigned int i = 0 ; i < n ; i++ ) {
+        std::vector<double>().swap( private_data[i] );
+    }
+}
+
+// At most one private histogram per thread, unless the histogram is deposited directly
+int Histogram::getMemFootPrint( unsigned int output_size )
+{
+    if( output_size > max_private_size ) {
+        return 0;
+    }
+    return private_data.size() * output_size * sizeof( double );
 }
 
 
@@ -47,19 +47,33 @@ public:
 class Histogram
 {
 public:
-    Histogram() {};
+    Histogram();
     ~Histogram() {};
     
     //! Compute the index of each particle in the final histogram
     void digitize( Species *, std::vector<double> &, std::vector<int> &, SimWindow * );
     //! Calculate the quantity of each particle to be summed in the histogram
     virtual void valuate( Species *, std::vector<double> &, std::vector<int> & ) {};
-    //! Add the contribution of each particle in the histogram
+    //! Add the contribution of each particle in the private histogram of the calling thread,
+    //! or directly in the output array for large histograms
     void distribute( std::vector<double> &, std::vector<int> &, std::vector<double> & );
+    //! Sum the private histograms of all threads into the output array, and free them
+    void reduce( std::vector<double> & );
+    //! Memory taken by the private histograms between two reductions, for an output of the given size
+    int getMemFootPrint( unsigned int output_size );
+    
+    //! Histograms with more bins than this are deposited in the output array with atomics:
+    //! private copies would cost too much memory, and collisions between threads are rare
+    static const unsigned int max_private_size = 65536;
     
     std::string deposited_quantity;
     
     std::vector<HistogramAxis *> axes;
+    
+private:
+    //! One private histogram per OpenMP thread, allocated by the thread at its first deposit
+    //! and freed at each reduction
+    std::vector<std::vector<double> > private_data;
 };
 
 
@@ -2,11 +2,15 @@
 
 #include <limits>
 #include <iostream>
+#include <algorithm>
 
 #include "Params.h"
 #include "Species.h"
 #include "Projector.h"
 #include "Field.h"
+#include "Field1D.h"
+#include "Field2D.h"
+#include "Field3D.h"
 #include "ElectroMagnBC.h"
 #include "ElectroMagnBC_Factory.h"
 #include "SimWindow.h"
@@ -340,6 +344,55 @@ void ElectroMagn::updateGridSize( Params &params, Patch *patch )
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Reset the fields of a patch recycled by the moving window: the arrays are kept and set to zero,
+// the boundary conditions are re-created for the new position of the patch
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::recycle( Params &params, Patch *patch )
+{
+    for( unsigned int ifield=0 ; ifield<allFields.size() ; ifield++ ) {
+        if( allFields[ifield] ) {
+            allFields[ifield]->put_to( 0. );
+        }
+    }
+    for( unsigned int idiag=0 ; idiag<allFields_avg.size() ; idiag++ ) {
+        for( unsigned int ifield=0 ; ifield<allFields_avg[idiag].size() ; ifield++ ) {
+            allFields_avg[idiag][ifield]->put_to( 0. );
+        }
+    }
+    std::vector<Field *> *filters[6] = { &Exfilter, &Eyfilter, &Ezfilter, &Bxfilter, &Byfilter, &Bzfilter };
+    for( unsigned int i=0 ; i<6 ; i++ ) {
+        for( unsigned int ifield=0 ; ifield<filters[i]->size() ; ifield++ ) {
+            ( *filters[i] )[ifield]->put_to( 0. );
+        }
+    }
+    
+    // Antenna fields are only computed at initialization, as for new patches
+    for( unsigned int iAntenna=0 ; iAntenna<antennas.size() ; iAntenna++ ) {
+        delete antennas[iAntenna].field;
+        antennas[iAntenna].field = NULL;
+    }
+    
+    for( unsigned int i=0 ; i<emBoundCond.size() ; i++ ) {
+        if( emBoundCond[i] ) {
+            delete emBoundCond[i];
+        }
+    }
+    emBoundCond = ElectroMagnBC_Factory::create( params, patch );
+    
+    for( unsigned int j=0 ; j<2 ; j++ ) {
+        for( unsigned int i=0 ; i<nDim_field ; i++ ) {
+            poynting     [j][i] = 0.;
+            poynting_inst[j][i] = 0.;
+        }
+    }
+    nrj_mw_lost = 0.;
+    nrj_new_fields = 0.;
+    
+    updateGridSize( params, patch );
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Maxwell solver using the FDTD scheme
 // ---------------------------------------------------------------------------------------------------------------------
@@ -526,3 +579,172 @@ void ElectroMagn::applyAntenna( unsigned int iAntenna, double intensity )
     }
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Pipelined conjugate gradient (Ghysels & Vanroose, Parallel Computing 40, 2014)
+// The stencil and the scalar product of the geometry (compute_Ap, compute_pAp) are applied
+// to the additional vectors by temporarily pointing p_ and Ap_ to them
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::initPipelinedPoisson()
+{
+    Field **fields[4] = { &w_, &n_, &z_, &s_ };
+    for( unsigned int ifield=0 ; ifield<4 ; ifield++ ) {
+        if( nDim_field == 1 ) {
+            *fields[ifield] = new Field1D( dimPrim );
+        } else if( nDim_field == 2 ) {
+            *fields[ifield] = new Field2D( dimPrim );
+        } else {
+            *fields[ifield] = new Field3D( dimPrim );
+        }
+        ( *fields[ifield] )->put_to( 0. );
+    }
+}
+
+void ElectroMagn::deletePipelinedPoisson()
+{
+    delete w_;
+    delete n_;
+    delete z_;
+    delete s_;
+}
+
+void ElectroMagn::compute_Ax( Patch *patch, Field *x, Field *Ax )
+{
+    Field *p  = p_;
+    Field *Ap = Ap_;
+    p_  = x;
+    Ap_ = Ax;
+    compute_Ap( patch );
+    p_  = p;
+    Ap_ = Ap;
+}
+
+double ElectroMagn::compute_xy( Field *x, Field *y )
+{
+    Field *p  = p_;
+    Field *Ap = Ap_;
+    p_  = x;
+    Ap_ = y;
+    double x_dot_y_local = compute_pAp();
+    p_  = p;
+    Ap_ = Ap;
+    return x_dot_y_local;
+}
+
+void ElectroMagn::update_pipelined( double alpha_k, double beta_k )
+{
+    double *phi = phi_->data_;
+    double *r   = r_->data_;
+    double *p   = p_->data_;
+    double *w   = w_->data_;
+    double *n   = n_->data_;
+    double *z   = z_->data_;
+    double *s   = s_->data_;
+    unsigned int size = phi_->globalDims_;
+    
+    #pragma omp simd
+    for( unsigned int i=0 ; i<size ; i++ ) {
+        z[i]    = n[i] + beta_k * z[i];
+        s[i]    = w[i] + beta_k * s[i];
+        p[i]    = r[i] + beta_k * p[i];
+        phi[i] += alpha_k * p[i];
+        r[i]   -= alpha_k * s[i];
+        w[i]   -= alpha_k * z[i];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Split-phase Maxwell solver (namelist option overlap_maxwell)
+// The currents are modified by the sum on the patch borders only at the nodes i < 1+2*oversize (+1 if dual)
+// and i >= n_space. E can therefore be advanced before the end of the sum in the box [2+2*oversize, n_space[
+// of each direction, and B in the same box without its first node (B uses E at the nodes i-1 and i).
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::maxwellInteriorBox( unsigned int lo[3], unsigned int hi[3] )
+{
+    for( unsigned int i=0 ; i<3 ; i++ ) {
+        if( i<nDim_field ) {
+            lo[i] = 2+2*oversize[i];
+            hi[i] = n_space[i];
+        } else {
+            lo[i] = 0;
+            hi[i] = 1;
+        }
+    }
+}
+
+// Advances the solver in all the nodes which are not in the box [lo, hi[ (the shell is split in 2*nDim boxes)
+static void solveOutsideBox( Solver *solver, ElectroMagn *fields, unsigned int lo[3], unsigned int hi[3], unsigned int full[3] )
+{
+    for( unsigned int idim=0 ; idim<fields->nDim_field ; idim++ ) {
+        unsigned int istart[3], iend[3];
+        for( unsigned int i=0 ; i<3 ; i++ ) {
+            istart[i] = i<idim ? lo[i] : 0;
+            iend[i]   = i<idim ? hi[i] : full[i];
+        }
+        istart[idim] = 0;
+        iend[idim]   = lo[idim];
+        solver->solveInBox( fields, istart, iend );
+        istart[idim] = hi[idim];
+        iend[idim]   = full[idim];
+        solver->solveInBox( fields, istart, iend );
+    }
+}
+
+void ElectroMagn::solveMaxwellInterior( unsigned int ichunk, unsigned int nchunks )
+{
+    if( ichunk == 0 ) {
+        // Stores B at time n in B_m
+        saveMagneticFields( false );
+    }
+    
+    unsigned int lo[3], hi[3];
+    maxwellInteriorBox( lo, hi );
+    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
+        if( hi[i] <= lo[i]+1 ) {
+            // Patch too small: everything is done in solveMaxwellBorders
+            return;
+        }
+    }
+    
+    unsigned int Estart[3], Eend[3], Bstart[3], Bend[3];
+    for( unsigned int i=0 ; i<3 ; i++ ) {
+        Estart[i] = lo[i];
+        Eend[i]   = hi[i];
+        Bstart[i] = i<nDim_field ? lo[i]+1 : lo[i];
+        Bend[i]   = hi[i];
+    }
+    // Chunk along x (B of the chunk uses E of the previous chunk, already advanced)
+    Estart[0] = lo[0] + ( ( hi[0]-lo[0] ) * ichunk ) / nchunks;
+    Eend[0]   = lo[0] + ( ( hi[0]-lo[0] ) * ( ichunk+1 ) ) / nchunks;
+    Bstart[0] = std::max( Estart[0], lo[0]+1 );
+    Bend[0]   = Eend[0];
+    
+    MaxwellAmpereSolver_->solveInBox( this, Estart, Eend );
+    MaxwellFaradaySolver_->solveInBox( this, Bstart, Bend );
+}
+
+void ElectroMagn::solveMaxwellBorders()
+{
+    unsigned int lo[3], hi[3], full[3];
+    maxwellInteriorBox( lo, hi );
+    bool has_interior = true;
+    for( unsigned int i=0 ; i<3 ; i++ ) {
+        full[i] = i<nDim_field ? n_space[i]+2+2*oversize[i] : 1;
+        if( i<nDim_field && hi[i] <= lo[i]+1 ) {
+            has_interior = false;
+        }
+    }
+    
+    if( !has_interior ) {
+        unsigned int zero[3] = { 0, 0, 0 };
+        MaxwellAmpereSolver_->solveInBox( this, zero, full );
+        MaxwellFaradaySolver_->solveInBox( this, zero, full );
+        return;
+    }
+    
+    solveOutsideBox( MaxwellAmpereSolver_, this, lo, hi, full );
+    for( unsigned int i=0 ; i<nDim_field ; i++ ) {
+        lo[i]++;
+    }
+    solveOutsideBox( MaxwellFaradaySolver_, this, lo, hi, full );
+}
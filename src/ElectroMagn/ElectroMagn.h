@@ -85,6 +85,9 @@ public:
     
     void updateGridSize( Params &params, Patch *patch );
     
+    //! Reset the fields of a patch recycled by the moving window (see Patch::recycle)
+    void recycle( Params &params, Patch *patch );
+    
     void clean();
     
     std::vector<unsigned int> dimPrim;
@@ -271,6 +274,15 @@ public:
     virtual double compute_pAp() = 0;
     virtual void update_pand_r( double r_dot_r, double p_dot_Ap ) = 0;
     virtual void update_p( double rnew_dot_rnew, double r_dot_r ) = 0;
+    //! Pipelined conjugate gradient: allocation/deallocation of the additional vectors w, n, z, s
+    void initPipelinedPoisson();
+    void deletePipelinedPoisson();
+    //! Computes Ax = A*x with the stencil of compute_Ap
+    void compute_Ax( Patch *patch, Field *x, Field *Ax );
+    //! Scalar product x.y on the real nodes, with the ranges of compute_pAp
+    double compute_xy( Field *x, Field *y );
+    //! Pipelined conjugate gradient: updates of all the vectors with a single sweep
+    void update_pipelined( double alpha_k, double beta_k );
     virtual void initE( Patch *patch ) = 0;
     virtual void initE_relativistic_Poisson( Patch *patch, double gamma_mean ) = 0;
     virtual void initB_relativistic_Poisson( Patch *patch, double gamma_mean ) = 0;
@@ -302,6 +314,11 @@ public:
     Field *r_;
     Field *p_;
     Field *Ap_;
+    //! Additional vectors of the pipelined conjugate gradient: w = A*r, n = A*w, z = A*s, s = A*p
+    Field *w_;
+    Field *n_;
+    Field *z_;
+    Field *s_;
 
     cField *phi_AM_;
     cField *r_AM_;
@@ -317,6 +334,13 @@ public:
     Solver *MaxwellFaradaySolver_;
     virtual void saveMagneticFields( bool ) = 0;
     virtual void centerMagneticFields() = 0;
+    
+    //! Box of the patch where E and B can be advanced before the sum of the currents on the patch borders
+    void maxwellInteriorBox( unsigned int lo[3], unsigned int hi[3] );
+    //! Saves B (if ichunk=0) and advances E then B in the part ichunk/nchunks (along x) of the interior box
+    void solveMaxwellInterior( unsigned int ichunk, unsigned int nchunks );
+    //! Advances E then B outside of the interior box, once the currents have been summed
+    void solveMaxwellBorders();
     virtual void binomialCurrentFilter() = 0;
     
     void boundaryConditions( int itime, double time_dual, Patch *patch, Params &params, SimWindow *simWindow );
@@ -50,6 +50,19 @@ Laser::Laser( Params &params, int ilaser, Patch *patch )
         ERROR( errorPrefix << ": AM profiles can only be used in `AMcylindrical` geometry" );
     }
 
+    // Tabulation of the space-time profile: [start, end, number of times]
+    vector<double> table_times;
+    PyTools::extract( "space_time_table", table_times, "Laser", ilaser );
+    if( table_times.size() > 0 ) {
+        if( ! has_space_time ) {
+            ERROR( errorPrefix << ": `space_time_table` requires `space_time_profile`" );
+        }
+        if( table_times.size() != 3 || table_times[1] <= table_times[0] || table_times[2] < 2 ) {
+            ERROR( errorPrefix << ": `space_time_table` must be [start, end, number_of_times] with end > start and number_of_times >= 2" );
+        }
+        table_times[2] = floor( table_times[2] );
+    }
+
     unsigned int space_dims     = ( params.geometry=="3Dcartesian" ? 2 : 1 );
     unsigned int spacetime_size = ( has_space_time_AM ? 2*params.nmodes+1 : 2 );//+1 to force spacetime_size to be always >2 in AM geometry.
 
@@ -82,7 +95,7 @@ Laser::Laser( Params &params, int ilaser, Patch *patch )
             name << "Laser[" << ilaser <<"].space_time_profile["<< 2*imode << "]";
             if( spacetime[2*imode] ) {
                 p = new Profile( space_time_profile[2*imode], params.nDim_field, name.str() );
-                profiles.push_back( new LaserProfileNonSeparable( p ) );
+                profiles.push_back( new LaserProfileNonSeparable( p, true, table_times ) );
                 info << "\t\t\tfirst  component : " << p->getInfo();
                 if (has_space_time_AM) info << " mode " << imode ;
                 info << endl;
@@ -97,7 +110,7 @@ Laser::Laser( Params &params, int ilaser, Patch *patch )
             name << "Laser[" << ilaser <<"].space_time_profile[" << 2*imode+1 << "]";
             if( spacetime[2*imode+1] ) {
                 p = new Profile( space_time_profile[2*imode+1], params.nDim_field, name.str() );
-                profiles.push_back( new LaserProfileNonSeparable( p ) );
+                profiles.push_back( new LaserProfileNonSeparable( p, false, table_times ) );
                 info << "\t\t\tsecond component : " << p->getInfo() ;
                 if (has_space_time_AM) info << " mode " << imode ;
                 info << endl;
@@ -108,6 +121,9 @@ Laser::Laser( Params &params, int ilaser, Patch *patch )
                 info << endl;
             }
         }
+        if( table_times.size() > 0 ) {
+            info << "\t\t\ttabulated on " << ( unsigned int ) table_times[2] << " times between " << table_times[0] << " and " << table_times[1] << endl;
+        }
 
 
     } else if( has_file ) {
@@ -266,7 +282,9 @@ LaserProfileSeparable::LaserProfileSeparable(
     chirpProfile_( chirpProfile ),
     spaceProfile_( spaceProfile ),
     phaseProfile_( phaseProfile ),
-    delay_phase_( delay_phase )
+    delay_phase_( delay_phase ),
+    time_( std::nan( "" ) ),
+    phi_( std::nan( "" ) )
 {
     space_envelope = NULL;
     phase = NULL;
@@ -279,7 +297,9 @@ LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
     chirpProfile_( new Profile( lp->chirpProfile_ ) ),
     spaceProfile_( new Profile( lp->spaceProfile_ ) ),
     phaseProfile_( new Profile( lp->phaseProfile_ ) ),
-    delay_phase_( lp->delay_phase_ )
+    delay_phase_( lp->delay_phase_ ),
+    time_( std::nan( "" ) ),
+    phi_( std::nan( "" ) )
 {
     space_envelope = NULL;
     phase = NULL;
@@ -415,25 +435,182 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
     }
 }
 
+// Time profiles are evaluated by one thread at a time, unless they do not need the python interpreter
+static inline double timeProfileAt( Profile *profile, double t )
+{
+    if( profile->isThreadSafe() ) {
+        return profile->valueAt( t );
+    }
+    double value;
+    #pragma omp critical
+    value = profile->valueAt( t );
+    return value;
+}
+
+// The chirp only depends on time: it is evaluated once per timestep
+void LaserProfileSeparable::setTime( double t )
+{
+    if( t == time_ ) {
+        return;
+    }
+    time_ = t;
+    omega_t_ = omega_ * timeProfileAt( chirpProfile_, t );
+    phi_ = std::nan( "" );
+}
+
+// The time profile depends on the local phase, often uniform: it is re-evaluated only when the phase changes
+double LaserProfileSeparable::timeFactor( double phi )
+{
+    if( phi != phi_ ) {
+        phi_ = phi;
+        time_factor_ = timeProfileAt( timeProfile_, time_-( phi+delay_phase_ )/omega_t_ );
+    }
+    return time_factor_;
+}
+
 // Amplitude of a separable laser profile
 double LaserProfileSeparable::getAmplitude( std::vector<double> pos, double t, int j, int k )
 {
-    double amp;
-    #pragma omp critical
-    {
-        double omega = omega_ * chirpProfile_->valueAt( t );
-        double phi = ( *phase )( j, k );
-        amp = timeProfile_->valueAt( t-( phi+delay_phase_ )/omega ) * ( *space_envelope )( j, k ) * sin( omega*t - phi );
+    setTime( t );
+    double phi = ( *phase )( j, k );
+    return timeFactor( phi ) * ( *space_envelope )( j, k ) * sin( omega_t_*t - phi );
+}
+
+// Amplitudes of a line of points of a separable laser profile
+void LaserProfileSeparable::addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp )
+{
+    setTime( t );
+    unsigned int first = j*space_envelope->dims_[1] + k;
+    const double *__restrict__ phi = &( phase->data_[first] );
+    const double *__restrict__ env = &( space_envelope->data_[first] );
+    
+    line_time_factor_.resize( n );
+    double *__restrict__ tf = line_time_factor_.data();
+    for( unsigned int i=0; i<n; i++ ) {
+        tf[i] = timeFactor( phi[i] );
+    }
+    
+    double omega_t = omega_t_;
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        amp[i] += tf[i] * env[i] * sin( omega_t*t - phi[i] );
     }
-    return amp;
 }
 
+// Non-separable laser profile constructor
+LaserProfileNonSeparable::LaserProfileNonSeparable( Profile *spaceAndTimeProfile, bool primal, vector<double> table_times ) :
+    table( NULL ),
+    spaceAndTimeProfile_( spaceAndTimeProfile ),
+    primal_( primal ),
+    table_times_( table_times ),
+    table_nz_( 1 )
+{
+}
+// Non-separable laser profile cloning constructor
+LaserProfileNonSeparable::LaserProfileNonSeparable( LaserProfileNonSeparable *lp ) :
+    table( NULL ),
+    spaceAndTimeProfile_( new Profile( lp->spaceAndTimeProfile_ ) ),
+    primal_( lp->primal_ ),
+    table_times_( lp->table_times_ ),
+    table_nz_( 1 )
+{
+}
 //Destructor
 LaserProfileNonSeparable::~LaserProfileNonSeparable()
 {
     if( spaceAndTimeProfile_ ) {
         delete spaceAndTimeProfile_;
     }
+    if( table ) {
+        delete table;
+    }
+}
+
+// The table contains the same boundary points as the fields of LaserProfileSeparable
+void LaserProfileNonSeparable::createFields( Params &params, Patch *patch )
+{
+    if( table_times_.size() == 0 ) {
+        return;
+    }
+    
+    unsigned int ny = 1;
+    if( params.geometry=="2Dcartesian" || params.geometry=="3Dcartesian" ) {
+        unsigned int ny_p = params.n_space[1]*params.global_factor[1]+1+2*params.oversize[1];
+        ny = primal_ ? ny_p : ny_p+1;
+    }
+    if( params.geometry=="3Dcartesian" ) {
+        unsigned int nz_p = params.n_space[2]*params.global_factor[2]+1+2*params.oversize[2];
+        table_nz_ = primal_ ? nz_p+1 : nz_p;
+    }
+    
+    vector<unsigned int> dim( 2 );
+    dim[0] = ( unsigned int ) table_times_[2];
+    dim[1] = ny * table_nz_;
+    table = new Field2D( dim );
+}
+
+// Tabulate the profile once, so that the python function is not called during the time loop
+void LaserProfileNonSeparable::initFields( Params &params, Patch *patch )
+{
+    if( ! table ) {
+        return;
+    }
+    
+    unsigned int ntimes = table->dims_[0];
+    unsigned int npoints = table->dims_[1];
+    double dt = ( table_times_[1] - table_times_[0] ) / ( double )( ntimes-1 );
+    
+    vector<double> pos( max( params.nDim_field-1, 1u ), 0. );
+    for( unsigned int ipoint=0; ipoint<npoints; ipoint++ ) {
+        unsigned int j = ipoint / table_nz_;
+        unsigned int k = ipoint % table_nz_;
+        if( params.nDim_field > 1 ) {
+            pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( primal_?0.:0.5 ) - ( int )params.oversize[1] )*params.cell_length[1];
+        }
+        if( params.nDim_field > 2 ) {
+            pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( primal_?0.5:0. ) - ( int )params.oversize[2] )*params.cell_length[2];
+        }
+        for( unsigned int itime=0; itime<ntimes; itime++ ) {
+            double t = table_times_[0] + itime*dt;
+            double value;
+            if( spaceAndTimeProfile_->isThreadSafe() ) {
+                value = spaceAndTimeProfile_->valueAt( pos, t );
+            } else {
+                #pragma omp critical
+                value = spaceAndTimeProfile_->valueAt( pos, t );
+            }
+            ( *table )( itime, ipoint ) = value;
+        }
+    }
+}
+
+// Linear interpolation in time of the table. The profile is zero outside of the tabulated time window.
+void LaserProfileNonSeparable::addTabulated( double t, unsigned int first, unsigned int n, double *amp )
+{
+    unsigned int ntimes = table->dims_[0];
+    unsigned int npoints = table->dims_[1];
+    double x = ( t - table_times_[0] ) / ( table_times_[1] - table_times_[0] ) * ( double )( ntimes-1 );
+    if( x < 0. || x > ( double )( ntimes-1 ) ) {
+        return;
+    }
+    unsigned int itime = min( ( unsigned int ) x, ntimes-2 );
+    double w = x - ( double ) itime;
+    const double *__restrict__ v0 = &( table->data_[itime*npoints + first] );
+    const double *__restrict__ v1 = v0 + npoints;
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        amp[i] += ( 1.-w ) * v0[i] + w * v1[i];
+    }
+}
+
+// Amplitudes of a line of points of a non-separable laser profile
+void LaserProfileNonSeparable::addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp )
+{
+    if( table ) {
+        addTabulated( t, j*table_nz_+k, n, amp );
+    } else {
+        LaserProfile::addAmplitudes( pos, ipos, dpos, t, j, k, n, amp );
+    }
 }
 
 
@@ -529,23 +706,80 @@ void LaserProfileFile::initFields( Params &params, Patch *patch )
     H5Sclose( memspace );
     H5Pclose( pid );
     H5Fclose( fid );
+    
+    // magnitude*sin(omega*t+phase) = magnitude*cos(phase) sin(omega*t) + magnitude*sin(phase) cos(omega*t)
+    // The coefficients of sin(omega*t) and cos(omega*t) are stored instead, so that no sine is computed per point
+    for( unsigned int i=0; i<magnitude->globalDims_; i++ ) {
+        double m = magnitude->data_[i];
+        double p = phase->data_[i];
+        magnitude->data_[i] = m * cos( p );
+        phase    ->data_[i] = m * sin( p );
+    }
+}
+
+// The oscillating factors only depend on time: they are evaluated once per timestep
+void LaserProfileFile::setTime( double t )
+{
+    if( t == time_ ) {
+        return;
+    }
+    time_ = t;
+    sin_omega_t.resize( omega.size() );
+    cos_omega_t.resize( omega.size() );
+    for( unsigned int i=0; i<omega.size(); i++ ) {
+        sin_omega_t[i] = sin( omega[i] * t );
+        cos_omega_t[i] = cos( omega[i] * t );
+    }
 }
 
 // Amplitude of a laser profile from a file (see LaserOffset)
 double LaserProfileFile::getAmplitude( std::vector<double> pos, double t, int j, int k )
 {
+    setTime( t );
     double amp = 0;
     unsigned int n = omega.size();
     for( unsigned int i=0; i<n; i++ ) {
-        amp += ( *magnitude )( j, k, i ) * sin( omega[i] * t + ( *phase )( j, k, i ) );
+        amp += ( *magnitude )( j, k, i ) * sin_omega_t[i] + ( *phase )( j, k, i ) * cos_omega_t[i];
     }
-    #pragma omp critical
-    {
+    if( extraProfile->isThreadSafe() ) {
+        amp *= extraProfile->valueAt( pos, t );
+    } else {
+        #pragma omp critical
         amp *= extraProfile->valueAt( pos, t );
     }
     return amp;
 }
 
+// Amplitudes of a line of points of a laser profile from a file
+void LaserProfileFile::addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp )
+{
+    setTime( t );
+    unsigned int nomega = omega.size();
+    unsigned int first = ( j*magnitude->dims_[1] + k ) * nomega;
+    const double *__restrict__ s = sin_omega_t.data();
+    const double *__restrict__ c = cos_omega_t.data();
+    bool thread_safe = extraProfile->isThreadSafe();
+    double pos0 = pos[ipos];
+    for( unsigned int ipoint=0; ipoint<n; ipoint++ ) {
+        const double *__restrict__ mag = &( magnitude->data_[first + ipoint*nomega] );
+        const double *__restrict__ ph  = &( phase    ->data_[first + ipoint*nomega] );
+        double a = 0.;
+        #pragma omp simd reduction(+:a)
+        for( unsigned int i=0; i<nomega; i++ ) {
+            a += mag[i] * s[i] + ph[i] * c[i];
+        }
+        pos[ipos] = pos0 + ipoint*dpos;
+        if( thread_safe ) {
+            a *= extraProfile->valueAt( pos, t );
+        } else {
+            #pragma omp critical
+            a *= extraProfile->valueAt( pos, t );
+        }
+        amp[ipoint] += a;
+    }
+    pos[ipos] = pos0;
+}
+
 //Destructor
 LaserProfileFile::~LaserProfileFile()
 {
@@ -32,6 +32,18 @@ public:
     {
         return 0.;
     };
+    //! Adds to amp[0..n-1] the amplitudes of n boundary points that follow (j,k) in the storage order of the
+    //! laser fields: (j,k+i) in 3D and (j+i,0) in 2D. pos[ipos] is the coordinate of the first point and
+    //! increases by dpos from one point to the next.
+    virtual void addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp )
+    {
+        double pos0 = pos[ipos];
+        for( unsigned int i=0; i<n; i++ ) {
+            pos[ipos] = pos0 + i*dpos;
+            amp[i] += getAmplitude( pos, t, j, k );
+        }
+        pos[ipos] = pos0;
+    };
 
     virtual std::string getInfo()
     {
@@ -73,6 +85,17 @@ public:
         return profiles[imode]->getAmplitudecomplex( pos, t, j, k );
     }
     
+    //! Adds the amplitudes of a line of boundary points (By), see LaserProfile::addAmplitudes
+    inline void addAmplitudes0( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp )
+    {
+        profiles[0]->addAmplitudes( pos, ipos, dpos, t, j, k, n, amp );
+    }
+    //! Adds the amplitudes of a line of boundary points (Bz), see LaserProfile::addAmplitudes
+    inline void addAmplitudes1( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp )
+    {
+        profiles[1]->addAmplitudes( pos, ipos, dpos, t, j, k, n, amp );
+    }
+    
     void createFields( Params &params, Patch *patch )
     {
         profiles[0]->createFields( params, patch );
@@ -118,13 +141,28 @@ public:
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
     double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    void addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp );
 protected:
     Field *space_envelope, *phase;
 private:
+    //! Evaluates the chirp at time t, unless already done
+    void setTime( double t );
+    //! Time profile for a given phase, re-used while the phase does not change
+    double timeFactor( double phi );
+    
     bool primal_;
     double omega_;
     Profile *timeProfile_, *chirpProfile_, *spaceProfile_, *phaseProfile_;
     double delay_phase_;
+    
+    //! Time of the last evaluation of the time-dependent factors
+    double time_;
+    //! Frequency (with chirp) at time_
+    double omega_t_;
+    //! Last phase for which the time profile was evaluated, and its value
+    double phi_, time_factor_;
+    //! Time profile of each point of the current line
+    std::vector<double> line_time_factor_;
 };
 
 // Laser profile for non-separable space and time
@@ -132,29 +170,53 @@ class LaserProfileNonSeparable : public LaserProfile
 {
     friend class SmileiMPI;
 public:
-    LaserProfileNonSeparable( Profile *spaceAndTimeProfile )
-        : spaceAndTimeProfile_( spaceAndTimeProfile ) {};
-    LaserProfileNonSeparable( LaserProfileNonSeparable *lp )
-        : spaceAndTimeProfile_( new Profile( lp->spaceAndTimeProfile_ ) ) {};
+    LaserProfileNonSeparable( Profile *spaceAndTimeProfile, bool primal=true, std::vector<double> table_times=std::vector<double>() );
+    LaserProfileNonSeparable( LaserProfileNonSeparable *lp );
     ~LaserProfileNonSeparable();
+    void createFields( Params &params, Patch *patch );
+    void initFields( Params &params, Patch *patch );
     inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
     {
+        if( table ) {
+            double amp = 0.;
+            addTabulated( t, j*table_nz_+k, 1, &amp );
+            return amp;
+        }
+        if( spaceAndTimeProfile_->isThreadSafe() ) {
+            return spaceAndTimeProfile_->valueAt( pos, t );
+        }
         double amp;
         #pragma omp critical
         amp = spaceAndTimeProfile_->valueAt( pos, t );
         return amp;
     }
+    void addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp );
 
     inline std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
     {
+        if( spaceAndTimeProfile_->isThreadSafe() ) {
+            return spaceAndTimeProfile_->complexValueAt( pos, t );
+        }
         std::complex<double> amp;
         #pragma omp critical
         amp = spaceAndTimeProfile_->complexValueAt( pos, t );
         return amp;
     }
 
+protected:
+    //! Profile tabulated on the boundary points at regularly-spaced times: table(itime, j*table_nz_+k)
+    Field2D *table;
+    
 private:
+    //! Linear interpolation in time of n consecutive points of the table, added to amp
+    void addTabulated( double t, unsigned int first, unsigned int n, double *amp );
+    
     Profile *spaceAndTimeProfile_;
+    bool primal_;
+    //! Time window of the tabulation [start, end, number of times] (empty if not tabulated)
+    std::vector<double> table_times_;
+    //! Number of boundary points along z (1 in 1D and 2D)
+    unsigned int table_nz_;
 };
 
 // Laser profile from a file (see LaserOffset)
@@ -163,20 +225,29 @@ class LaserProfileFile : public LaserProfile
     friend class SmileiMPI;
 public:
     LaserProfileFile( std::string file_, Profile *ep_, bool pr_ )
-        : magnitude( NULL ), phase( NULL ), file( file_ ), extraProfile( ep_ ), primal_( pr_ ) {};
+        : magnitude( NULL ), phase( NULL ), file( file_ ), extraProfile( ep_ ), primal_( pr_ ), time_( std::nan( "" ) ) {};
     LaserProfileFile( LaserProfileFile *lp )
-        : magnitude( NULL ), phase( NULL ), file( lp->file ), extraProfile( new Profile( lp->extraProfile ) ), primal_( lp->primal_ ) {};
+        : magnitude( NULL ), phase( NULL ), file( lp->file ), extraProfile( new Profile( lp->extraProfile ) ), primal_( lp->primal_ ), time_( std::nan( "" ) ) {};
     ~LaserProfileFile();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
     double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    void addAmplitudes( std::vector<double> &pos, unsigned int ipos, double dpos, double t, int j, int k, unsigned int n, double *amp );
 protected:
+    //! After initFields, the amplitude is sum_i magnitude(i) sin(omega_i t) + phase(i) cos(omega_i t)
     Field3D *magnitude, *phase;
 private:
+    //! Evaluates sin(omega_i t) and cos(omega_i t), unless already done
+    void setTime( double t );
+    
     std::string file;
     Profile *extraProfile;
     bool primal_;
     std::vector<double> omega;
+    
+    //! Time of the last evaluation of sin_omega_t and cos_omega_t
+    double time_;
+    std::vector<double> sin_omega_t, cos_omega_t;
 };
 
 // Null laser profile
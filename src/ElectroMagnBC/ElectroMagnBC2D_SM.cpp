@@ -219,16 +219,17 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_ );
         
         // for By^(d,p)
+        // Lasers, evaluated on the whole boundary
         vector<double> yp( 1 );
+        yp[0] = patch->getDomainLocalMin( 1 ) -( ( int )EMfields->oversize[1] )*dy;
+        vector<double> laser_byW( ny_p, 0. );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            vecLaser[ilaser]->addAmplitudes0( yp, 0, dy, time_dual, 0, 0, ny_p, &laser_byW[0] );
+        }
+        
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
         
-            double byW = 0.;
-            yp[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                byW += vecLaser[ilaser]->getAmplitude0( yp, time_dual, j, 0 );
-            }
+            double byW = laser_byW[j];
             
             ( *By2D )( 0+pxr_offset, j ) = Alpha_SM_W   * ( *Ez2D )( 0+pxr_offset, j )
                                            +              Beta_SM_W    *( ( *By2D )( 1+pxr_offset, j )-By_val[j] )
@@ -241,16 +242,17 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         
         
         // for Bz^(d,d)
+        // Lasers, evaluated on the whole boundary
         vector<double> yd( 1 );
+        yd[0] = patch->getDomainLocalMin( 1 ) -( 0.5 + ( int )EMfields->oversize[1] )*dy;
+        vector<double> laser_bzW( ny_d, 0. );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            vecLaser[ilaser]->addAmplitudes1( yd, 0, dy, time_dual, 0, 0, ny_d, &laser_bzW[0] );
+        }
+        
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
         
-            double bzW = 0.;
-            yd[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                bzW += vecLaser[ilaser]->getAmplitude1( yd, time_dual, j, 0 );
-            }
+            double bzW = laser_bzW[j];
             
             /*(*Bz2D)(0,j) = -Alpha_SM_W * (*Ey2D)(0,j)
              +               Beta_SM_W  * (*Bz2D)(1,j)
@@ -273,16 +275,17 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_ );
         
         // for By^(d,p)
+        // Lasers, evaluated on the whole boundary
         vector<double> yp( 1 );
+        yp[0] = patch->getDomainLocalMin( 1 ) -( ( int )EMfields->oversize[1] )*dy;
+        vector<double> laser_byE( ny_p, 0. );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            vecLaser[ilaser]->addAmplitudes0( yp, 0, dy, time_dual, 0, 0, ny_p, &laser_byE[0] );
+        }
+        
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
         
-            double byE = 0.;
-            yp[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                byE += vecLaser[ilaser]->getAmplitude0( yp, time_dual, j, 0 );
-            }
+            double byE = laser_byE[j];
             
             /*(*By2D)(nx_d-1,j) = Alpha_SM_E   * (*Ez2D)(nx_p-1,j)
              +                   Beta_SM_E    * (*By2D)(nx_d-2,j)
@@ -300,16 +303,17 @@ void ElectroMagnBC2D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         
         
         // for Bz^(d,d)
+        // Lasers, evaluated on the whole boundary
         vector<double> yd( 1 );
+        yd[0] = patch->getDomainLocalMin( 1 ) -( 0.5 + ( int )EMfields->oversize[1] )*dy;
+        vector<double> laser_bzE( ny_d, 0. );
+        for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+            vecLaser[ilaser]->addAmplitudes1( yd, 0, dy, time_dual, 0, 0, ny_d, &laser_bzE[0] );
+        }
+        
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
         
-            double bzE = 0.;
-            yd[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            
-            // Lasers
-            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                bzE += vecLaser[ilaser]->getAmplitude1( yd, time_dual, j, 0 );
-            }
+            double bzE = laser_bzE[j];
             
             /*(*Bz2D)(nx_d-1,j) = -Alpha_SM_E * (*Ey2D)(nx_p-1,j)
              +                    Beta_SM_E  * (*Bz2D)(nx_d-2,j)
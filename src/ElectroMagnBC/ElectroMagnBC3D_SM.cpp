@@ -312,19 +312,23 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     Field3D *By3D = static_cast<Field3D *>( EMfields->By_ );
     Field3D *Bz3D = static_cast<Field3D *>( EMfields->Bz_ );
     vector<double> pos( 2 );
+    // Laser amplitudes along one line of the boundary
+    vector<double> laser_amp( nz_d );
     
     if( min_max==0 && patch->isXmin() ) {
     
         // for By^(d,p,d)
         for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
             pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k -0.5 - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                double byW = 0.;
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                    byW += vecLaser[ilaser]->getAmplitude0( pos, time_dual, j, k );
-                }
+            // Lasers, evaluated on the whole line along z
+            unsigned int kmin = patch->isZmin(), kmax = nz_d-patch->isZmax();
+            pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )kmin -0.5 - ( int )EMfields->oversize[2] )*dz;
+            fill( laser_amp.begin(), laser_amp.end(), 0. );
+            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+                vecLaser[ilaser]->addAmplitudes0( pos, 1, dz, time_dual, j, kmin, kmax-kmin, &laser_amp[kmin] );
+            }
+            for( unsigned int k=kmin ; k<kmax ; k++ ) {
+                double byW = laser_amp[k];
                 
                 ( *By3D )( 0, j, k ) = Alpha_SM_W   * ( *Ez3D )( 0, j, k )
                                        +              Beta_SM_W    *( ( *By3D )( 1, j, k )-( *By_val )( j, k ) )
@@ -338,13 +342,15 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         // for Bz^(d,d,p)
         for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
             pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                double bzW = 0.;
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                    bzW += vecLaser[ilaser]->getAmplitude1( pos, time_dual, j, k );
-                }
+            // Lasers, evaluated on the whole line along z
+            unsigned int kmin = patch->isZmin(), kmax = nz_p-patch->isZmax();
+            pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )kmin - ( int )EMfields->oversize[2] )*dz;
+            fill( laser_amp.begin(), laser_amp.end(), 0. );
+            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+                vecLaser[ilaser]->addAmplitudes1( pos, 1, dz, time_dual, j, kmin, kmax-kmin, &laser_amp[kmin] );
+            }
+            for( unsigned int k=kmin ; k<kmax ; k++ ) {
+                double bzW = laser_amp[k];
                 
                 ( *Bz3D )( 0, j, k ) = - Alpha_SM_W   * ( *Ey3D )( 0, j, k )
                                        +              Beta_SM_W    *( ( *Bz3D )( 1, j, k )-( *Bz_val )( j, k ) )
@@ -360,13 +366,15 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         // for By^(d,p,d)
         for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
             pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - 0.5 - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                double byE = 0.;
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                    byE += vecLaser[ilaser]->getAmplitude0( pos, time_dual, j, k );
-                }
+            // Lasers, evaluated on the whole line along z
+            unsigned int kmin = patch->isZmin(), kmax = nz_d-patch->isZmax();
+            pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )kmin - 0.5 - ( int )EMfields->oversize[2] )*dz;
+            fill( laser_amp.begin(), laser_amp.end(), 0. );
+            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+                vecLaser[ilaser]->addAmplitudes0( pos, 1, dz, time_dual, j, kmin, kmax-kmin, &laser_amp[kmin] );
+            }
+            for( unsigned int k=kmin ; k<kmax ; k++ ) {
+                double byE = laser_amp[k];
                 
                 ( *By3D )( nx_d-1, j, k ) = Alpha_SM_E   * ( *Ez3D )( nx_p-1, j, k )
                                             +                   Beta_SM_E    *( ( *By3D )( nx_d-2, j, k ) -( *By_val )( j, k ) )
@@ -381,13 +389,15 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         // for Bz^(d,d,p)
         for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax(); j++ ) {
             pos[0] = patch->getDomainLocalMin( 1 ) + ( ( int )j - 0.5 - ( int )EMfields->oversize[1] )*dy;
-            for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
-                pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )k - ( int )EMfields->oversize[2] )*dz;
-                // Lasers
-                double bzE = 0.;
-                for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
-                    bzE += vecLaser[ilaser]->getAmplitude1( pos, time_dual, j, k );
-                }
+            // Lasers, evaluated on the whole line along z
+            unsigned int kmin = patch->isZmin(), kmax = nz_p-patch->isZmax();
+            pos[1] = patch->getDomainLocalMin( 2 ) + ( ( int )kmin - ( int )EMfields->oversize[2] )*dz;
+            fill( laser_amp.begin(), laser_amp.end(), 0. );
+            for( unsigned int ilaser=0; ilaser< vecLaser.size(); ilaser++ ) {
+                vecLaser[ilaser]->addAmplitudes1( pos, 1, dz, time_dual, j, kmin, kmax-kmin, &laser_amp[kmin] );
+            }
+            for( unsigned int k=kmin ; k<kmax ; k++ ) {
+                double bzE = laser_amp[k];
                 
                 ( *Bz3D )( nx_d-1, j, k ) = -Alpha_SM_E * ( *Ey3D )( nx_p-1, j, k )
                                             +                    Beta_SM_E  *( ( *Bz3D )( nx_d-2, j, k ) -( *Bz_val )( j, k ) )
@@ -0,0 +1,155 @@
+#include "Fused_Solver3D_Yee.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+Fused_Solver3D_Yee::Fused_Solver3D_Yee( Params &params )
+    : Solver3D( params )
+{
+    // Tiles hold about 3 planes of the 12 fields involved (E, B, B_m, J) in 256 kB
+    tile_ny_ = std::max( 1u, ( 256u*1024u ) / ( 3u*12u*nz_d*( unsigned int )sizeof( double ) ) );
+}
+
+Fused_Solver3D_Yee::~Fused_Solver3D_Yee()
+{
+}
+
+void Fused_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    // Static-cast of the fields
+    Field3D *Ex3D   = static_cast<Field3D *>( fields->Ex_ );
+    Field3D *Ey3D   = static_cast<Field3D *>( fields->Ey_ );
+    Field3D *Ez3D   = static_cast<Field3D *>( fields->Ez_ );
+    Field3D *Bx3D   = static_cast<Field3D *>( fields->Bx_ );
+    Field3D *By3D   = static_cast<Field3D *>( fields->By_ );
+    Field3D *Bz3D   = static_cast<Field3D *>( fields->Bz_ );
+    Field3D *Bx3D_m = static_cast<Field3D *>( fields->Bx_m );
+    Field3D *By3D_m = static_cast<Field3D *>( fields->By_m );
+    Field3D *Bz3D_m = static_cast<Field3D *>( fields->Bz_m );
+    Field3D *Jx3D   = static_cast<Field3D *>( fields->Jx_ );
+    Field3D *Jy3D   = static_cast<Field3D *>( fields->Jy_ );
+    Field3D *Jz3D   = static_cast<Field3D *>( fields->Jz_ );
+    
+    double *Ex   = Ex3D->data_;
+    double *Ey   = Ey3D->data_;
+    double *Ez   = Ez3D->data_;
+    double *Bx   = Bx3D->data_;
+    double *By   = By3D->data_;
+    double *Bz   = Bz3D->data_;
+    double *Bx_m = Bx3D_m->data_;
+    double *By_m = By3D_m->data_;
+    double *Bz_m = Bz3D_m->data_;
+    double *Jx   = Jx3D->data_;
+    double *Jy   = Jy3D->data_;
+    double *Jz   = Jz3D->data_;
+    
+    // The rows of a tile only depend on B in the rows j and j+1 (not yet updated)
+    // and on E in the rows j and j-1 (already updated by this tile or the previous one)
+    for( unsigned int j0=0 ; j0<ny_d ; j0+=tile_ny_ ) {
+        unsigned int j1 = std::min( j0+tile_ny_, ny_d );
+        
+        for( unsigned int i=0 ; i<nx_d ; i++ ) {
+        
+            // ----------------------------------------------
+            // Maxwell-Ampere in the plane i (uses B^n in i and i+1)
+            // ----------------------------------------------
+            for( unsigned int j=j0 ; j<j1 ; j++ ) {
+                // Electric field Ex^(d,p,p)
+                if( j<ny_p ) {
+                    double *ex        = &Ex[Ex3D->index( i, j, 0 )];
+                    const double *jx  = &Jx[Jx3D->index( i, j, 0 )];
+                    const double *by  = &By[By3D->index( i, j, 0 )];
+                    const double *bz  = &Bz[Bz3D->index( i, j, 0 )];
+                    const double *bzp = &Bz[Bz3D->index( i, j+1, 0 )];
+                    #pragma omp simd
+                    for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                        ex[k] += -dt*jx[k]
+                                 +                 dt_ov_dy * ( bzp[k] - bz[k] )
+                                 -                 dt_ov_dz * ( by[k+1] - by[k] );
+                    }
+                }
+                if( i<nx_p ) {
+                    // Electric field Ey^(p,d,p)
+                    double *ey        = &Ey[Ey3D->index( i, j, 0 )];
+                    const double *jy  = &Jy[Jy3D->index( i, j, 0 )];
+                    const double *bx  = &Bx[Bx3D->index( i, j, 0 )];
+                    const double *bz  = &Bz[Bz3D->index( i, j, 0 )];
+                    const double *bzp = &Bz[Bz3D->index( i+1, j, 0 )];
+                    #pragma omp simd
+                    for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                        ey[k] += -dt*jy[k]
+                                 -                  dt_ov_dx * ( bzp[k] - bz[k] )
+                                 +                  dt_ov_dz * ( bx[k+1] - bx[k] );
+                    }
+                    // Electric field Ez^(p,p,d)
+                    if( j<ny_p ) {
+                        double *ez        = &Ez[Ez3D->index( i, j, 0 )];
+                        const double *jz  = &Jz[Jz3D->index( i, j, 0 )];
+                        const double *by  = &By[By3D->index( i, j, 0 )];
+                        const double *byp = &By[By3D->index( i+1, j, 0 )];
+                        const double *bx  = &Bx[Bx3D->index( i, j, 0 )];
+                        const double *bxp = &Bx[Bx3D->index( i, j+1, 0 )];
+                        #pragma omp simd
+                        for( unsigned int k=0 ; k<nz_d ; k++ ) {
+                            ez[k] += -dt*jz[k]
+                                     +                  dt_ov_dx * ( byp[k] - by[k] )
+                                     -                  dt_ov_dy * ( bxp[k] - bx[k] );
+                        }
+                    }
+                }
+            }
+            
+            // ----------------------------------------------
+            // Save B^n in B_m, then Maxwell-Faraday in the plane i (uses E^n+1 in i and i-1)
+            // ----------------------------------------------
+            for( unsigned int j=j0 ; j<j1 ; j++ ) {
+                // Magnetic field Bx^(p,d,d)
+                if( i<nx_p ) {
+                    double *bx        = &Bx[Bx3D->index( i, j, 0 )];
+                    memcpy( &Bx_m[Bx3D_m->index( i, j, 0 )], bx, nz_d*sizeof( double ) );
+                    if( j>0 && j<ny_d-1 ) {
+                        const double *ey  = &Ey[Ey3D->index( i, j, 0 )];
+                        const double *ez  = &Ez[Ez3D->index( i, j, 0 )];
+                        const double *ezm = &Ez[Ez3D->index( i, j-1, 0 )];
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                            bx[k] += -dt_ov_dy * ( ez[k] - ezm[k] ) + dt_ov_dz * ( ey[k] - ey[k-1] );
+                        }
+                    }
+                }
+                // Magnetic field By^(d,p,d)
+                if( j<ny_p ) {
+                    double *by        = &By[By3D->index( i, j, 0 )];
+                    memcpy( &By_m[By3D_m->index( i, j, 0 )], by, nz_d*sizeof( double ) );
+                    if( i>0 && i<nx_d-1 ) {
+                        const double *ex  = &Ex[Ex3D->index( i, j, 0 )];
+                        const double *ez  = &Ez[Ez3D->index( i, j, 0 )];
+                        const double *ezm = &Ez[Ez3D->index( i-1, j, 0 )];
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                            by[k] += -dt_ov_dz * ( ex[k] - ex[k-1] ) + dt_ov_dx * ( ez[k] - ezm[k] );
+                        }
+                    }
+                }
+                // Magnetic field Bz^(d,d,p)
+                double *bz        = &Bz[Bz3D->index( i, j, 0 )];
+                memcpy( &Bz_m[Bz3D_m->index( i, j, 0 )], bz, nz_p*sizeof( double ) );
+                if( i>0 && i<nx_d-1 && j>0 && j<ny_d-1 ) {
+                    const double *ey  = &Ey[Ey3D->index( i, j, 0 )];
+                    const double *eym = &Ey[Ey3D->index( i-1, j, 0 )];
+                    const double *ex  = &Ex[Ex3D->index( i, j, 0 )];
+                    const double *exm = &Ex[Ex3D->index( i, j-1, 0 )];
+                    #pragma omp simd
+                    for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                        bz[k] += -dt_ov_dx * ( ey[k] - eym[k] ) + dt_ov_dy * ( ex[k] - exm[k] );
+                    }
+                }
+            }
+        }
+    }
+    
+}
+
@@ -0,0 +1,32 @@
+#ifndef FUSED_SOLVER3D_YEE_H
+#define FUSED_SOLVER3D_YEE_H
+
+#include "Solver3D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Fused_Solver3D_Yee
+//! Saves B in B_m, then solves Maxwell-Ampere (MA_Solver3D_norm) and Maxwell-Faraday (MF_Solver3D_Yee)
+//! in a single pass over the fields of a patch. The pass is tiled along y, and each tile is swept as a
+//! wavefront along x: E is advanced in the plane i, then B in the same plane, which only needs E in the
+//! planes i and i-1. Results are identical to the successive sweeps of the separate solvers.
+//  --------------------------------------------------------------------------------------------------------------------
+class Fused_Solver3D_Yee : public Solver3D
+{
+
+public:
+    //! Creator for Fused_Solver3D_Yee
+    Fused_Solver3D_Yee( Params &params );
+    virtual ~Fused_Solver3D_Yee();
+    
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn *fields );
+    
+protected:
+    //! Number of rows along y in a tile
+    unsigned int tile_ny_;
+    
+};//END class
+
+#endif
+
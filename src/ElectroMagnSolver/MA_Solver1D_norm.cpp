@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field1D.h"
 
+#include <algorithm>
+
 MA_Solver1D_norm::MA_Solver1D_norm( Params &params )
     : Solver1D( params )
 {
@@ -14,6 +16,13 @@ MA_Solver1D_norm::~MA_Solver1D_norm()
 }
 
 void MA_Solver1D_norm::operator()( ElectroMagn *fields )
+{
+    unsigned int istart[3] = { 0, 0, 0 };
+    unsigned int iend[3]   = { nx_d, 1, 1 };
+    solveInBox( fields, istart, iend );
+}
+
+void MA_Solver1D_norm::solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
 {
     Field1D *Ex1D = static_cast<Field1D *>( fields->Ex_ );
     Field1D *Ey1D = static_cast<Field1D *>( fields->Ey_ );
@@ -24,15 +33,17 @@ void MA_Solver1D_norm::operator()( ElectroMagn *fields )
     Field1D *Jy1D = static_cast<Field1D *>( fields->Jy_ );
     Field1D *Jz1D = static_cast<Field1D *>( fields->Jz_ );
     
+    unsigned int ip1 = std::min( iend[0], nx_p ), id1 = std::min( iend[0], nx_d );
+    
     // --------------------
     // Solve Maxwell-Ampere
     // --------------------
     // Calculate the electrostatic field ex on the dual grid
-    for( unsigned int ix=0 ; ix<nx_d ; ix++ ) {
+    for( unsigned int ix=istart[0] ; ix<id1 ; ix++ ) {
         ( *Ex1D )( ix )= ( *Ex1D )( ix ) - dt * ( *Jx1D )( ix ) ;
     }
     // Transverse fields ey, ez  are defined on the primal grid
-    for( unsigned int ix=0 ; ix<nx_p ; ix++ ) {
+    for( unsigned int ix=istart[0] ; ix<ip1 ; ix++ ) {
         ( *Ey1D )( ix )= ( *Ey1D )( ix ) - dt_ov_dx * ( ( *Bz1D )( ix+1 ) - ( *Bz1D )( ix ) ) - dt * ( *Jy1D )( ix ) ;
         ( *Ez1D )( ix )= ( *Ez1D )( ix ) + dt_ov_dx * ( ( *By1D )( ix+1 ) - ( *By1D )( ix ) ) - dt * ( *Jz1D )( ix ) ;
     }
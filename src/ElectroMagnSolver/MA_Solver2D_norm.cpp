@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field2D.h"
 
+#include <algorithm>
+
 MA_Solver2D_norm::MA_Solver2D_norm( Params &params )
     : Solver2D( params )
 {
@@ -14,6 +16,13 @@ MA_Solver2D_norm::~MA_Solver2D_norm()
 }
 
 void MA_Solver2D_norm::operator()( ElectroMagn *fields )
+{
+    unsigned int istart[3] = { 0, 0, 0 };
+    unsigned int iend[3]   = { nx_d, ny_d, 1 };
+    solveInBox( fields, istart, iend );
+}
+
+void MA_Solver2D_norm::solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
 {
 
     // Static-cast of the fields
@@ -26,23 +35,28 @@ void MA_Solver2D_norm::operator()( ElectroMagn *fields )
     Field2D *Jx2D = static_cast<Field2D *>( fields->Jx_ );
     Field2D *Jy2D = static_cast<Field2D *>( fields->Jy_ );
     Field2D *Jz2D = static_cast<Field2D *>( fields->Jz_ );
+    
+    // Ranges of the box on the primal and dual grids
+    unsigned int ip1 = std::min( iend[0], nx_p ), id1 = std::min( iend[0], nx_d );
+    unsigned int jp1 = std::min( iend[1], ny_p ), jd1 = std::min( iend[1], ny_d );
+    
     // Electric field Ex^(d,p)
-    for( unsigned int i=0 ; i<nx_d ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+    for( unsigned int i=istart[0] ; i<id1 ; i++ ) {
+        for( unsigned int j=istart[1] ; j<jp1 ; j++ ) {
             ( *Ex2D )( i, j ) += -dt*( *Jx2D )( i, j ) + dt_ov_dy * ( ( *Bz2D )( i, j+1 ) - ( *Bz2D )( i, j ) );
         }
     }
     
     // Electric field Ey^(p,d)
-    for( unsigned int i=0 ; i<nx_p ; i++ ) {
-        for( unsigned int j=0 ; j<ny_d ; j++ ) {
+    for( unsigned int i=istart[0] ; i<ip1 ; i++ ) {
+        for( unsigned int j=istart[1] ; j<jd1 ; j++ ) {
             ( *Ey2D )( i, j ) += -dt*( *Jy2D )( i, j ) - dt_ov_dx * ( ( *Bz2D )( i+1, j ) - ( *Bz2D )( i, j ) );
         }
     }
     
     // Electric field Ez^(p,p)
-    for( unsigned int i=0 ;  i<nx_p ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+    for( unsigned int i=istart[0] ;  i<ip1 ; i++ ) {
+        for( unsigned int j=istart[1] ; j<jp1 ; j++ ) {
             ( *Ez2D )( i, j ) += -dt*( *Jz2D )( i, j )
                                  +               dt_ov_dx * ( ( *By2D )( i+1, j ) - ( *By2D )( i, j ) )
                                  -               dt_ov_dy * ( ( *Bx2D )( i, j+1 ) - ( *Bx2D )( i, j ) );
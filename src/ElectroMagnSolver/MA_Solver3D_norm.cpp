@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
+#include <algorithm>
+
 MA_Solver3D_norm::MA_Solver3D_norm( Params &params )
     : Solver3D( params )
 {
@@ -14,6 +16,13 @@ MA_Solver3D_norm::~MA_Solver3D_norm()
 }
 
 void MA_Solver3D_norm::operator()( ElectroMagn *fields )
+{
+    unsigned int istart[3] = { 0, 0, 0 };
+    unsigned int iend[3]   = { nx_d, ny_d, nz_d };
+    solveInBox( fields, istart, iend );
+}
+
+void MA_Solver3D_norm::solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
 {
 
     // Static-cast of the fields
@@ -27,35 +36,70 @@ void MA_Solver3D_norm::operator()( ElectroMagn *fields )
     Field3D *Jy3D = static_cast<Field3D *>( fields->Jy_ );
     Field3D *Jz3D = static_cast<Field3D *>( fields->Jz_ );
     
+    // Rows along z are contiguous in memory: the inner loops are vectorized
+    double *Ex = Ex3D->data_;
+    double *Ey = Ey3D->data_;
+    double *Ez = Ez3D->data_;
+    double *Bx = Bx3D->data_;
+    double *By = By3D->data_;
+    double *Bz = Bz3D->data_;
+    double *Jx = Jx3D->data_;
+    double *Jy = Jy3D->data_;
+    double *Jz = Jz3D->data_;
+    
+    // Ranges of the box on the primal and dual grids
+    unsigned int ip1 = std::min( iend[0], nx_p ), id1 = std::min( iend[0], nx_d );
+    unsigned int jp1 = std::min( iend[1], ny_p ), jd1 = std::min( iend[1], ny_d );
+    unsigned int kp0 = istart[2], kp1 = std::min( iend[2], nz_p ), kd1 = std::min( iend[2], nz_d );
+    
     // Electric field Ex^(d,p,p)
-    for( unsigned int i=0 ; i<nx_d ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Ex3D )( i, j, k ) += -dt*( *Jx3D )( i, j, k )
-                                        +                 dt_ov_dy * ( ( *Bz3D )( i, j+1, k ) - ( *Bz3D )( i, j, k ) )
-                                        -                 dt_ov_dz * ( ( *By3D )( i, j, k+1 ) - ( *By3D )( i, j, k ) );
+    for( unsigned int i=istart[0] ; i<id1 ; i++ ) {
+        for( unsigned int j=istart[1] ; j<jp1 ; j++ ) {
+            double *ex        = &Ex[Ex3D->index( i, j, 0 )];
+            const double *jx  = &Jx[Jx3D->index( i, j, 0 )];
+            const double *by  = &By[By3D->index( i, j, 0 )];
+            const double *bz  = &Bz[Bz3D->index( i, j, 0 )];
+            const double *bzp = &Bz[Bz3D->index( i, j+1, 0 )];
+            #pragma omp simd
+            for( unsigned int k=kp0 ; k<kp1 ; k++ ) {
+                ex[k] += -dt*jx[k]
+                         +                 dt_ov_dy * ( bzp[k] - bz[k] )
+                         -                 dt_ov_dz * ( by[k+1] - by[k] );
             }
         }
     }
     
     // Electric field Ey^(p,d,p)
-    for( unsigned int i=0 ; i<nx_p ; i++ ) {
-        for( unsigned int j=0 ; j<ny_d ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Ey3D )( i, j, k ) += -dt*( *Jy3D )( i, j, k )
-                                        -                  dt_ov_dx * ( ( *Bz3D )( i+1, j, k ) - ( *Bz3D )( i, j, k ) )
-                                        +                  dt_ov_dz * ( ( *Bx3D )( i, j, k+1 ) - ( *Bx3D )( i, j, k ) );
+    for( unsigned int i=istart[0] ; i<ip1 ; i++ ) {
+        for( unsigned int j=istart[1] ; j<jd1 ; j++ ) {
+            double *ey        = &Ey[Ey3D->index( i, j, 0 )];
+            const double *jy  = &Jy[Jy3D->index( i, j, 0 )];
+            const double *bx  = &Bx[Bx3D->index( i, j, 0 )];
+            const double *bz  = &Bz[Bz3D->index( i, j, 0 )];
+            const double *bzp = &Bz[Bz3D->index( i+1, j, 0 )];
+            #pragma omp simd
+            for( unsigned int k=kp0 ; k<kp1 ; k++ ) {
+                ey[k] += -dt*jy[k]
+                         -                  dt_ov_dx * ( bzp[k] - bz[k] )
+                         +                  dt_ov_dz * ( bx[k+1] - bx[k] );
             }
         }
     }
     
     // Electric field Ez^(p,p,d)
-    for( unsigned int i=0 ;  i<nx_p ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=0 ; k<nz_d ; k++ ) {
-                ( *Ez3D )( i, j, k ) += -dt*( *Jz3D )( i, j, k )
-                                        +                  dt_ov_dx * ( ( *By3D )( i+1, j, k ) - ( *By3D )( i, j, k ) )
-                                        -                  dt_ov_dy * ( ( *Bx3D )( i, j+1, k ) - ( *Bx3D )( i, j, k ) );
+    for( unsigned int i=istart[0] ;  i<ip1 ; i++ ) {
+        for( unsigned int j=istart[1] ; j<jp1 ; j++ ) {
+            double *ez        = &Ez[Ez3D->index( i, j, 0 )];
+            const double *jz  = &Jz[Jz3D->index( i, j, 0 )];
+            const double *by  = &By[By3D->index( i, j, 0 )];
+            const double *byp = &By[By3D->index( i+1, j, 0 )];
+            const double *bx  = &Bx[Bx3D->index( i, j, 0 )];
+            const double *bxp = &Bx[Bx3D->index( i, j+1, 0 )];
+            #pragma omp simd
+            for( unsigned int k=kp0 ; k<kd1 ; k++ ) {
+                ez[k] += -dt*jz[k]
+                         +                  dt_ov_dx * ( byp[k] - by[k] )
+                         -                  dt_ov_dy * ( bxp[k] - bx[k] );
             }
         }
     }
@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field1D.h"
 
+#include <algorithm>
+
 MF_Solver1D_Yee::MF_Solver1D_Yee( Params &params )
     : Solver1D( params )
 {
@@ -14,19 +16,27 @@ MF_Solver1D_Yee::~MF_Solver1D_Yee()
 }
 
 void MF_Solver1D_Yee::operator()( ElectroMagn *fields )
+{
+    unsigned int istart[3] = { 0, 0, 0 };
+    unsigned int iend[3]   = { nx_d, 1, 1 };
+    solveInBox( fields, istart, iend );
+}
+
+void MF_Solver1D_Yee::solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
 {
     Field1D *Ey1D   = static_cast<Field1D *>( fields->Ey_ );
     Field1D *Ez1D   = static_cast<Field1D *>( fields->Ez_ );
     Field1D *By1D   = static_cast<Field1D *>( fields->By_ );
     Field1D *Bz1D   = static_cast<Field1D *>( fields->Bz_ );
     
+    unsigned int id0 = std::max( istart[0], 1u ), id1 = std::min( iend[0], nx_d-1 );
+    
     // ---------------------
     // Solve Maxwell-Faraday
     // ---------------------
     // NB: bx is given in 1d and defined when initializing the fields (here put to 0)
     // Transverse fields  by & bz are defined on the dual grid
-    //for (unsigned int ix=1 ; ix<nx_p ; ix++) {
-    for( unsigned int ix=1 ; ix<nx_d-1 ; ix++ ) {
+    for( unsigned int ix=id0 ; ix<id1 ; ix++ ) {
         ( *By1D )( ix )= ( *By1D )( ix ) + dt_ov_dx * ( ( *Ez1D )( ix ) - ( *Ez1D )( ix-1 ) ) ;
         ( *Bz1D )( ix )= ( *Bz1D )( ix ) - dt_ov_dx * ( ( *Ey1D )( ix ) - ( *Ey1D )( ix-1 ) ) ;
     }
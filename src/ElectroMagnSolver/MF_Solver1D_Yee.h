@@ -18,6 +18,9 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields );
     
+    //! Solves only at the nodes of index istart[d] <= i_d < iend[d]
+    virtual void solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] );
+    
 protected:
 
 };//END class
@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field2D.h"
 
+#include <algorithm>
+
 MF_Solver2D_Yee::MF_Solver2D_Yee( Params &params )
     : Solver2D( params )
 {
@@ -18,6 +20,13 @@ MF_Solver2D_Yee::~MF_Solver2D_Yee()
 }
 
 void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
+{
+    unsigned int istart[3] = { 0, 0, 0 };
+    unsigned int iend[3]   = { nx_d, ny_d, 1 };
+    solveInBox( fields, istart, iend );
+}
+
+void MF_Solver2D_Yee::solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
 {
     // Static-cast of the fields
     Field2D *Ex2D;
@@ -34,39 +43,33 @@ void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
     Field2D *By2D = static_cast<Field2D *>( fields->By_ );
     Field2D *Bz2D = static_cast<Field2D *>( fields->Bz_ );
     
+    // Ranges of the box on the primal grid and on the interior of the dual grid
+    unsigned int ip1 = std::min( iend[0], nx_p );
+    unsigned int id0 = std::max( istart[0], 1u ), id1 = std::min( iend[0], nx_d-1 );
+    unsigned int jp0 = istart[1], jp1 = std::min( iend[1], ny_p );
+    unsigned int jd0 = std::max( istart[1], 1u ), jd1 = std::min( iend[1], ny_d-1 );
+    
     // Magnetic field Bx^(p,d)
-    //cout << "nx_p,nx_d-1" << nx_p << " " << nx_d-1 ;
-    //{
-    {
+    for( unsigned int i=istart[0] ; i<ip1;  i++ ) {
         #pragma omp simd
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            ( *Bx2D )( 0, j ) -= dt_ov_dy * ( ( *Ez2D )( 0, j ) - ( *Ez2D )( 0, j-1 ) );
-        }
-    }
-    //    for (unsigned int i=0 ; i<nx_p;  i++) {
-    for( unsigned int i=1 ; i<nx_d-1;  i++ ) {
-        #pragma omp simd
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+        for( unsigned int j=jd0 ; j<jd1 ; j++ ) {
             ( *Bx2D )( i, j ) -= dt_ov_dy * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i, j-1 ) );
         }
-        //    }
-        
+    }
+    
+    for( unsigned int i=id0 ; i<id1;  i++ ) {
         // Magnetic field By^(d,p)
-        //    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+        for( unsigned int j=jp0 ; j<jp1 ; j++ ) {
             ( *By2D )( i, j ) += dt_ov_dx * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i-1, j ) );
         }
-        //}
         
         // Magnetic field Bz^(d,d)
-        //for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+        for( unsigned int j=jd0 ; j<jd1 ; j++ ) {
             ( *Bz2D )( i, j ) += dt_ov_dy * ( ( *Ex2D )( i, j ) - ( *Ex2D )( i, j-1 ) )
                                  -               dt_ov_dx * ( ( *Ey2D )( i, j ) - ( *Ey2D )( i-1, j ) );
         }
     }
-    //}// end parallel
 }
 
@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
+#include <algorithm>
+
 MF_Solver3D_Yee::MF_Solver3D_Yee( Params &params )
     : Solver3D( params )
 {
@@ -14,6 +16,13 @@ MF_Solver3D_Yee::~MF_Solver3D_Yee()
 }
 
 void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    unsigned int istart[3] = { 0, 0, 0 };
+    unsigned int iend[3]   = { nx_d, ny_d, nz_d };
+    solveInBox( fields, istart, iend );
+}
+
+void MF_Solver3D_Yee::solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
 {
     // Static-cast of the fields
     Field3D *Ex3D = static_cast<Field3D *>( fields->Ex_ );
@@ -23,29 +32,61 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     Field3D *By3D = static_cast<Field3D *>( fields->By_ );
     Field3D *Bz3D = static_cast<Field3D *>( fields->Bz_ );
     
+    // Rows along z are contiguous in memory: the inner loops are vectorized
+    double *Ex = Ex3D->data_;
+    double *Ey = Ey3D->data_;
+    double *Ez = Ez3D->data_;
+    double *Bx = Bx3D->data_;
+    double *By = By3D->data_;
+    double *Bz = Bz3D->data_;
+    
+    // Ranges of the box on the primal grid and on the interior of the dual grid
+    unsigned int ip0 = istart[0], ip1 = std::min( iend[0], nx_p );
+    unsigned int id0 = std::max( istart[0], 1u ), id1 = std::min( iend[0], nx_d-1 );
+    unsigned int jp0 = istart[1], jp1 = std::min( iend[1], ny_p );
+    unsigned int jd0 = std::max( istart[1], 1u ), jd1 = std::min( iend[1], ny_d-1 );
+    unsigned int kp0 = istart[2], kp1 = std::min( iend[2], nz_p );
+    unsigned int kd0 = std::max( istart[2], 1u ), kd1 = std::min( iend[2], nz_d-1 );
+    
     // Magnetic field Bx^(p,d,d)
-    for( unsigned int i=0 ; i<nx_p;  i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *Bx3D )( i, j, k ) += -dt_ov_dy * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i, j-1, k ) ) + dt_ov_dz * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i, j, k-1 ) );
+    for( unsigned int i=ip0 ; i<ip1;  i++ ) {
+        for( unsigned int j=jd0 ; j<jd1 ; j++ ) {
+            double *bx        = &Bx[Bx3D->index( i, j, 0 )];
+            const double *ey  = &Ey[Ey3D->index( i, j, 0 )];
+            const double *ez  = &Ez[Ez3D->index( i, j, 0 )];
+            const double *ezm = &Ez[Ez3D->index( i, j-1, 0 )];
+            #pragma omp simd
+            for( unsigned int k=kd0 ; k<kd1 ; k++ ) {
+                bx[k] += -dt_ov_dy * ( ez[k] - ezm[k] ) + dt_ov_dz * ( ey[k] - ey[k-1] );
             }
         }
     }
     
     // Magnetic field By^(d,p,d)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *By3D )( i, j, k ) += -dt_ov_dz * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j, k-1 ) ) + dt_ov_dx * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i-1, j, k ) );
+    for( unsigned int i=id0 ; i<id1 ; i++ ) {
+        for( unsigned int j=jp0 ; j<jp1 ; j++ ) {
+            double *by        = &By[By3D->index( i, j, 0 )];
+            const double *ex  = &Ex[Ex3D->index( i, j, 0 )];
+            const double *ez  = &Ez[Ez3D->index( i, j, 0 )];
+            const double *ezm = &Ez[Ez3D->index( i-1, j, 0 )];
+            #pragma omp simd
+            for( unsigned int k=kd0 ; k<kd1 ; k++ ) {
+                by[k] += -dt_ov_dz * ( ex[k] - ex[k-1] ) + dt_ov_dx * ( ez[k] - ezm[k] );
             }
         }
     }
     
     // Magnetic field Bz^(d,d,p)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Bz3D )( i, j, k ) += -dt_ov_dx * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i-1, j, k ) ) + dt_ov_dy * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j-1, k ) );
+    for( unsigned int i=id0 ; i<id1 ; i++ ) {
+        for( unsigned int j=jd0 ; j<jd1 ; j++ ) {
+            double *bz        = &Bz[Bz3D->index( i, j, 0 )];
+            const double *ey  = &Ey[Ey3D->index( i, j, 0 )];
+            const double *eym = &Ey[Ey3D->index( i-1, j, 0 )];
+            const double *ex  = &Ex[Ex3D->index( i, j, 0 )];
+            const double *exm = &Ex[Ex3D->index( i, j-1, 0 )];
+            #pragma omp simd
+            for( unsigned int k=kp0 ; k<kp1 ; k++ ) {
+                bz[k] += -dt_ov_dx * ( ey[k] - eym[k] ) + dt_ov_dy * ( ex[k] - exm[k] );
             }
         }
     }
@@ -2,6 +2,7 @@
 #define SOLVER_H
 
 #include "Params.h"
+#include "Tools.h"
 
 class ElectroMagn;
 
@@ -20,6 +21,13 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields ) = 0;
     
+    //! Solves only at the nodes of index istart[d] <= i_d < iend[d] in each direction d
+    //! (used to advance the interior of the patches while the currents are being exchanged)
+    virtual void solveInBox( ElectroMagn *fields, unsigned int istart[3], unsigned int iend[3] )
+    {
+        ERROR( "This Maxwell solver cannot be applied on a part of the patch" );
+    };
+    
 protected:
 
 };//END class
@@ -9,6 +9,7 @@
 #include "MF_Solver1D_Yee.h"
 #include "MF_Solver2D_Yee.h"
 #include "MF_Solver3D_Yee.h"
+#include "Fused_Solver3D_Yee.h"
 #include "MF_SolverAM_Yee.h"
 #include "MF_Solver2D_Grassi.h"
 #include "MF_Solver2D_GrassiSpL.h"
@@ -55,7 +56,12 @@ public:
                 if( params.is_spectral ) {
                     WARNING( "PS solveur are not available without Picsar" );
                 }
-                solver = new MA_Solver3D_norm( params );
+                if( params.fused_maxwell_solver ) {
+                    // Maxwell-Ampere is done by the fused Maxwell-Faraday solver
+                    solver = new NullSolver( params );
+                } else {
+                    solver = new MA_Solver3D_norm( params );
+                }
             } else if( ( params.is_pxr == true ) && ( params.is_spectral == false ) ) {
                 solver = new PXR_Solver3D_FDTD( params );
             } else if( ( params.is_pxr == true ) && ( params.is_spectral == true ) ) {
@@ -105,7 +111,11 @@ public:
         } else if( params.geometry == "3Dcartesian" ) {
             if( params.is_pxr == false ) {
                 if( params.maxwell_sol == "Yee" ) {
-                    solver = new MF_Solver3D_Yee( params );
+                    if( params.fused_maxwell_solver ) {
+                        solver = new Fused_Solver3D_Yee( params );
+                    } else {
+                        solver = new MF_Solver3D_Yee( params );
+                    }
                 } else if( params.maxwell_sol == "Lehe" ) {
                     solver = new MF_Solver3D_Lehe( params );
                 }
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 #include <cstring>
+#include <cstdlib>
 
 #include "Params.h"
 #include "SmileiMPI.h"
@@ -21,12 +22,16 @@ using namespace std;
 Field3D::Field3D() : Field()
 {
     data_=NULL;
+    stride_x_=0;
+    stride_y_=0;
 }
 
 // with the dimensions as input argument
 Field3D::Field3D( vector<unsigned int> dims ) : Field( dims )
 {
     data_=NULL;
+    stride_x_=0;
+    stride_y_=0;
     allocateDims( dims );
 }
 
@@ -34,6 +39,8 @@ Field3D::Field3D( vector<unsigned int> dims ) : Field( dims )
 Field3D::Field3D( vector<unsigned int> dims, string name_in ) : Field( dims, name_in )
 {
     data_=NULL;
+    stride_x_=0;
+    stride_y_=0;
     allocateDims( dims );
 }
 
@@ -41,6 +48,8 @@ Field3D::Field3D( vector<unsigned int> dims, string name_in ) : Field( dims, nam
 Field3D::Field3D( vector<unsigned int> dims, unsigned int mainDim, bool isPrimal ) : Field( dims, mainDim, isPrimal )
 {
     data_=NULL;
+    stride_x_=0;
+    stride_y_=0;
     allocateDims( dims, mainDim, isPrimal );
 }
 
@@ -48,6 +57,8 @@ Field3D::Field3D( vector<unsigned int> dims, unsigned int mainDim, bool isPrimal
 Field3D::Field3D( vector<unsigned int> dims, unsigned int mainDim, bool isPrimal, string name_in ) : Field( dims, mainDim, isPrimal, name_in )
 {
     data_=NULL;
+    stride_x_=0;
+    stride_y_=0;
     allocateDims( dims, mainDim, isPrimal );
 }
 
@@ -56,6 +67,8 @@ Field3D::Field3D( vector<unsigned int> dims, unsigned int mainDim, bool isPrimal
 Field3D::Field3D( string name_in, vector<unsigned int> dims ) : Field( dims, name_in )
 {
     data_=NULL;
+    stride_x_=0;
+    stride_y_=0;
     dims_=dims;
 }
 
@@ -66,15 +79,34 @@ Field3D::Field3D( string name_in, vector<unsigned int> dims ) : Field( dims, nam
 Field3D::~Field3D()
 {
     if( data_!=NULL ) {
-        delete [] data_;
-        for( unsigned int i=0; i<dims_[0]; i++ ) {
-            delete [] this->data_3D[i];
-        }
-        delete [] this->data_3D;
+        free( data_ );
     }
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Allocation of the data in a single contiguous array, aligned for vectorized loops along z
+// ---------------------------------------------------------------------------------------------------------------------
+void Field3D::allocateData()
+{
+    if( data_ ) {
+        free( data_ );
+        data_ = NULL;
+    }
+    
+    stride_y_ = dims_[2];
+    stride_x_ = dims_[1]*dims_[2];
+    globalDims_ = dims_[0]*dims_[1]*dims_[2];
+    
+    void *ptr;
+    if( posix_memalign( &ptr, 64, max( globalDims_, 1u )*sizeof( double ) ) != 0 ) {
+        ERROR( "Could not allocate field " << name << " of size " << globalDims_ );
+    }
+    data_ = static_cast<double *>( ptr );
+    memset( data_, 0, globalDims_*sizeof( double ) );
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Method used for allocating the dimension of a Field3D
 // ---------------------------------------------------------------------------------------------------------------------
@@ -83,39 +115,16 @@ void Field3D::allocateDims()
     if( dims_.size()!=3 ) {
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
-    if( data_ ) {
-        delete [] data_;
-    }
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
-    //! \todo{check row major order!!!}
-    data_3D= new double **[dims_[0]];
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_3D[i]= new double*[dims_[1]];
-        for( unsigned int j=0; j<dims_[1]; j++ ) {
-            data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
-            for( unsigned int k=0; k<dims_[2]; k++ ) {
-                this->data_3D[i][j][k] = 0.0;
-            }
-        }
-    }//i
-    
-    globalDims_ = dims_[0]*dims_[1]*dims_[2];
-    
+    allocateData();
 }
 
 void Field3D::deallocateDims()
 {
-    delete [] data_;
+    free( data_ );
     data_ = NULL;
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        delete [] data_3D[i];
-    }
-    delete [] data_3D;
-    data_3D = NULL;
-    
 }
 
 
@@ -137,9 +146,6 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
     if( dims_.size()!=3 ) {
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
-    if( data_ ) {
-        delete [] data_;
-    }
     
     // isPrimal define if mainDim is Primal or Dual
     isDual_.resize( dims_.size(), 0 );
@@ -155,22 +161,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
-    //! \todo{check row major order!!!}
-    data_3D= new double **[dims_[0]*dims_[1]];
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_3D[i]= new double*[dims_[1]];
-        for( unsigned int j=0; j<dims_[1]; j++ ) {
-            this->data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
-            for( unsigned int k=0; k<dims_[2]; k++ ) {
-                this->data_3D[i][j][k] = 0.0;
-            }
-        }
-    }//i
-    
-    globalDims_ = dims_[0]*dims_[1]*dims_[2];
-    
-    //isDual_ = isPrimal;
+    allocateData();
 }
 
 
@@ -180,8 +171,8 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
 // ---------------------------------------------------------------------------------------------------------------------
 void Field3D::shift_x( unsigned int delta )
 {
-    memmove( &( data_3D[0][0][0] ), &( data_3D[delta][0][0] ), ( dims_[2]*dims_[1]*dims_[0]-delta*dims_[2]*dims_[1] )*sizeof( double ) );
-    memset( &( data_3D[dims_[0]-delta][0][0] ), 0, delta*dims_[1]*dims_[2]*sizeof( double ) );
+    memmove( &( data_[0] ), &( data_[delta*stride_x_] ), ( globalDims_-delta*stride_x_ )*sizeof( double ) );
+    memset( &( data_[( dims_[0]-delta )*stride_x_] ), 0, delta*stride_x_*sizeof( double ) );
     
 }
 
@@ -198,8 +189,10 @@ double Field3D::norm2( unsigned int istart[3][2], unsigned int bufsize[3][2] )
     
     for( int i=idxlocalstart[0] ; i<idxlocalend[0] ; i++ ) {
         for( int j=idxlocalstart[1] ; j<idxlocalend[1] ; j++ ) {
+            double *row = &( data_[i*stride_x_ + j*stride_y_] );
+            #pragma omp simd reduction(+:nrj)
             for( int k=idxlocalstart[2] ; k<idxlocalend[2] ; k++ ) {
-                nrj += data_3D[i][j][k]*data_3D[i][j][k];
+                nrj += row[k]*row[k];
             }
         }
     }
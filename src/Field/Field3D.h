@@ -58,33 +58,38 @@ public:
     
     virtual void shift_x( unsigned int delta ) override;
     
+    //! Index of the (i,j,k) element in the contiguous array data_ (k is the contiguous direction)
+    inline unsigned int index( unsigned int i, unsigned int j, unsigned int k ) const
+    {
+        return i*stride_x_ + j*stride_y_ + k;
+    };
+    
+    //! Distance in data_ between (i,j,k) and (i+1,j,k)
+    inline unsigned int stride_x() const
+    {
+        return stride_x_;
+    };
+    
+    //! Distance in data_ between (i,j,k) and (i,j+1,k)
+    inline unsigned int stride_y() const
+    {
+        return stride_y_;
+    };
+    
     //! Overloading of the () operator allowing to set a new value for the (i,j,k) element of a Field3D
     inline double &operator()( unsigned int i, unsigned int j, unsigned int k )
     {
         DEBUGEXEC( if( i>=dims_[0] || j>=dims_[1] || k >= dims_[2] ) ERROR( name << "Out of limits & "<< i << " " << j << " " << k ) );
-        return data_3D[i][j][k];
+        return data_[i*stride_x_ + j*stride_y_ + k];
     };
     
-    /*inline double& operator () (unsigned int i)
-    {
-        DEBUGEXEC(if (i>=dims_[0]*dims_[1]*dims_[2]) ERROR("Out of limits & "<< i));
-        DEBUGEXEC(if (!std::isfinite(data_3D[i])) ERROR("Not finite "<< i));
-        return data_3D[i];
-    };*/
-    
     //! Overloading of the () operator allowing to get the value for the (i,j,k) element of a Field3D
     inline double operator()( unsigned int i, unsigned int j, unsigned int k ) const
     {
         DEBUGEXEC( if( i>=dims_[0] || j>=dims_[1] || k >= dims_[2] ) ERROR( name << "Out of limits "<< i << " " << j << " " << k ) );
-        return data_3D[i][j][k];
+        return data_[i*stride_x_ + j*stride_y_ + k];
     };
     
-    /*inline double operator () (unsigned int i) const {
-        DEBUGEXEC(if (i>=dims_[0]*dims_[1]*dims_[2]) ERROR("Out of limits & "<< i));
-        DEBUGEXEC(if (!std::isfinite(data_3D[i])) ERROR("Not finite "<< i));
-        return data_3D[i];
-    };*/
-    
     void extract_slice_yz( unsigned int ix, Field2D *field );
     void extract_slice_xz( unsigned int iy, Field2D *field );
     void extract_slice_xy( unsigned int iz, Field2D *field );
@@ -94,10 +99,13 @@ public:
     void put( Field *outField, Params &params, SmileiMPI *smpi, Patch *thisPatch, Patch *outPatch ) override;
     void get( Field  *inField, Params &params, SmileiMPI *smpi, Patch   *inPatch, Patch *thisPatch ) override;
     
-    //!\todo{Comment what are these stuffs (MG for JD)}
-    //double *data_3D;
-    //! this will present the data as a 3d matrix
-    double ***data_3D;
+private:
+    //! Allocates data_ as a single contiguous array aligned on 64 bytes, initialized to 0
+    void allocateData();
+    
+    //! Strides of the x and y directions in data_ (the z direction is contiguous)
+    unsigned int stride_x_;
+    unsigned int stride_y_;
     
 };
 
@@ -24,6 +24,15 @@ public:
     virtual void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) = 0;
     virtual void oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc ) =0;
     
+    //! Number of nodes along each dimension of the interpolation stencil (0 if the interpolator does not provide stencils)
+    virtual unsigned int stencilSize()
+    {
+        return 0;
+    };
+    //! Interpolation stencil of one particle: for each dimension, first primal/dual node in index[2*idim+isDual]
+    //! and the corresponding coefficients in coeff[(2*idim+isDual)*stencilSize()+inode]
+    virtual void stencil( Particles &particles, int ipart, int *index, double *coeff ) {};
+    
     virtual void fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 )
     {
         ERROR( "Envelope not implemented with this geometry and this order" );
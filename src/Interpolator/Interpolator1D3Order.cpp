@@ -113,6 +113,20 @@ void Interpolator1D3Order::oneField( Field *field, Particles &particles, int *is
     }
 }
 
+// Stencil of one position, stored once by the probes and re-used at each output
+void Interpolator1D3Order::stencil( Particles &particles, int ipart, int *index, double *coeff )
+{
+    double xjn = particles.position( 0, ipart )*dx_inv_;
+    coeffs( xjn );
+    
+    index[0] = ip_-1;
+    index[1] = id_-1;
+    for( int inode=0 ; inode<4 ; inode++ ) {
+        coeff[inode]   = coeffp_[inode];
+        coeff[4+inode] = coeffd_[inode];
+    }
+}
+
 void Interpolator1D3Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
@@ -21,6 +21,11 @@ public:
     void fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
     void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
     void oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc ) override final;
+    unsigned int stencilSize() override final
+    {
+        return 5;
+    };
+    void stencil( Particles &particles, int ipart, int *index, double *coeff ) override final;
     
     inline double compute( double *coeff, Field1D *f, int idx )
     {
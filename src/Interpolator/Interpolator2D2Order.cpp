@@ -124,6 +124,25 @@ void Interpolator2D2Order::oneField( Field *field, Particles &particles, int *is
     }
 }
 
+// Stencil of one position, stored once by the probes and re-used at each output
+void Interpolator2D2Order::stencil( Particles &particles, int ipart, int *index, double *coeff )
+{
+    double xpn = particles.position( 0, ipart )*dx_inv_;
+    double ypn = particles.position( 1, ipart )*dy_inv_;
+    coeffs( xpn, ypn );
+    
+    index[0] = ip_-1;
+    index[1] = id_-1;
+    index[2] = jp_-1;
+    index[3] = jd_-1;
+    for( int inode=0 ; inode<3 ; inode++ ) {
+        coeff[inode]    = coeffxp_[inode];
+        coeff[3+inode]  = coeffxd_[inode];
+        coeff[6+inode] = coeffyp_[inode];
+        coeff[9+inode] = coeffyd_[inode];
+    }
+}
+
 void Interpolator2D2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
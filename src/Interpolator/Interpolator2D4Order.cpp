@@ -138,6 +138,25 @@ void Interpolator2D4Order::oneField( Field *field, Particles &particles, int *is
         FieldLoc[ipart] = compute( coeffx, coeffy, F, *i, *j );
     }
 }
+
+// Stencil of one position, stored once by the probes and re-used at each output
+void Interpolator2D4Order::stencil( Particles &particles, int ipart, int *index, double *coeff )
+{
+    double xpn = particles.position( 0, ipart )*dx_inv_;
+    double ypn = particles.position( 1, ipart )*dy_inv_;
+    coeffs( xpn, ypn );
+    
+    index[0] = ip_-2;
+    index[1] = id_-2;
+    index[2] = jp_-2;
+    index[3] = jd_-2;
+    for( int inode=0 ; inode<5 ; inode++ ) {
+        coeff[inode]    = coeffxp_[inode];
+        coeff[5+inode]  = coeffxd_[inode];
+        coeff[10+inode] = coeffyp_[inode];
+        coeff[15+inode] = coeffyd_[inode];
+    }
+}
 void Interpolator2D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
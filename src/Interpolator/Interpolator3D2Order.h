@@ -21,15 +21,25 @@ public:
     void fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final ;
     void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
     void oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc ) override final;
+    unsigned int stencilSize() override final
+    {
+        return 3;
+    };
+    void stencil( Particles &particles, int ipart, int *index, double *coeff ) override final;
     
     inline double compute( double *coeffx, double *coeffy, double *coeffz, Field3D *f, int idx, int idy, int idz )
     {
         double interp_res( 0. );
-        //unroll ?
+        // the stencil is read through the flat array of the field
+        const double *data = &( f->data_[f->index( idx, idy, idz )] );
+        const int stride_x = f->stride_x();
+        const int stride_y = f->stride_y();
         for( int iloc=-1 ; iloc<2 ; iloc++ ) {
             for( int jloc=-1 ; jloc<2 ; jloc++ ) {
+                const double *row = data + iloc*stride_x + jloc*stride_y;
+                double coeffxy = *( coeffx+iloc ) * *( coeffy+jloc );
                 for( int kloc=-1 ; kloc<2 ; kloc++ ) {
-                    interp_res += *( coeffx+iloc ) * *( coeffy+jloc ) * *( coeffz+kloc ) * ( *f )( idx+iloc, idy+jloc, idz+kloc );
+                    interp_res += coeffxy * *( coeffz+kloc ) * row[kloc];
                 }
             }
         }
@@ -143,6 +143,30 @@ void Interpolator3D4Order::oneField( Field *field, Particles &particles, int *is
     }
 }
 
+// Stencil of one position, stored once by the probes and re-used at each output
+void Interpolator3D4Order::stencil( Particles &particles, int ipart, int *index, double *coeff )
+{
+    double xpn = particles.position( 0, ipart )*dx_inv_;
+    double ypn = particles.position( 1, ipart )*dy_inv_;
+    double zpn = particles.position( 2, ipart )*dz_inv_;
+    coeffs( xpn, ypn, zpn );
+    
+    index[0] = ip_-2;
+    index[1] = id_-2;
+    index[2] = jp_-2;
+    index[3] = jd_-2;
+    index[4] = kp_-2;
+    index[5] = kd_-2;
+    for( int inode=0 ; inode<5 ; inode++ ) {
+        coeff[inode]    = coeffxp_[inode];
+        coeff[5+inode]  = coeffxd_[inode];
+        coeff[10+inode] = coeffyp_[inode];
+        coeff[15+inode] = coeffyd_[inode];
+        coeff[20+inode] = coeffzp_[inode];
+        coeff[25+inode] = coeffzd_[inode];
+    }
+}
+
 void Interpolator3D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
 {
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
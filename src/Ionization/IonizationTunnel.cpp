@@ -42,6 +42,9 @@ IonizationTunnel::IonizationTunnel( Params &params, Species *species ) : Ionizat
         gamma_tunnel[Z] = 2.0 * pow( 2.0*Potential[Z], 1.5 );
     }
     
+    IonizRate_tunnel.resize( atomic_number_ );
+    Dnom_tunnel.resize( atomic_number_ );
+    
     DEBUG( "Finished Creating the Tunnel Ionizaton class" );
     
 }
@@ -52,43 +55,67 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
 {
 
     unsigned int Z, Zp1, newZ, k_times;
-    double TotalIonizPot, E, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
-    vector<double> IonizRate_tunnel( atomic_number_ ), Dnom_tunnel( atomic_number_ );
+    double TotalIonizPot, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
     LocalFields Jion;
     double factorJion_0 = au_to_mec2 * EC_to_au*EC_to_au * invdt;
     
+    if( ipart_max <= ipart_min ) {
+        return;
+    }
+    unsigned int nions = ipart_max - ipart_min;
+    
     int nparts = Epart->size()/3;
-    double *Ex = &( ( *Epart )[0*nparts] );
-    double *Ey = &( ( *Epart )[1*nparts] );
-    double *Ez = &( ( *Epart )[2*nparts] );
+    double *Ex = &( ( *Epart )[0*nparts] ) + ipart_min - ipart_ref;
+    double *Ey = &( ( *Epart )[1*nparts] ) + ipart_min - ipart_ref;
+    double *Ez = &( ( *Epart )[2*nparts] ) + ipart_min - ipart_ref;
+    short *charge = &( particles->charge( ipart_min ) );
     
-    for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
+    if( invE_buffer.size() < nions ) {
+        invE_buffer .resize( nions );
+        rate_buffer .resize( nions );
+        ionized_ions .resize( nions );
+        ionized_times.resize( nions );
+    }
+    double *inv_field = &invE_buffer[0];
+    double *rate = &rate_buffer[0];
+    const double *alpha = &alpha_tunnel[0];
+    const double *beta  = &beta_tunnel[0];
+    const double *gamma = &gamma_tunnel[0];
     
-        // Current charge state of the ion
-        Z = ( unsigned int )( particles->charge( ipart ) );
-        
-        // If ion already fully ionized then skip
-        if( Z==atomic_number_ ) {
+    // First pass (vectorized): field and ionization rate from the current charge state.
+    // Fully ionized ions and ions in a negligible field are flagged by a zero inverse field.
+    #pragma omp simd
+    for( unsigned int i=0 ; i<nions; i++ ) {
+        double E = EC_to_au * sqrt( Ex[i]*Ex[i] + Ey[i]*Ey[i] + Ez[i]*Ez[i] );
+        bool can_ionize = ( ( unsigned int ) charge[i] < atomic_number_ ) && ( E >= 1e-10 );
+        unsigned int Zi = can_ionize ? ( unsigned int ) charge[i] : 0;
+        double inv = can_ionize ? 1./E : 1.;
+        double d = gamma[Zi]*inv;
+        rate[i] = beta[Zi] * exp( -d*one_third + alpha[Zi]*log( d ) );
+        inv_field[i] = can_ionize ? inv : 0.;
+    }
+    
+    // Second pass: Monte-Carlo (random numbers are drawn in the order of the ions)
+    unsigned int nionized = 0;
+    for( unsigned int i=0 ; i<nions; i++ ) {
+    
+        if( inv_field[i] == 0. ) {
             continue;
         }
         
-        // Absolute value of the electric field normalized in atomic units
-        E = EC_to_au * sqrt( pow( *( Ex+ipart-ipart_ref ), 2 )
-                             +pow( *( Ey+ipart-ipart_ref ), 2 )
-                             +pow( *( Ez+ipart-ipart_ref ), 2 ) );
-        if( E<1e-10 ) {
-            continue;
-        }
+        unsigned int ipart = ipart_min + i;
+        
+        // Current charge state of the ion
+        Z = ( unsigned int ) charge[i];
         
         // --------------------------------
         // Start of the Monte-Carlo routine
         // --------------------------------
         
-        invE = 1./E;
+        invE = inv_field[i];
         factorJion = factorJion_0 * invE*invE;
-        delta      = gamma_tunnel[Z]*invE;
-        ran_p = patch->xorshift32() * patch->xorshift32_invmax;
-        IonizRate_tunnel[Z] = beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log( delta ) );
+        ran_p = patch->rand_->uniform();
+        IonizRate_tunnel[Z] = rate[i];
         
         // Total ionization potential (used to compute the ionization current)
         TotalIonizPot = 0.0;
@@ -124,12 +151,12 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
                 D_sum = 0.0;
                 P_sum = 0.0;
                 Mult  *= IonizRate_tunnel[Z+k_times];
-                for( unsigned int i=0; i<k_times+1; i++ ) {
-                    Dnom_tunnel[i]=Dnom_tunnel[i]/( IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+i] );
-                    D_sum += Dnom_tunnel[i];
-                    P_sum += exp( -IonizRate_tunnel[Z+i]*dt )*Dnom_tunnel[i];
+                for( unsigned int j=0; j<k_times+1; j++ ) {
+                    Dnom_tunnel[j]=Dnom_tunnel[j]/( IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+j] );
+                    D_sum += Dnom_tunnel[j];
+                    P_sum += exp( -IonizRate_tunnel[Z+j]*dt )*Dnom_tunnel[j];
                 }
-                Dnom_tunnel[k_times+1] -= D_sum;
+                Dnom_tunnel[k_times+1]  = -D_sum;
                 P_sum                   = P_sum + Dnom_tunnel[k_times+1]*exp( -IonizRate_tunnel[newZ]*dt );
                 Pint_tunnel             = Pint_tunnel + P_sum*Mult;
                 
@@ -147,33 +174,59 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
         // Compute ionization current
         if (patch->EMfields->Jx_ != NULL){  // For the moment ionization current is not accounted for in AM geometry
             factorJion *= TotalIonizPot;
-            Jion.x = factorJion * *( Ex+ipart );
-            Jion.y = factorJion * *( Ey+ipart );
-            Jion.z = factorJion * *( Ez+ipart );
+            Jion.x = factorJion * Ex[i];
+            Jion.y = factorJion * Ey[i];
+            Jion.z = factorJion * Ez[i];
             
             Proj->ionizationCurrents( patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion );
         }
         
-        // Creation of the new electrons
-        // (variable weights are used)
-        // -----------------------------
+        // Remember the ion for the creation of the electrons
         if( k_times !=0 ) {
-            new_electrons.create_particle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
-                new_electrons.position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-            new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons.charge( idNew )=-1;
-            
-            // Increase the charge of the particle
-            particles->charge( ipart ) += k_times;
+            ionized_ions [nionized] = ipart;
+            ionized_times[nionized] = k_times;
+            nionized++;
         }
         
-        
     } // Loop on particles
+    
+    if( nionized == 0 ) {
+        return;
+    }
+    
+    // Creation of the new electrons, all at once
+    // (variable weights are used)
+    // -----------------------------
+    unsigned int idNew = new_electrons.size();
+    new_electrons.create_particles( nionized );
+    
+    const unsigned int *ions  = &ionized_ions [0];
+    const unsigned int *times = &ionized_times[0];
+    for( unsigned int idim=0; idim<new_electrons.dimension(); idim++ ) {
+        double *new_position = &( new_electrons.position( idim, idNew ) );
+        const double *position = &( particles->position( idim, 0 ) );
+        #pragma omp simd
+        for( unsigned int i=0; i<nionized; i++ ) {
+            new_position[i] = position[ions[i]];
+        }
+    }
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        double *new_momentum = &( new_electrons.momentum( idim, idNew ) );
+        const double *momentum = &( particles->momentum( idim, 0 ) );
+        #pragma omp simd
+        for( unsigned int i=0; i<nionized; i++ ) {
+            new_momentum[i] = momentum[ions[i]]*ionized_species_invmass;
+        }
+    }
+    double *new_weight = &( new_electrons.weight( idNew ) );
+    short *new_charge = &( new_electrons.charge( idNew ) );
+    const double *weight = &( particles->weight( 0 ) );
+    short *ion_charge = &( particles->charge( 0 ) );
+    #pragma omp simd
+    for( unsigned int i=0; i<nionized; i++ ) {
+        new_weight[i] = double( times[i] )*weight[ions[i]];
+        new_charge[i] = -1;
+        // Increase the charge of the ion
+        ion_charge[ions[i]] += times[i];
+    }
 }
@@ -28,6 +28,16 @@ private:
     
     double one_third;
     std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel;
+    
+    //! Rates and denominators of the multiple ionization
+    std::vector<double> IonizRate_tunnel, Dnom_tunnel;
+    
+    //! Per-ion buffers of a bin: inverse field (0 if the ion cannot be ionized)
+    //! and ionization rate from the current charge state
+    std::vector<double> invE_buffer, rate_buffer;
+    
+    //! Ionized ions of a bin and their number of ionization events
+    std::vector<unsigned int> ionized_ions, ionized_times;
 };
 
 
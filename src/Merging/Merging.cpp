@@ -10,6 +10,11 @@
 
 #include "Merging.h"
 
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // -----------------------------------------------------------------------------
 //! Constructor for Merging
 // input: simulation parameters & Species index
@@ -27,3 +32,60 @@ Merging::Merging( Params &params, Species *species )
 Merging::~Merging()
 {
 }
+
+// -----------------------------------------------------------------------------
+//! Scratch buffers of the calling thread.
+//! Species are merged by one thread at a time, so that the buffers
+//! can be shared by all species and patches handled by this thread.
+// -----------------------------------------------------------------------------
+Merging::MergingBuffers &Merging::threadBuffers()
+{
+#ifdef _OPENMP
+    static std::vector<MergingBuffers> buffers( omp_get_max_threads() );
+    return buffers[omp_get_thread_num()];
+#else
+    static MergingBuffers buffers;
+    return buffers;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//! Counting sort of the particles in the momentum cells
+//! \param buffers scratch buffers where `momentum_cell_index` is already computed
+//! \param number_of_particles number of particles in the cell
+//! \param momentum_cells total number of momentum cells
+//! \param istart index of the first particle
+// -----------------------------------------------------------------------------
+void Merging::sortInMomentumCells(
+    MergingBuffers &buffers,
+    unsigned int number_of_particles,
+    unsigned int momentum_cells,
+    int istart )
+{
+    const unsigned int *__restrict__ momentum_cell_index = buffers.momentum_cell_index.data();
+    unsigned int *__restrict__ sorted_particles = buffers.sorted_particles.data();
+    unsigned int *__restrict__ particles_per_momentum_cells = scratch( buffers.particles_per_momentum_cells, momentum_cells );
+    unsigned int *__restrict__ momentum_cell_particle_index = scratch( buffers.momentum_cell_particle_index, momentum_cells );
+    
+    std::fill( particles_per_momentum_cells, particles_per_momentum_cells + momentum_cells, 0 );
+    
+    // Number of particles per momentum cell
+    for( unsigned int ipr=0; ipr<number_of_particles; ipr++ ) {
+        particles_per_momentum_cells[momentum_cell_index[ipr]] += 1;
+    }
+    
+    // First index of each momentum cell in the sorted array
+    unsigned int first = 0;
+    for( unsigned int ic=0; ic<momentum_cells; ic++ ) {
+        momentum_cell_particle_index[ic] = first;
+        first += particles_per_momentum_cells[ic];
+        particles_per_momentum_cells[ic] = 0;
+    }
+    
+    // Place the particles, the counters are rebuilt on the way
+    for( unsigned int ipr=0; ipr<number_of_particles; ipr++ ) {
+        unsigned int ic = momentum_cell_index[ipr];
+        sorted_particles[momentum_cell_particle_index[ic] + particles_per_momentum_cells[ic]] = istart + ipr;
+        particles_per_momentum_cells[ic] += 1;
+    }
+}
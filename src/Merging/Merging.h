@@ -14,6 +14,9 @@
 #include "Params.h"
 #include "Particles.h"
 #include "Species.h"
+#include "Random.h"
+
+#include <vector>
 
 //  ----------------------------------------------------------------------------
 //! Class Merging
@@ -31,6 +34,7 @@ public:
     //! \param particles   particle object containing the particle
     //!                    properties of the current species
     //! \param smpi        MPI properties
+    //! \param rand_gen    Random number generator of the patch
     //! \param istart      Index of the first particle
     //! \param iend        Index of the last particle
     virtual void operator()(
@@ -38,6 +42,7 @@ public:
         Particles &particles,
         std::vector <int> &mask,
         SmileiMPI *smpi,
+        Random *rand_gen,
         int istart,
         int iend,
         int & count) = 0;
@@ -48,6 +53,54 @@ public:
     unsigned int min_particles_per_cell;
 
 protected:
+
+    //! Scratch arrays of the merging. They are kept from one call to the
+    //! next, so that merging a cell does not allocate memory.
+    struct MergingBuffers {
+        // Per particle
+        std::vector<double> gamma;
+        std::vector<double> particles_theta;
+        std::vector<double> particles_phi;
+        std::vector<unsigned int> momentum_cell_index;
+        std::vector<unsigned int> sorted_particles;
+        // Per momentum cell
+        std::vector<unsigned int> particles_per_momentum_cells;
+        std::vector<unsigned int> momentum_cell_particle_index;
+        // Per direction of the momentum cells
+        std::vector<double> cell_vec_x;
+        std::vector<double> cell_vec_y;
+        std::vector<double> cell_vec_z;
+        // Per phi of the spherical discretization
+        std::vector<unsigned int> theta_dim;
+        std::vector<unsigned int> theta_start_index;
+        std::vector<double> theta_min;
+        std::vector<double> theta_max;
+        std::vector<double> theta_delta;
+        std::vector<double> inv_theta_delta;
+    };
+
+    //! Buffers of the calling thread, shared by all merging operators
+    static MergingBuffers &threadBuffers();
+
+    //! First `size` elements of a buffer, which only grows when needed
+    template<typename T>
+    static inline T *scratch( std::vector<T> &buffer, unsigned int size )
+    {
+        if( buffer.size() < size ) {
+            buffer.resize( size );
+        }
+        return buffer.data();
+    }
+
+    //! Counting sort of the particles according to `momentum_cell_index`.
+    //! Fills `particles_per_momentum_cells`, `momentum_cell_particle_index`
+    //! and `sorted_particles` (which contains particle indices starting at `istart`)
+    static void sortInMomentumCells(
+        MergingBuffers &buffers,
+        unsigned int number_of_particles,
+        unsigned int momentum_cells,
+        int istart );
+
 private:
 };
 
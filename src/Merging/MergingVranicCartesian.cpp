@@ -70,6 +70,7 @@ void MergingVranicCartesian::operator() (
         Particles &particles,
         std::vector <int> &mask,
         SmileiMPI* smpi,
+        Random *rand_gen,
         int istart,
         int iend,
         int & count)
@@ -154,17 +155,17 @@ void MergingVranicCartesian::operator() (
         // Cell keys shortcut
         // int *cell_keys = &( particles.cell_keys[0] );
 
-        // Local vector to store the momentum index in the momentum discretization
-        std::vector <unsigned int> momentum_cell_index(number_of_particles,0);
-//         unsigned int  * momentum_cell_index = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        // Scratch buffers of this thread
+        MergingBuffers &buffers = threadBuffers();
+
+        // Local array to store the momentum index in the momentum discretization
+        unsigned int *__restrict__ momentum_cell_index = scratch( buffers.momentum_cell_index, number_of_particles );
 
         // Sorted array of particle index
-        std::vector <unsigned int> sorted_particles(number_of_particles,0);
-//         unsigned int  * sorted_particles = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        unsigned int *__restrict__ sorted_particles = scratch( buffers.sorted_particles, number_of_particles );
 
         // Particle gamma factor
-        std::vector <double> gamma(number_of_particles,0);
-//         double  * gamma = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
+        double *__restrict__ gamma = scratch( buffers.gamma, number_of_particles );
 
         // Computation of the particle gamma factor
         if (mass == 0) {
@@ -262,7 +263,7 @@ void MergingVranicCartesian::operator() (
                     momentum_max[ip] += (momentum_max[ip] - momentum_min[ip])*0.01;
                     if (accumulation_correction_) {
                         momentum_delta[ip] = (momentum_max[ip] - momentum_min[ip]) / (dim[ip]-1);
-                        momentum_min[ip] -= 0.99*momentum_delta[ip]*Rand::uniform();
+                        momentum_min[ip] -= 0.99*momentum_delta[ip]*rand_gen->uniform();
                     } else {
                         momentum_delta[ip] = (momentum_max[ip] - momentum_min[ip]) / (dim[ip]);
                     }
@@ -271,7 +272,7 @@ void MergingVranicCartesian::operator() (
                 // The 0 value is at the boundary between 2 cells
                 } else {
                     if (accumulation_correction_) {
-                        dim[ip] = int(dim[ip]*(1+Rand::uniform()));
+                        dim[ip] = int(dim[ip]*(1+rand_gen->uniform()));
                     }
                     momentum_delta[ip] = fabs(momentum_max[ip] - momentum_min[ip]) / dim[ip];
                     inv_momentum_delta[ip] = 1.0/momentum_delta[ip];
@@ -306,11 +307,11 @@ void MergingVranicCartesian::operator() (
         //     } else if (momentum_max[1] <= 0 || momentum_min[1] >= 0) {
         //         momentum_max[1] += (momentum_max[1] - momentum_min[1])*0.01;
         //         momentum_delta[1] = (momentum_max[1] - momentum_min[1]) / (dim[1]-1);
-        //         momentum_min[1] -= 0.99*momentum_delta[1]*Rand::uniform();
+        //         momentum_min[1] -= 0.99*momentum_delta[1]*rand_gen->uniform();
         //         inv_momentum_delta[1] = 1.0/momentum_delta[1];
         //     // else, discretization centerd in 0
         //     } else {
-        //         dim[1] = int(dim[1]*(1+Rand::uniform()));
+        //         dim[1] = int(dim[1]*(1+rand_gen->uniform()));
         //         momentum_delta[1] = fabs(momentum_max[1] - momentum_min[1]) / dim[1];
         //         inv_momentum_delta[1] = 1.0/momentum_delta[1];
         //         nb_delta = ceil(fabs(momentum_min[1]) * inv_momentum_delta[1]);
@@ -351,38 +352,22 @@ void MergingVranicCartesian::operator() (
                                     * dim[1]
                                     * dim[2];
 
-        // Array containing the number of particles per momentum cells
-        std::vector <unsigned int> particles_per_momentum_cells(momentum_cells,0);
-//         unsigned int  * particles_per_momentum_cells = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-
-        // Array containing the first particle index of each momentum cell
-        // in the sorted particle array
-        std::vector <unsigned int> momentum_cell_particle_index(momentum_cells,0);
-//         unsigned int  * momentum_cell_particle_index = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-// 
-//         // Initialization when using aligned_alloc
-//         for (ic = 0 ; ic < momentum_cells ; ic++) {
-//             momentum_cell_particle_index[ic] = 0;
-//             particles_per_momentum_cells[ic] = 0;
-//         }
-
         // std::cerr << "Cell index" << std::endl;
 
         // For each particle, momentum cell indexes are computed in the
         // requested discretization.
         // This loop can be efficiently vectorized
         #pragma omp simd \
-        private(ipr,mx_i,my_i,mz_i)     
-//         aligned(momentum_cell_index: 64)
+        private(ipr,mx_i,my_i,mz_i)
         for (ip=(unsigned int) (istart) ; ip < (unsigned int) (iend); ip++ ) {
 
             // Relative particle array index
             ipr = ip - istart;
 
             // 3d indexes in the momentum discretization
-            mx_i = (unsigned int) floor( (momentum[0][ip] - momentum_min[0]) * inv_momentum_delta[0]);
-            my_i = (unsigned int) floor( (momentum[1][ip] - momentum_min[1]) * inv_momentum_delta[1]);
-            mz_i = (unsigned int) floor( (momentum[2][ip] - momentum_min[2]) * inv_momentum_delta[2]);
+            mx_i = (int) floor( (momentum[0][ip] - momentum_min[0]) * inv_momentum_delta[0]);
+            my_i = (int) floor( (momentum[1][ip] - momentum_min[1]) * inv_momentum_delta[1]);
+            mz_i = (int) floor( (momentum[2][ip] - momentum_min[2]) * inv_momentum_delta[2]);
 
             // 1D Index in the momentum discretization
             momentum_cell_index[ipr] = mz_i * dim[0]*dim[1]
@@ -402,46 +387,15 @@ void MergingVranicCartesian::operator() (
 
         }
 
-        // std::cerr << "number of particles per momentum cells" << std::endl;
-
-        // The number of particles per momentum cells
-        // is then determined.
-        // No vectorization because of random memory accesses
-        for (ipr=0; ipr<number_of_particles; ipr++ ) {
-            // Number of particles per momentum cells
-            particles_per_momentum_cells[momentum_cell_index[ipr]] += 1;
-        }
-
-        // std::cerr << "Computation of the cell index" << std::endl;
-
-        // Computation of the cell index in the sorted array of particles
-        for (ic = 1 ; ic < momentum_cells ; ic++) {
-            momentum_cell_particle_index[ic]  = momentum_cell_particle_index[ic-1] + particles_per_momentum_cells[ic-1];
-            particles_per_momentum_cells[ic-1] = 0;
-        }
-        particles_per_momentum_cells[momentum_cells-1] = 0;
+        // Particles are sorted in the momentum cells
+        sortInMomentumCells( buffers, number_of_particles, momentum_cells, istart );
 
-        // std::cerr << "sort particles in correct bins" << std::endl;
-
-        // sort particles in correct bins according to their
-        // momentum properties
-        // Not vectorizable
-        for (ipr=0 ; ipr<number_of_particles; ipr++ ) {
-
-            // Momentum cell index for this particle
-            ic = momentum_cell_index[ipr];
-
-            // std::cerr << " ic: " << ic
-            //           << " ipr: " << ipr
-            //           << " momentum_cell_particle_index[ic]: " << momentum_cell_particle_index[ic]
-            //           << std::endl;
-
-            sorted_particles[momentum_cell_particle_index[ic]
-            + particles_per_momentum_cells[ic]] = istart + ipr;
-
-            particles_per_momentum_cells[ic] += 1;
-        }
+        // Array containing the number of particles per momentum cells
+        const unsigned int *particles_per_momentum_cells = buffers.particles_per_momentum_cells.data();
 
+        // Array containing the first particle index of each momentum cell
+        // in the sorted particle array
+        const unsigned int *momentum_cell_particle_index = buffers.momentum_cell_particle_index.data();
 
         // For each momentum bin, merge packet of particles composed of
         // at least `min_packet_size_` and `max_packet_size_`
@@ -678,11 +632,11 @@ void MergingVranicCartesian::operator() (
                                 
                                 // Method 2: random - pick up randomly old particle positions
                                 
-                                // unsigned int ipr1 = ipr_min + int(Rand::uniform()*(ipr_max - ipr_min));
-                                // unsigned int ipr2 = ipr_min + int(Rand::uniform()*(ipr_max - ipr_min));
+                                // unsigned int ipr1 = ipr_min + int(rand_gen->uniform()*(ipr_max - ipr_min));
+                                // unsigned int ipr2 = ipr_min + int(rand_gen->uniform()*(ipr_max - ipr_min));
                                 // while (ipr1 == ipr2)
                                 // {
-                                //     ipr2 = ipr_min + int(Rand::uniform()*(ipr_max - ipr_min));
+                                //     ipr2 = ipr_min + int(rand_gen->uniform()*(ipr_max - ipr_min));
                                 // }
                                 //
                                 // for (ipr = ipr_min; ipr < ipr_max ; ipr ++) {
@@ -730,7 +684,7 @@ void MergingVranicCartesian::operator() (
                                     
                                     // Method 2: random - pick up randomly old particle positions
                                     
-                                    // unsigned int ipr1 = ipr_min + int(Rand::uniform()*(ipr_max - ipr_min));
+                                    // unsigned int ipr1 = ipr_min + int(rand_gen->uniform()*(ipr_max - ipr_min));
                                     // for (ipr = ipr_min; ipr < ipr_max ; ipr ++) {
                                     //     if (ipr == ipr1) {
                                     //         ip = sorted_particles[momentum_cell_particle_index[ic] + ipr1];
@@ -754,13 +708,6 @@ void MergingVranicCartesian::operator() (
                 }
             }
         }
-
-        // Free aligned arrays
-//         free(gamma);
-//         free(momentum_cell_index);
-//         free(sorted_particles);
-//         free(particles_per_momentum_cells);
-//         free(momentum_cell_particle_index);
     }
 
 }
@@ -49,6 +49,7 @@ public:
         Particles &particles,
         std::vector <int> &mask,
         SmileiMPI *smpi,
+        Random *rand_gen,
         int istart,
         int iend,
         int & count);
@@ -67,6 +67,7 @@ void MergingVranicSpherical::operator() (
         Particles &particles,
         std::vector <int> &mask,
         SmileiMPI* smpi,
+        Random *rand_gen,
         int istart,
         int iend,
         int & count)
@@ -90,34 +91,33 @@ void MergingVranicSpherical::operator() (
         unsigned int theta_dim_ref = dimensions_[1];
         unsigned int theta_dim_min = 1;
         unsigned int phi_dim = dimensions_[2];
-        std::vector <unsigned int> theta_dim(phi_dim,0);
-//         unsigned int  * theta_dim = (unsigned int*) aligned_alloc(64, phi_dim*sizeof(unsigned int));
+
+        // Scratch buffers of this thread
+        MergingBuffers &buffers = threadBuffers();
+
+        unsigned int *theta_dim = scratch( buffers.theta_dim, phi_dim );
 
         // Minima
         double mr_min;
         double theta_min_ref;
-        std::vector <double> theta_min(phi_dim,0);
-//         double  * theta_min = (double*) aligned_alloc(64, phi_dim*sizeof(double));
+        double *theta_min = scratch( buffers.theta_min, phi_dim );
         double phi_min;
 
         // Maxima
         double mr_max;
         double theta_max_ref;
-        std::vector <double> theta_max(phi_dim,0);
-//         double  * theta_max = (double*) aligned_alloc(64, phi_dim*sizeof(double));
+        double *theta_max = scratch( buffers.theta_max, phi_dim );
         double phi_max;
 
         // Delta
         double mr_delta;
         double theta_delta_ref;
-        std::vector <double> theta_delta(phi_dim,0);
-//         double  * theta_delta = (double*) aligned_alloc(64, phi_dim*sizeof(double));
+        double *theta_delta = scratch( buffers.theta_delta, phi_dim );
         double phi_delta;
 
         // Inverse Delta
         double inv_mr_delta;
-        std::vector <double> inv_theta_delta(phi_dim,0);
-//         double  * inv_theta_delta = (double*) aligned_alloc(64, phi_dim*sizeof(double));
+        double *inv_theta_delta = scratch( buffers.inv_theta_delta, phi_dim );
         double inv_phi_delta;
 
         // Interval
@@ -172,22 +172,17 @@ void MergingVranicSpherical::operator() (
         // int *cell_keys = &( particles.cell_keys[0] );
 
         // Norm of the momentum
-        std::vector <double> momentum_norm(number_of_particles,0);
-//         double  * momentum_norm = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
+        double *__restrict__ momentum_norm = scratch( buffers.gamma, number_of_particles );
 
-        // Local vector to store the momentum index in the momentum discretization
-        std::vector <unsigned int> momentum_cell_index(number_of_particles,0);
-//         unsigned int  * momentum_cell_index = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        // Local array to store the momentum index in the momentum discretization
+        unsigned int *__restrict__ momentum_cell_index = scratch( buffers.momentum_cell_index, number_of_particles );
 
         // Sorted array of particle index
-        std::vector <unsigned int> sorted_particles(number_of_particles,0);
-//         unsigned int  * sorted_particles = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        unsigned int *__restrict__ sorted_particles = scratch( buffers.sorted_particles, number_of_particles );
 
-        // Local vector to store the momentum angles in the spherical base
-        std::vector <double> particles_phi(number_of_particles,0);
-        std::vector <double> particles_theta(number_of_particles,0);
-//         double  * particles_phi = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
-//         double  * particles_theta = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
+        // Local arrays to store the momentum angles in the spherical base
+        double *__restrict__ particles_phi = scratch( buffers.particles_phi, number_of_particles );
+        double *__restrict__ particles_theta = scratch( buffers.particles_theta, number_of_particles );
 
         // Computation of the particle momentum properties
         #pragma omp simd private(ipr)
@@ -268,7 +263,7 @@ void MergingVranicSpherical::operator() (
                     if (accumulation_correction_) {
                         mr_delta = (mr_interval) / (mr_dim-1);
                         // A bit of chaos to kill the accumulation effect
-                        mr_min -= 0.99*mr_delta*Rand::uniform();
+                        mr_min -= 0.99*mr_delta*rand_gen->uniform();
                         inv_mr_delta = 1./mr_delta;
                     } else {
                         mr_max += (mr_interval)*0.01;
@@ -295,7 +290,7 @@ void MergingVranicSpherical::operator() (
                 if (accumulation_correction_) {
                     phi_delta = (phi_interval) / (phi_dim-1);
                     // A bit of chaos to kill the accumulation effect
-                    phi_min -= 0.99*phi_delta*Rand::uniform();
+                    phi_min -= 0.99*phi_delta*rand_gen->uniform();
                     inv_phi_delta = 1./phi_delta;
                 } else {
                     phi_max += (phi_interval)*0.01;
@@ -325,7 +320,7 @@ void MergingVranicSpherical::operator() (
                     //theta_delta = (theta_max - theta_min) / theta_dim;
                     theta_delta_ref = fabs(theta_max_ref - theta_min_ref) / (theta_dim_ref);
                     // A bit of chaos to kill the accumulation effect
-                    // theta_min_ref -= 0.99*theta_delta_ref*Rand::uniform();
+                    // theta_min_ref -= 0.99*theta_delta_ref*rand_gen->uniform();
                     // theta_max_ref = theta_dim_ref*theta_delta_ref + theta_min_ref;
                     theta_interval = fabs(theta_max_ref - theta_min_ref);
                     //inv_theta_delta = 1./theta_delta;
@@ -362,7 +357,7 @@ void MergingVranicSpherical::operator() (
                     theta_dim[phi_i]   = std::max((unsigned int)(round(theta_interval / theta_delta[phi_i])), theta_dim_min);
                     if (accumulation_correction_) {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]-1);
-                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*Rand::uniform();
+                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*rand_gen->uniform();
                         theta_max[phi_i]   = theta_delta[phi_i]*theta_dim[phi_i] + theta_min[phi_i];
                     } else {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]);
@@ -375,7 +370,7 @@ void MergingVranicSpherical::operator() (
                     theta_dim[phi_i]   = theta_dim_min;
                     if (accumulation_correction_) {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]-1);
-                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*Rand::uniform();
+                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*rand_gen->uniform();
                         theta_max[phi_i]   = theta_delta[phi_i]*theta_dim[phi_i] + theta_min[phi_i];
                     } else {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]);
@@ -430,25 +425,9 @@ void MergingVranicSpherical::operator() (
             momentum_angular_cells += theta_dim[phi_i];
         }
 
-        // Array containing the number of particles per momentum cells
-        std::vector <unsigned int> particles_per_momentum_cells(momentum_cells,0);
-//         unsigned int  * particles_per_momentum_cells = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-
-        // Array containing the first particle index of each momentum cell
-        // in the sorted particle array
-        std::vector <unsigned int> momentum_cell_particle_index(momentum_cells,0);
-//         unsigned int  * momentum_cell_particle_index = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-// 
-//         // Initialization when using aligned_alloc
-//         #pragma omp simd
-//         for (ic = 0 ; ic < momentum_cells ; ic++) {
-//             momentum_cell_particle_index[ic] = 0;
-//             particles_per_momentum_cells[ic] = 0;
-//         }
-
         // First Cell index in theta for each phi coordinates
         // (necessary since the theta_dim depends on phi)
-        std::vector <unsigned int>  theta_start_index (phi_dim);
+        unsigned int *theta_start_index = scratch( buffers.theta_start_index, phi_dim );
 
         // Computation of the first cell index for each phi
         theta_start_index[0] = 0;
@@ -460,12 +439,9 @@ void MergingVranicSpherical::operator() (
         // Only necessary for mass particles
 
         // Cell direction unit vector in the spherical base
-        std::vector <double> cell_vec_x(momentum_angular_cells,0);
-        std::vector <double> cell_vec_y(momentum_angular_cells,0);
-        std::vector <double> cell_vec_z(momentum_angular_cells,0);
-//         double  * cell_vec_x = (double*) aligned_alloc(64, momentum_angular_cells*sizeof(double));
-//         double  * cell_vec_y = (double*) aligned_alloc(64, momentum_angular_cells*sizeof(double));
-//         double  * cell_vec_z = (double*) aligned_alloc(64, momentum_angular_cells*sizeof(double));
+        double *__restrict__ cell_vec_x = scratch( buffers.cell_vec_x, momentum_angular_cells );
+        double *__restrict__ cell_vec_y = scratch( buffers.cell_vec_y, momentum_angular_cells );
+        double *__restrict__ cell_vec_z = scratch( buffers.cell_vec_z, momentum_angular_cells );
 
         for (phi_i = 0 ; phi_i < phi_dim ; phi_i ++) {
             
@@ -500,14 +476,14 @@ void MergingVranicSpherical::operator() (
                 // index in the radial direction mr
                 if (momentum_norm[ipr] > min_momentum_log_scale_)
                 {
-                    mr_i = (unsigned int) floor( (log10(momentum_norm[ipr]) - mr_min) * inv_mr_delta);
+                    mr_i = (int) floor( (log10(momentum_norm[ipr]) - mr_min) * inv_mr_delta);
                 } else {
                     mr_i = 0;
                 }
                 // index in phi
-                phi_i   = (unsigned int) floor( (particles_phi[ipr] - phi_min) * inv_phi_delta);
+                phi_i   = (int) floor( (particles_phi[ipr] - phi_min) * inv_phi_delta);
                 // index in theta
-                theta_i = (unsigned int) floor( (particles_theta[ipr] - theta_min[phi_i]) * inv_theta_delta[phi_i]);
+                theta_i = (int) floor( (particles_theta[ipr] - theta_min[phi_i]) * inv_theta_delta[phi_i]);
 
                 // 1D Index in the momentum discretization
                 momentum_cell_index[ipr] = (theta_start_index[phi_i]
@@ -539,9 +515,9 @@ void MergingVranicSpherical::operator() (
             for (ipr= 0; ipr < number_of_particles ; ipr++ ) {
                 
                 // 3d indexes in the momentum discretization
-                mr_i    = (unsigned int) floor( (momentum_norm[ipr] - mr_min) * inv_mr_delta);
-                phi_i   = (unsigned int) floor( (particles_phi[ipr] - phi_min)      * inv_phi_delta);
-                theta_i = (unsigned int) floor( (particles_theta[ipr] - theta_min[phi_i])  * inv_theta_delta[phi_i]);
+                mr_i    = (int) floor( (momentum_norm[ipr] - mr_min) * inv_mr_delta);
+                phi_i   = (int) floor( (particles_phi[ipr] - phi_min)      * inv_phi_delta);
+                theta_i = (int) floor( (particles_theta[ipr] - theta_min[phi_i])  * inv_theta_delta[phi_i]);
 
                 // 1D Index in the momentum discretization
                 momentum_cell_index[ipr] = (theta_start_index[phi_i]
@@ -563,35 +539,15 @@ void MergingVranicSpherical::operator() (
             }
         }
 
-        // The number of particles per momentum cells
-        // is then determined.
-        // No vectorization because of random memory accesses
-        for (ipr=0; ipr<number_of_particles; ipr++ ) {
-            // Number of particles per momentum cells
-            particles_per_momentum_cells[momentum_cell_index[ipr]] += 1;
-        }
+        // Particles are sorted in the momentum cells
+        sortInMomentumCells( buffers, number_of_particles, momentum_cells, istart );
 
-        // Computation of the cell index in the sorted array of particles
-        // Noy vectorizable
-        for (ic = 1 ; ic < momentum_cells ; ic++) {
-            momentum_cell_particle_index[ic]  = momentum_cell_particle_index[ic-1] + particles_per_momentum_cells[ic-1];
-            particles_per_momentum_cells[ic-1] = 0;
-        }
-        particles_per_momentum_cells[momentum_cells-1] = 0;
-
-        // sort particles in correct bins according to their
-        // momentum properties
-        // Not vectorizable
-        for (ipr=0 ; ipr<number_of_particles; ipr++ ) {
-
-            // Momentum cell index for this particle
-            ic = momentum_cell_index[ipr];
-
-            sorted_particles[momentum_cell_particle_index[ic]
-            + particles_per_momentum_cells[ic]] = istart + ipr;
+        // Array containing the number of particles per momentum cells
+        const unsigned int *particles_per_momentum_cells = buffers.particles_per_momentum_cells.data();
 
-            particles_per_momentum_cells[ic] += 1;
-        }
+        // Array containing the first particle index of each momentum cell
+        // in the sorted particle array
+        const unsigned int *momentum_cell_particle_index = buffers.momentum_cell_particle_index.data();
 
         // Debugging
         /*for (mr_i=0 ; mr_i< mr_dim; mr_i++ ) {
@@ -971,24 +927,6 @@ void MergingVranicSpherical::operator() (
                 }
             }
         }
-
-        // Free aligned arrays
-//         free(momentum_norm);
-//         free(momentum_cell_index);
-//         free(cell_vec_x);
-//         free(cell_vec_y);
-//         free(cell_vec_z);
-//         free(particles_phi);
-//         free(particles_theta);
-//         free(sorted_particles);
-//         free(particles_per_momentum_cells);
-//         free(momentum_cell_particle_index);
-//         free(theta_start_index);
-//         free(theta_dim);
-//         free(theta_min);
-//         free(theta_max);
-//         free(theta_delta);
-//         free(inv_theta_delta);
     }
 
 }
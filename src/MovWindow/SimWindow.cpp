@@ -79,10 +79,22 @@ SimWindow::SimWindow( Params &params )
         params.hasWindow = false;
     }
     
+    // Patches are recycled if all their fields can be reset in place
+    recycle_patches_ = params.geometry != "AMcylindrical"
+                       && ! params.Laser_Envelope_model
+                       && ! params.is_spectral
+                       && ! params.is_pxr;
+    
 }
 
 SimWindow::~SimWindow()
 {
+    for( unsigned int i=0; i<recycled_patches_.size(); i++ ) {
+        delete recycled_patches_[i];
+    }
+    for( unsigned int i=0; i<retired_patches_.size(); i++ ) {
+        delete retired_patches_[i];
+    }
 }
 
 bool SimWindow::isMoving( double time_dual )
@@ -90,6 +102,24 @@ bool SimWindow::isMoving( double time_dual )
     return active && ( ( time_dual - time_start )*velocity_x > x_moved - number_of_additional_shifts*cell_length_x_*n_space_x_*(time_dual>additional_shifts_time) );
 }
 
+Patch *SimWindow::takeRecycledPatch( VectorPatch &vecPatches, Params &params, unsigned int hindex )
+{
+    std::vector<unsigned int> coordinates = vecPatches.domain_decomposition_->getDomainCoordinates( hindex );
+    for( unsigned int i=0; i<recycled_patches_.size(); i++ ) {
+        Patch *patch = recycled_patches_[i];
+        bool same_row = true;
+        for( unsigned int idim=1; idim<params.nDim_field; idim++ ) {
+            same_row = same_row && patch->Pcoordinates[idim] == coordinates[idim];
+        }
+        if( same_row ) {
+            recycled_patches_[i] = recycled_patches_.back();
+            recycled_patches_.pop_back();
+            return patch;
+        }
+    }
+    return NULL;
+}
+
 void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params, unsigned int itime, double time_dual )
 {
     if( ! isMoving( time_dual ) && itime != additional_shifts_iteration ) {
@@ -109,6 +139,13 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
     
     std::vector<Patch *> delete_patches_, update_patches_, send_patches_;
     
+    // Lasers at xmax are not re-created in recycled patches
+    bool recycle_patches = recycle_patches_;
+    ElectroMagnBC *xmax_bc = vecPatches( 0 )->EMfields->emBoundCond.size() > 1 ? vecPatches( 0 )->EMfields->emBoundCond[1] : NULL;
+    if( xmax_bc && xmax_bc->vecLaser.size() > 0 ) {
+        recycle_patches = false;
+    }
+    
 #ifdef _OPENMP
     int my_thread = omp_get_thread_num();
 #else
@@ -133,6 +170,14 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
 
             vecPatches_old.resize( nPatches );
             n_moved += params.n_space[0];
+            
+            // Patches which left the window at the previous shift are recycled during this one.
+            // Those which could not be re-used (e.g. after load balancing) are deleted.
+            for( unsigned int i=0; i<recycled_patches_.size(); i++ ) {
+                delete recycled_patches_[i];
+            }
+            recycled_patches_.swap( retired_patches_ );
+            retired_patches_.clear();
         }
         //Cut off laser before exchanging any patches to avoid deadlock and store pointers in vecpatches_old.
 #ifndef _NO_MPI_TM
@@ -202,11 +247,24 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
         
         //Creation of new Patches
         for( unsigned int j = 0; j < patch_to_be_created[my_thread].size();  j++ ) {
-            //create patch without particle.
+            unsigned int new_hindex = h0 + patch_to_be_created[my_thread][j];
+            mypatch = NULL;
+            if( recycle_patches ) {
+#ifndef _NO_MPI_TM
+                #pragma omp critical
+#endif
+                mypatch = takeRecycledPatch( vecPatches, params, new_hindex );
+            }
+            if( mypatch ) {
+                //re-use a patch which left the window, without particle.
+                mypatch->recycle( params, smpi, vecPatches.domain_decomposition_, new_hindex, n_moved );
+            } else {
+                //create patch without particle.
 #ifndef _NO_MPI_TM
-            #pragma omp critical
+                #pragma omp critical
 #endif
-            mypatch = PatchesFactory::clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved, false );
+                mypatch = PatchesFactory::clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, new_hindex, n_moved, false );
+            }
             
             // Do not receive Xmin condition
             if( mypatch->isXmin() && mypatch->EMfields->emBoundCond[0] ) {
@@ -267,12 +325,9 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
                     mypatch->vecSpecies[ispec]->setXminBoundaryCondition();
                 }
             }
+            // MPI datatypes do not depend on the patch position: they are kept once created
             if( mypatch->has_an_MPI_neighbor() ) {
                 mypatch->createType( params );
-            } else
-            
-            {
-                mypatch->cleanType();
             }
             
             if( mypatch->isXmin() ) {
@@ -546,8 +601,14 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
                     poynting[jp][i] += mypatch->EMfields->poynting[jp][i];
                 }
                 
-                
-            delete  mypatch;
+            if( recycle_patches ) {
+#ifndef _NO_MPI_TM
+                #pragma omp critical
+#endif
+                retired_patches_.push_back( mypatch );
+            } else {
+                delete  mypatch;
+            }
         }
         
         // SUM energy_field_lost, energy_part_lost and poynting / All threads
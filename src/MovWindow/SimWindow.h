@@ -108,6 +108,17 @@ private:
     //! Number of additional moving window shifts
     unsigned int number_of_additional_shifts;
     
+    //! Tells whether the patches leaving the window can be recycled as new patches (cartesian geometries only)
+    bool recycle_patches_;
+    //! Patches which left the window at the previous shift, re-used as the new patches of the current shift
+    std::vector<Patch *> recycled_patches_;
+    //! Patches leaving the window at the current shift
+    std::vector<Patch *> retired_patches_;
+    
+    //! Take from recycled_patches_ a patch in the same row (same transverse coordinates) as the patch hindex.
+    //! Returns NULL if there is none.
+    Patch *takeRecycledPatch( VectorPatch &vecPatches, Params &params, unsigned int hindex );
+    
     
 };
 
@@ -125,6 +125,7 @@ void MultiphotonBreitWheeler::compute_thread_chiph( Particles &particles,
 void MultiphotonBreitWheeler::operator()( Particles &particles,
         SmileiMPI *smpi,
         MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+        Random *rand_gen,
         int istart,
         int iend,
         int ithread, int ipart_ref )
@@ -144,12 +145,6 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
     double *By = &( ( *Bpart )[1*nparts] );
     double *Bz = &( ( *Bpart )[2*nparts] );
     
-    // Temporary value
-    double temp;
-    
-    // Time to event
-    double event_time;
-    
     // Momentum shortcut
     double *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
@@ -200,72 +195,111 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
     }
     
     // 2. Monte-Carlo process
-    //    No vectorized
+    //    The photons are first sorted between the ones starting a new
+    //    process and the ones with a decay under progress. The cross
+    //    sections and the pair quantum parameters are then computed
+    //    in vectorized batches.
+    resizeBuffers( iend-istart );
+    int *decay_index = decay_index_.data();
+    double *decay_chi = decay_chi_.data();
+    double *decay_gamma = decay_gamma_.data();
+    double *decay_rate = decay_rate_.data();
+    double *event_time = event_time_.data();
+    double *electron_chi = electron_chi_.data();
+    double *positron_chi = positron_chi_.data();
+    int n_decay = 0;
+
     for( int ipart=istart ; ipart<iend; ipart++ ) {
-    
+
         // If the photon has enough energy
         // We also check that photon_chi > chiph_threshold,
         // else photon_chi is too low to induce a decay
         if( ( ( *gamma )[ipart] > 2. ) && ( photon_chi[ipart] > chiph_threashold ) ) {
-            // Init local variables
-            event_time = 0;
-            
+
             // New even
             // If tau[ipart] <= 0, this is a new process
             if( tau[ipart] <= epsilon_tau_ ) {
                 // New final optical depth to reach for emision
                 while( tau[ipart] <= epsilon_tau_ ) {
-                    tau[ipart] = -log( 1.-Rand::uniform() );
+                    tau[ipart] = -log( 1.-rand_gen->uniform() );
                 }
-                
             }
-            
+
             // Photon decay: emission under progress
-            // If epsilon_tau_ > 0
-            else if( tau[ipart] > epsilon_tau_ ) {
-                // from the cross section
-                temp = MultiphotonBreitWheelerTables.compute_dNBWdt( photon_chi[ipart], ( *gamma )[ipart] );
-                
-                // Time to decay
-                // If this time is above the remaining iteration time,
-                // There is a synchronization at the end of the pic iteration
-                // and the process continues at the next
-                event_time = std::min( tau[ipart]/temp, dt );
-                
-                // Update of the optical depth
-                tau[ipart] -= temp*event_time;
-                
-                // If the final optical depth is reached
-                // The photon decays into pairs
-                if( tau[ipart] <= epsilon_tau_ ) {
-                
-                    // Update of the position
-                    // Move the photons
-                    
-//#ifdef  __DEBUG
-//                    for ( int i = 0 ; i<n_dimensions_ ; i++ )
-//                        particles.position_old(i,ipart) = position[i][ipart];
-//#endif
-//                    for ( int i = 0 ; i<n_dimensions_ ; i++ )
-//                        position[i][ipart]     += event_time*momentum[i][ipart]/(*gamma)[ipart];
-
-
-                    // Generation of the pairs
-                    MultiphotonBreitWheeler::pair_emission( ipart,
-                                                            particles,
-                                                            ( *gamma )[ipart],
-                                                            dt - event_time,
-                                                            MultiphotonBreitWheelerTables );
-                                                            
-                                                            
-                    // Optical depth becomes negative meaning
-                    // that a new drawing is possible
-                    // at the next Monte-Carlo iteration
-                    tau[ipart] = -1.;
-                }
+            else {
+                decay_index[n_decay] = ipart;
+                decay_chi[n_decay] = photon_chi[ipart];
+                decay_gamma[n_decay] = ( *gamma )[ipart];
+                n_decay++;
             }
         }
     }
+
+    if( n_decay == 0 ) {
+        return;
+    }
+
+    // Production rates from the cross section
+    MultiphotonBreitWheelerTables.compute_dNBWdt( n_decay, decay_chi, decay_gamma, decay_rate );
+
+    // Update of the optical depths, the decaying photons are compacted
+    // at the beginning of the buffers
+    int n_pair = 0;
+    for( int k=0 ; k<n_decay ; k++ ) {
+        int ipart = decay_index[k];
+
+        // Time to decay
+        // If this time is above the remaining iteration time,
+        // There is a synchronization at the end of the pic iteration
+        // and the process continues at the next
+        double time = std::min( tau[ipart]/decay_rate[k], dt );
+
+        // Update of the optical depth
+        tau[ipart] -= decay_rate[k]*time;
+
+        // If the final optical depth is reached
+        // The photon decays into pairs
+        if( tau[ipart] <= epsilon_tau_ ) {
+            decay_index[n_pair] = ipart;
+            decay_chi[n_pair] = decay_chi[k];
+            event_time[n_pair] = time;
+            n_pair++;
+
+            // Optical depth becomes negative meaning
+            // that a new drawing is possible
+            // at the next Monte-Carlo iteration
+            tau[ipart] = -1.;
+        }
+    }
+
+    // Quantum parameters of the pairs
+    MultiphotonBreitWheelerTables.compute_pair_chi( n_pair, decay_chi, electron_chi, positron_chi, rand_gen );
+
+    // Generation of the pairs
+    for( int k=0 ; k<n_pair ; k++ ) {
+        MultiphotonBreitWheeler::pair_emission( decay_index[k],
+                                                particles,
+                                                ( *gamma )[decay_index[k]],
+                                                dt - event_time[k],
+                                                electron_chi[k],
+                                                positron_chi[k] );
+    }
+}
+
+// -----------------------------------------------------------------------------
+//! Resize the buffers of the Monte-Carlo process for n photons
+// -----------------------------------------------------------------------------
+void MultiphotonBreitWheeler::resizeBuffers( int n )
+{
+    if( ( int )decay_index_.size() < n ) {
+        decay_index_.resize( n );
+        decay_chi_.resize( n );
+        decay_gamma_.resize( n );
+        decay_rate_.resize( n );
+        event_time_.resize( n );
+        electron_chi_.resize( n );
+        positron_chi_.resize( n );
+    }
 }
 
 
@@ -276,15 +310,15 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
 //! \param particles          object particles containing the photons and their properties
 //! \param gammaph            photon normalized energy
 //! \param remaining_dt       remaining time before the end of the iteration
-//! \param MultiphotonBreitWheelerTables    Cross-section data tables
-//!                       and useful functions
-//!                       for the multiphoton Breit-Wheeler process
+//! \param electron_chi       quantum parameter of the electron
+//! \param positron_chi       quantum parameter of the positron
 // -----------------------------------------------------------------------------
 void MultiphotonBreitWheeler::pair_emission( int ipart,
         Particles &particles,
         double &gammaph,
         double remaining_dt,
-        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables )
+        double electron_chi,
+        double positron_chi )
 {
 
     // _______________________________________________
@@ -293,7 +327,7 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     int      nparticles;           // Total number of particles in the temporary arrays
     int      k, i;
     double   u[3];                 // propagation direction
-    double *chi = new double[2];   // temporary quantum parameters
+    double   chi[2];               // pair quantum parameters
     double   inv_chiph_gammaph;    // (gamma_ph - 2) / chi
     double   p;
     // Commented particles displasment while particles injection not managed  in a better way
@@ -303,8 +337,8 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     
     inv_chiph_gammaph = ( gammaph-2. )/particles.chi( ipart );
     
-    // Get the pair quantum parameters to compute the energy
-    chi = MultiphotonBreitWheelerTables.compute_pair_chi( particles.chi( ipart ) );
+    chi[0] = electron_chi;
+    chi[1] = positron_chi;
     
     // pair propagation direction // direction of the photon
     for( k = 0 ; k<3 ; k++ ) {
@@ -35,12 +35,14 @@ public:
     //! \param smpi        MPI properties
     //! \param MultiphotonBreitWheelerTables Cross-section data tables and useful functions
     //                     for multiphoton Breit-Wheeler
+    //! \param rand_gen    Random number generator of the patch
     //! \param istart      Index of the first particle
     //! \param iend        Index of the last particle
     //! \param ithread     Thread index
     void operator()( Particles &particles,
                      SmileiMPI *smpi,
                      MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                     Random *rand_gen,
                      int istart,
                      int iend,
                      int ithread, int ipart_ref = 0 );
@@ -90,14 +92,14 @@ public:
     //! \param particles          object particles containing the photons and their properties
     //! \param gammaph            photon normalized energy
     //! \param remaining_dt       remaining time before the end of the iteration
-    //! \param MultiphotonBreitWheelerTables    Cross-section data tables
-    //!                       and useful functions
-    //!                       for the multiphoton Breit-Wheeler process
+    //! \param electron_chi       quantum parameter of the electron
+    //! \param positron_chi       quantum parameter of the positron
     void pair_emission( int ipart,
                         Particles &particles,
                         double &gammaph,
                         double remaining_dt,
-                        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables );
+                        double electron_chi,
+                        double positron_chi );
                         
     //! Clean photons that decayed into pairs (weight <= 0)
     //! \param particles   particle object containing the particle
@@ -155,6 +157,21 @@ private:
     //! Espilon to check when tau is near 0
     const double epsilon_tau_ = 1e-100;
     
+    // _________________________________________
+    // Buffers of the Monte-Carlo process, kept between iterations
+    
+    //! Photons with a decay under progress, then decaying photons
+    std::vector<int> decay_index_;
+    //! Quantum parameter, energy and pair production rate of these photons
+    std::vector<double> decay_chi_, decay_gamma_, decay_rate_;
+    //! Time of the decay in the current time step
+    std::vector<double> event_time_;
+    //! Quantum parameters of the created electrons and positrons
+    std::vector<double> electron_chi_, positron_chi_;
+    
+    //! Resize the buffers for n photons
+    void resizeBuffers( int n );
+    
 };
 
 #endif
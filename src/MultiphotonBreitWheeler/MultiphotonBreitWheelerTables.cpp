@@ -14,6 +14,9 @@
 #include <iomanip>
 
 #include "MultiphotonBreitWheelerTables.h"
+#include "TableCache.h"
+
+#include <algorithm>
 
 // -----------------------------------------------------------------------------
 // INITILIZATION AND DESTRUCTION
@@ -106,6 +109,9 @@ void MultiphotonBreitWheelerTables::initialization( Params &params, SmileiMPI *s
 
             // Format of the tables
             PyTools::extract( "output_format", output_format_, "MultiphotonBreitWheeler" );
+
+            // Cache of the computed tables
+            PyTools::extract( "table_cache_path", table_cache_path_, "MultiphotonBreitWheeler" );
         }
 
         // Path to the databases
@@ -147,54 +153,57 @@ void MultiphotonBreitWheelerTables::initialization( Params &params, SmileiMPI *s
 // -----------------------------------------------------------------------------
 
 // -----------------------------------------------------------------------------
-//! Computation of the production rate of pairs per photon
-//! \param photon_chi photon quantum parameter
-//! \param gamma photon normalized energy
+//! Computation of the production rate of pairs per photon, for n photons
+//! The table is interpolated in a vectorized loop, the asymptotic
+//! approximations out of the table are applied afterwards.
+//! \param n number of photons
+//! \param photon_chi photon quantum parameters
+//! \param gamma photon normalized energies
+//! \param rate production rates (output)
 // -----------------------------------------------------------------------------
-double MultiphotonBreitWheelerTables::compute_dNBWdt( double photon_chi, double gamma )
+void MultiphotonBreitWheelerTables::compute_dNBWdt( int n, const double *photon_chi, const double *gamma, double *rate )
 {
-    // ________________________________________
-    // Parameters
+    const double *table = T_table.data();
+    const int dim = T_dim;
+    int n_outside = 0;
+
+    #pragma omp simd reduction(+:n_outside)
+    for( int i=0 ; i<n ; i++ ) {
+        double logchiph = log10( photon_chi[i] );
+
+        // Lower index for interpolation in the table
+        int ichiph = int( floor( ( logchiph-T_log10_chiph_min )
+                                 *T_chiph_inv_delta ) );
+        n_outside += ( ichiph < 0 ) || ( ichiph >= dim-1 );
+        ichiph = std::min( std::max( ichiph, 0 ), dim-2 );
 
-    // Log of the photon quantum parameter particle_chi
-    double logchiph;
-    double logchiphm;
-    double logchiphp;
-    // Index
-    int ichiph;
-    // final value
-    double dNBWdt;
-
-    // ________________________________________
-    // Computation
-
-    logchiph = log10( photon_chi );
-
-    // Lower index for interpolation in the table integfochi
-    ichiph = int( floor( ( logchiph-T_log10_chiph_min )
-                         *T_chiph_inv_delta ) );
-
-    // If photon_chi is below the lower bound of the table
-    // An asymptotic approximation is used
-    if( ichiph < 0 ) {
-        ichiph = 0;
-        dNBWdt = 0.46*exp( -8./( 3.*photon_chi ) );
-    }
-    // If photon_chi is above the upper bound of the table
-    // An asymptotic approximation is used
-    else if( ichiph >= T_dim-1 ) {
-        ichiph = T_dim-2;
-        dNBWdt = 0.38*pow( photon_chi, -1./3. );
-    } else {
         // Upper and lower values for linear interpolation
-        logchiphm = ichiph*T_chiph_delta + T_log10_chiph_min;
-        logchiphp = logchiphm + T_chiph_delta;
+        double logchiphm = ichiph*T_chiph_delta + T_log10_chiph_min;
+        double logchiphp = logchiphm + T_chiph_delta;
 
         // Interpolation
-        dNBWdt = ( T_table[ichiph+1]*fabs( logchiph-logchiphm ) +
-                   T_table[ichiph]*fabs( logchiphp - logchiph ) )*T_chiph_inv_delta;
+        double dNBWdt = ( table[ichiph+1]*fabs( logchiph-logchiphm ) +
+                          table[ichiph]*fabs( logchiphp - logchiph ) )*T_chiph_inv_delta;
+        rate[i] = factor_dNBWdt*dNBWdt*photon_chi[i]/gamma[i];
+    }
+
+    if( n_outside == 0 ) {
+        return;
+    }
+    for( int i=0 ; i<n ; i++ ) {
+        int ichiph = int( floor( ( log10( photon_chi[i] )-T_log10_chiph_min )
+                                 *T_chiph_inv_delta ) );
+        // If photon_chi is below the lower bound of the table
+        // An asymptotic approximation is used
+        if( ichiph < 0 ) {
+            rate[i] = factor_dNBWdt*0.46*exp( -8./( 3.*photon_chi[i] ) )*photon_chi[i]/gamma[i];
+        }
+        // If photon_chi is above the upper bound of the table
+        // An asymptotic approximation is used
+        else if( ichiph >= dim-1 ) {
+            rate[i] = factor_dNBWdt*0.38*pow( photon_chi[i], -1./3. )*photon_chi[i]/gamma[i];
+        }
     }
-    return factor_dNBWdt*dNBWdt*photon_chi/gamma;
 }
 
 // -----------------------------------------------------------------------------
@@ -258,104 +267,65 @@ double MultiphotonBreitWheelerTables::compute_integration_Ritus_dTdchi( double p
 
 // -----------------------------------------------------------------------------
 //! Computation of the electron and positron quantum parameters for
-//! the multiphoton Breit-Wheeler pair creation
+//! the multiphoton Breit-Wheeler pair creation of n photons
 //
-//! \param photon_chi photon quantum parameter
+//! \param n number of photons
+//! \param photon_chi photon quantum parameters
+//! \param electron_chi electron quantum parameters (output)
+//! \param positron_chi positron quantum parameters (output)
+//! \param rand_gen random number generator of the patch
 // -----------------------------------------------------------------------------
-double *MultiphotonBreitWheelerTables::compute_pair_chi( double photon_chi )
+void MultiphotonBreitWheelerTables::compute_pair_chi( int n, const double *photon_chi,
+        double *electron_chi, double *positron_chi, Random *rand_gen )
 {
-    // Parameters
-    double *chi = new double[2];
-    double logchiph;
-    double log10_chipam, log10_chipap;
-    double d;
-    double delta_chipa;
-    double xip, xipp;
-    int ichiph;
-    int ichipa;
-    int ixip;
-
-    // -----------------------------------------------------------
-    // Computation of the index associated to the given photon_chi
-    // -----------------------------------------------------------
-
-    logchiph = log10( photon_chi );
-
-    // Lower boundary of the table
-    if( photon_chi < xip_chiph_min ) {
-        ichiph = 0;
-    }
-    // Upper boundary of the table
-    else if( photon_chi >= xip_chiph_max ) {
-        ichiph = xip_chiph_dim-1;
-    }
-    // Inside the table
-    else {
-        // Use floor so that photon_chi corresponding to ichiph is <= given photon_chi
-        ichiph = int( floor( ( logchiph-xip_log10_chiph_min )*( xip_chiph_inv_delta ) ) );
-    }
-
-    // ---------------------------------------
-    // Search of the index ichiph for photon_chi
-    // ---------------------------------------
+    // Random xip in [0,1[ drawn for all photons, stored in electron_chi
+    rand_gen->uniform( electron_chi, n );
 
-    // First, we compute a random xip in [0,1[
-    xip = Rand::uniform();
+    const double *table = xip_table.data();
+    const double *chipamin = xip_chipamin_table.data();
+    const int chiph_dim = xip_chiph_dim;
+    const int chipa_dim = xip_chipa_dim;
 
-    // The array uses the symmetric properties of the T fonction,
-    // Cases xip > or <= 0.5 are treated seperatly
-
-    // If xip > 0.5, the electron will bring more energy than the positron
-    if( xip > 0.5 ) {
-        xipp = 1.-xip;
-    } else {
-        xipp = xip;
-    }
-
-    // check boundaries
-    // Lower bound
-    if( xipp < xip_table[ichiph*xip_chipa_dim] ) {
-        ichipa = 0;
-    }
-    // Upper bound
-    else if( xipp >= xip_table[( ichiph+1 )*xip_chipa_dim-1] ) {
-        ichipa = xip_chipa_dim-2;
-    } else {
-        // Search for the corresponding index ichipa for xip
-        ichipa = userFunctions::searchValuesInMonotonicArray(
-                     &xip_table[ichiph*xip_chipa_dim], xipp, xip_chipa_dim );
-    }
+    #pragma omp simd
+    for( int i=0 ; i<n ; i++ ) {
+        double xip = electron_chi[i];
 
-    // Delta for the particle_chi dimension
-    delta_chipa = ( log10( 0.5*photon_chi )-xip_chipamin_table[ichiph] )
-                  * xip_inv_chipa_dim_minus_one;
+        // -----------------------------------------------------------
+        // Computation of the index associated to the given photon_chi
+        // -----------------------------------------------------------
+        // Use floor so that photon_chi corresponding to ichiph is <= given photon_chi
+        // Lower and upper boundaries of the table
+        int ichiph = int( floor( ( log10( photon_chi[i] )-xip_log10_chiph_min )*( xip_chiph_inv_delta ) ) );
+        ichiph = ( photon_chi[i] < xip_chiph_min ) ? 0 : ( ( photon_chi[i] >= xip_chiph_max ) ? chiph_dim-1 : ichiph );
+        const double *row = &table[ichiph*chipa_dim];
 
-    ixip = ichiph*xip_chipa_dim + ichipa;
+        // The array uses the symmetric properties of the T fonction,
+        // Cases xip > or <= 0.5 are treated seperatly
+        double xipp = ( xip > 0.5 ) ? 1.-xip : xip;
 
-    log10_chipam = ichipa*delta_chipa + xip_chipamin_table[ichiph];
-    log10_chipap = log10_chipam + delta_chipa;
+        // ---------------------------------------
+        // Search of the index ichipa for xip
+        // ---------------------------------------
+        int ichipa = userFunctions::searchValuesInMonotonicArrayBranchless( row, xipp, chipa_dim );
+        // check boundaries
+        ichipa = ( xipp <= row[0] ) ? 0 : ( ( xipp >= row[chipa_dim-1] ) ? chipa_dim-2 : ichipa );
 
-    d = ( xipp - xip_table[ixip] ) / ( xip_table[ixip+1] - xip_table[ixip] );
+        // Delta for the particle_chi dimension
+        double delta_chipa = ( log10( 0.5*photon_chi[i] )-chipamin[ichiph] )
+                             * xip_inv_chipa_dim_minus_one;
 
-    // If xip > 0.5, the electron will bring more energy than the positron
-    if( xip > 0.5 ) {
+        double log10_chipam = ichipa*delta_chipa + chipamin[ichiph];
+        double log10_chipap = log10_chipam + delta_chipa;
 
-        // Positron quantum parameter
-        chi[1] = pow( 10, log10_chipam*( 1.0-d ) + log10_chipap*( d ) );
+        double d = ( xipp - row[ichipa] ) / ( row[ichipa+1] - row[ichipa] );
 
-        // Electron quantum parameter
-        chi[0] = photon_chi - chi[1];
-    }
-    // If xip <= 0.5, the positron will bring more energy than the electron
-    else {
-        // Electron quantum parameter
-        chi[0] = pow( 10, log10_chipam*( 1.0-d ) + log10_chipap*( d ) );
+        double chi = pow( 10, log10_chipam*( 1.0-d ) + log10_chipap*( d ) );
 
-        // Positron quantum parameter
-        chi[1] = photon_chi - chi[0];
+        // If xip > 0.5, the electron will bring more energy than the positron
+        // If xip <= 0.5, the positron will bring more energy than the electron
+        positron_chi[i] = ( xip > 0.5 ) ? chi : photon_chi[i] - chi;
+        electron_chi[i] = ( xip > 0.5 ) ? photon_chi[i] - chi : chi;
     }
-
-    return chi;
 }
 
 // -----------------------------------------------------------------------------
@@ -447,10 +417,6 @@ void MultiphotonBreitWheelerTables::computeTtable( SmileiMPI *smpi )
     // Allocation of the array T_table
     T_table.resize( T_dim );
 
-    // Allocation of the table for load repartition
-    imin_table = new int[nb_ranks];
-    length_table = new int[nb_ranks];
-
     // Computation of the delta
     T_chiph_delta = ( log10( T_chiph_max )
                       - T_log10_chiph_min )/( T_dim-1 );
@@ -458,6 +424,19 @@ void MultiphotonBreitWheelerTables::computeTtable( SmileiMPI *smpi )
     // Inverse delta
     T_chiph_inv_delta = 1./T_chiph_delta;
 
+    // The table may have been computed by a previous run with the same parameters
+    TableCache cache( table_cache_path_, "multiphoton_Breit_Wheeler_T" );
+    cache << T_dim << T_chiph_min << T_chiph_max;
+    if( cache.load( smpi, { &T_table } ) ) {
+        T_computed = true;
+        MESSAGE( 2,"Read from the cache `" << cache.filename() << "`" );
+        return;
+    }
+
+    // Allocation of the table for load repartition
+    imin_table = new int[nb_ranks];
+    length_table = new int[nb_ranks];
+
     // Load repartition
     userFunctions::distributeArray( nb_ranks,
             T_dim,
@@ -504,6 +483,9 @@ void MultiphotonBreitWheelerTables::computeTtable( SmileiMPI *smpi )
     // flag computed at true
     T_computed = true;
 
+    // Store the table for the next runs
+    cache.store( smpi, { &T_table } );
+
     // Free memory
     delete[] length_table;
     delete[] buffer;
@@ -569,10 +551,6 @@ void MultiphotonBreitWheelerTables::computeXipTable( SmileiMPI *smpi )
     // Allocation of the array xip_table
     xip_table.resize( xip_chipa_dim*xip_chiph_dim );
 
-    // Allocation of the table for load repartition
-    imin_table = new int[nb_ranks];
-    length_table = new int[nb_ranks];
-
     // Computation of the delta
     xip_chiph_delta = ( log10( xip_chiph_max )
                         - xip_log10_chiph_min )/( xip_chiph_dim-1 );
@@ -580,6 +558,19 @@ void MultiphotonBreitWheelerTables::computeXipTable( SmileiMPI *smpi )
     // Inverse of delta
     xip_chiph_inv_delta = 1./xip_chiph_delta;
 
+    // The table may have been computed by a previous run with the same parameters
+    TableCache cache( table_cache_path_, "multiphoton_Breit_Wheeler_xip" );
+    cache << xip_chiph_dim << xip_chipa_dim << xip_chiph_min << xip_chiph_max << xip_power << xip_threshold;
+    if( cache.load( smpi, { &xip_chipamin_table, &xip_table } ) ) {
+        xip_computed = true;
+        MESSAGE( 2,"Read from the cache `" << cache.filename() << "`" );
+        return;
+    }
+
+    // Allocation of the table for load repartition
+    imin_table = new int[nb_ranks];
+    length_table = new int[nb_ranks];
+
     // Load repartition
     userFunctions::distributeArray( nb_ranks,
             xip_chiph_dim,
@@ -741,6 +732,9 @@ void MultiphotonBreitWheelerTables::computeXipTable( SmileiMPI *smpi )
     // flag computed at true
     xip_computed = true;
 
+    // Store the table for the next runs
+    cache.store( smpi, { &xip_chipamin_table, &xip_table } );
+
     // clean temporary arrays
     delete buffer;
     delete length_table;
@@ -20,6 +20,7 @@
 
 #include "Params.h"
 #include "H5.h"
+#include "Random.h"
 #include "userFunctions.h"
 
 //------------------------------------------------------------------------------
@@ -47,10 +48,11 @@ public:
     // PHYSICAL COMPUTATION
     // ---------------------------------------------------------------------
 
-    //! Computation of the production rate of pairs per photon
-    //! \param photon_chi photon quantum parameter
-    //! \param gamma photon normalized energy
-    double compute_dNBWdt( double photon_chi, double gamma );
+    //! Computation of the production rate of pairs per photon, for n photons (vectorized)
+    //! \param photon_chi photon quantum parameters
+    //! \param gamma photon normalized energies
+    //! \param rate production rates (output)
+    void compute_dNBWdt( int n, const double *photon_chi, const double *gamma, double *rate );
 
     //! Computation of the value T(photon_chi) using the approximated
     //! formula of Erber
@@ -78,9 +80,13 @@ public:
                                  double particle_chi, int nb_iterations, double eps );
 
     //! Computation of the electron and positron quantum parameters for
-    //! the multiphoton Breit-Wheeler pair creation
-    //! \param photon_chi photon quantum parameter
-    double *compute_pair_chi( double photon_chi );
+    //! the multiphoton Breit-Wheeler pair creation of n photons (vectorized)
+    //! \param photon_chi photon quantum parameters
+    //! \param electron_chi electron quantum parameters (output)
+    //! \param positron_chi positron quantum parameters (output)
+    //! \param rand_gen random number generator of the patch
+    void compute_pair_chi( int n, const double *photon_chi,
+                           double *electron_chi, double *positron_chi, Random *rand_gen );
 
     // ---------------------------------------------------------------------
     // TABLE COMPUTATION
@@ -161,6 +167,9 @@ private:
     //! Path to the tables
     std::string table_path_;
 
+    //! Path to the cache of computed tables (no cache if empty)
+    std::string table_cache_path_;
+
     //! Flag that activate the table computation
     bool compute_table_;
 
@@ -19,35 +19,6 @@
 
 using namespace std;
 
-namespace Rand
-{
-std::random_device device;
-std::mt19937 gen( device() );
-
-std::uniform_real_distribution<double> uniform_distribution( 0., 1. );
-double uniform()
-{
-    return uniform_distribution( gen );
-}
-
-std::uniform_real_distribution<double> uniform_distribution1( 0., 1.-1e-11 );
-double uniform1()
-{
-    return uniform_distribution1( gen );
-}
-
-std::uniform_real_distribution<double> uniform_distribution2( -1., 1. );
-double uniform2()
-{
-    return uniform_distribution2( gen );
-}
-double normal( double stddev )
-{
-    std::normal_distribution<double> normal_distribution( 0., stddev );
-    return normal_distribution( gen );
-}
-}
-
 #define DO_EXPAND(VAL)  VAL ## 1
 #define EXPAND(VAL)     DO_EXPAND(VAL)
 #ifdef SMILEI_USE_NUMPY
@@ -210,12 +181,11 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     }
 
     // random seed
-    if( PyTools::extract( "random_seed", random_seed, "Main" ) ) {
-        // Init of the seed for the vectorized C++ random generator recommended by Intel
-        // See https://software.intel.com/en-us/articles/random-number-function-vectorization
-        srand48( random_seed );
-        // Init of the seed for the C++ random generator
-        Rand::gen = std::mt19937( random_seed );
+    // The seed is the key of the per-patch random number generators,
+    // it must be identical on all MPI processes
+    if( ! PyTools::extract( "random_seed", random_seed, "Main" ) ) {
+        random_seed = std::random_device()();
+        MPI_Bcast( &random_seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD );
     }
 
     // communication pattern initialized as partial B exchange
@@ -415,6 +385,13 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "solve_poisson", solve_poisson, "Main" );
     PyTools::extract( "poisson_max_iteration", poisson_max_iteration, "Main" );
     PyTools::extract( "poisson_max_error", poisson_max_error, "Main" );
+    PyTools::extract( "poisson_solver", poisson_solver, "Main" );
+    if( poisson_solver != "CG" && poisson_solver != "pipelined_CG" ) {
+        ERROR( "Main.poisson_solver must be \"CG\" or \"pipelined_CG\"" );
+    }
+    if( poisson_solver == "pipelined_CG" && geometry == "AMcylindrical" ) {
+        ERROR( "Main.poisson_solver = \"pipelined_CG\" is not available in AMcylindrical geometry" );
+    }
     // Relativistic Poisson Solver
     PyTools::extract( "solve_relativistic_poisson", solve_relativistic_poisson, "Main" );
     PyTools::extract( "relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main" );
@@ -432,6 +409,10 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     if( maxwell_sol == "Lehe" ) {
         full_B_exchange=true;
     }
+    PyTools::extract( "fused_maxwell_solver", fused_maxwell_solver, "Main" );
+    if( fused_maxwell_solver && ( geometry != "3Dcartesian" || maxwell_sol != "Yee" || is_pxr || is_spectral ) ) {
+        ERROR( "Main.fused_maxwell_solver is only available with the Yee solver in 3Dcartesian geometry" );
+    }
 
     // Current filter properties
     currentFilter_passes = 0;
@@ -468,6 +449,23 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         }
     }
 
+    // Overlap of the sum of the currents with the Maxwell solver in the patch interiors
+    PyTools::extract( "overlap_maxwell", overlap_maxwell, "Main" );
+    if( overlap_maxwell ) {
+        if( geometry == "AMcylindrical" || maxwell_sol != "Yee" || is_pxr || is_spectral || fused_maxwell_solver ) {
+            ERROR( "Main.overlap_maxwell is only available with the Yee solver in cartesian geometries" );
+        }
+        if( currentFilter_passes > 0 || Friedman_filter || PyTools::nComponents( "Antenna" ) > 0 ) {
+            ERROR( "Main.overlap_maxwell is not compatible with current filters, field filters and antennas" );
+        }
+    }
+
+    // Exchange of particles with all the surrounding patches in a single pass
+    PyTools::extract( "single_pass_particle_exchange", single_pass_particle_exchange, "Main" );
+    if( single_pass_particle_exchange && geometry == "AMcylindrical" ) {
+        ERROR( "Main.single_pass_particle_exchange is not available in AMcylindrical geometry" );
+    }
+
 
     // testing the CFL condition
     //!\todo (MG) CFL cond. depends on the Maxwell solv. ==> HERE JUST DONE FOR YEE!!!
@@ -553,7 +551,13 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         PyTools::extract( "cell_load", cell_load, "LoadBalancing" );
         PyTools::extract( "frozen_particle_load", frozen_particle_load, "LoadBalancing" );
         PyTools::extract( "initial_balance", initial_balance, "LoadBalancing" );
+        PyTools::extract( "measured_load", measured_load, "LoadBalancing" );
+        PyTools::extract( "load_smoothing", load_smoothing, "LoadBalancing" );
+        if( load_smoothing <= 0. || load_smoothing > 1. ) {
+            ERROR( "LoadBalancing.load_smoothing = " << load_smoothing << " must be in ]0, 1]" );
+        }
     } else {
+        measured_load = false;
         load_balancing_time_selection = new TimeSelection();
     }
 
@@ -584,6 +588,8 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     vectorization_mode = "off";
     has_adaptive_vectorization = false;
     adaptive_vecto_time_selection = nullptr;
+    adaptive_cost_model = "fit";
+    adaptive_cost_model_file = "";
 
     if( PyTools::nComponents( "Vectorization" )>0 ) {
         // Extraction of the vectorization mode
@@ -611,6 +617,14 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
             ERROR( "In block `Vectorization`, parameter `default` must be `off` or `on`" );
         }
 
+        // Cost model used to choose between scalar and vectorized operators
+        PyTools::extract( "cost_model", adaptive_cost_model, "Vectorization" );
+        if( !( adaptive_cost_model == "fit" ||
+                adaptive_cost_model == "benchmark" ) ) {
+            ERROR( "In block `Vectorization`, parameter `cost_model` must be `fit` or `benchmark`" );
+        }
+        PyTools::extract( "cost_model_file", adaptive_cost_model_file, "Vectorization" );
+
         // get parameter "every" which describes a timestep selection
         if( ! adaptive_vecto_time_selection )
             adaptive_vecto_time_selection = new TimeSelection(
@@ -1035,6 +1049,9 @@ void Params::print_init()
         MESSAGE( 1, "Happens: " << load_balancing_time_selection->info() );
         MESSAGE( 1, "Cell load coefficient = " << cell_load );
         MESSAGE( 1, "Frozen particle load coefficient = " << frozen_particle_load );
+        if( measured_load ) {
+            MESSAGE( 1, "Particle loads measured, with smoothing coefficient = " << load_smoothing );
+        }
     }
 
     TITLE( "Vectorization: " );
@@ -31,25 +31,6 @@ class SmileiMPI;
 class Species;
 class Profile;
 
-namespace Rand
-{
-extern std::random_device device;
-extern std::mt19937 gen;
-
-extern std::uniform_real_distribution<double> uniform_distribution;
-extern double uniform();
-
-extern std::uniform_real_distribution<double> uniform_distribution1;
-extern double uniform1();
-
-extern std::uniform_real_distribution<double> uniform_distribution2;
-extern double uniform2();
-
-extern std::normal_distribution<double> normal_distribution;
-extern double normal( double stddev );
-}
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 //! Params class: holds all the properties of the simulation that are read from the input file
 // ---------------------------------------------------------------------------------------------------------------------
@@ -145,6 +126,8 @@ public:
     unsigned int poisson_max_iteration;
     //! Maxium poisson error tolerated
     double poisson_max_error;
+    //! Algorithm of the Poisson solver: "CG" or "pipelined_CG"
+    std::string poisson_solver;
     
     //"Relativistic" Poisson solver
     //! Do we solve "relativistic poisson problem" for relativistic species
@@ -160,6 +143,15 @@ public:
     //! Maxwell Solver (default='Yee')
     std::string maxwell_sol;
     
+    //! Save of B, Maxwell-Ampere and Maxwell-Faraday done in a single cache-blocked pass (3D Yee only)
+    bool fused_maxwell_solver;
+    
+    //! Interior of the patches advanced by the Maxwell solver while the currents are summed on the patch borders
+    bool overlap_maxwell;
+    
+    //! Particles exchanged with all the surrounding patches (diagonals included) in one pass, aggregated per MPI process
+    bool single_pass_particle_exchange;
+    
     //! Current spatial filter: number of binomial passes
     unsigned int currentFilter_passes;
     
@@ -243,6 +235,10 @@ public:
     double cell_load;
     //! Load coefficient applied to a frozen particle (default = 0.1)
     double frozen_particle_load;
+    //! Use the measured compute time of the particles of each patch instead of their number
+    bool measured_load;
+    //! Weight of the last measurement in the exponential average of the measured load
+    double load_smoothing;
     //! Return if number of patch = number of MPI process, to tune IO //ism
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
@@ -252,6 +248,10 @@ public:
     std::string vectorization_mode;
     //! Initial state of the patches in adaptive mode
     std::string adaptive_default_mode;
+    //! Cost model of the adaptive mode: "fit" (compiled) or "benchmark" (measured at startup)
+    std::string adaptive_cost_model;
+    //! File where the measured cost model is cached
+    std::string adaptive_cost_model_file;
     
     //! Tells whether there is a moving window
     bool hasWindow;
@@ -352,9 +352,9 @@ int ParticleCreator::create( std::vector<unsigned int> n_space_to_create,
                             }
                         }
                         if( !position_initialization_on_species_ ) {
-                            ParticleCreator::createPosition( position_initialization_, particles_, species_, nPart, iPart, indexes, params );
+                            ParticleCreator::createPosition( position_initialization_, particles_, species_, nPart, iPart, indexes, params, patch->rand_ );
                         }
-                        ParticleCreator::createMomentum( momentum_initialization_, particles_, species_,  nPart, iPart, temp, vel );
+                        ParticleCreator::createMomentum( momentum_initialization_, particles_, species_,  nPart, iPart, temp, vel, patch->rand_ );
                         
                         ParticleCreator::createWeight( position_initialization_, particles_, nPart, iPart, density( i, j, k ), params );
 
@@ -473,7 +473,7 @@ int ParticleCreator::create( std::vector<unsigned int> n_space_to_create,
                 temp[0] = temperature[0]( int_ijk[0], int_ijk[1], int_ijk[2] );
                 temp[1] = temperature[1]( int_ijk[0], int_ijk[1], int_ijk[2] );
                 temp[2] = temperature[2]( int_ijk[0], int_ijk[1], int_ijk[2] );
-                ParticleCreator::createMomentum( momentum_initialization_, particles_, species_, 1, ip, temp, vel );
+                ParticleCreator::createMomentum( momentum_initialization_, particles_, species_, 1, ip, temp, vel, patch->rand_ );
             } else {
                 for( unsigned int idim=0; idim < 3; idim++ ) {
                     particles_->momentum( idim, ip ) = momentum[idim][ippy]/species_->mass_ ;
@@ -536,7 +536,8 @@ void ParticleCreator::createPosition( std::string position_initialization,
                                     unsigned int nPart,
                                     unsigned int iPart,
                                     double *indexes,
-                                    Params &params )
+                                    Params &params,
+                                    Random * rand_gen )
 {
     if( position_initialization == "regular" ) {
 
@@ -623,7 +624,7 @@ void ParticleCreator::createPosition( std::string position_initialization,
                 for( unsigned int ir = 0 ; ir < Np_array[1]; ir++ ) {
                     double qr = indexes[1] + dr*( ir+0.5 );
                     int nr = ir*( Np_array[2] );
-                    theta_offset = Rand::uniform()*2.*M_PI;
+                    theta_offset = rand_gen->uniform()*2.*M_PI;
                     for( unsigned int itheta = 0 ; itheta < Np_array[2]; itheta++ ) {
                         int p = nx+nr+itheta+iPart;
                         double theta = theta_offset + itheta*dtheta;
@@ -639,16 +640,16 @@ void ParticleCreator::createPosition( std::string position_initialization,
         if( params.geometry=="AMcylindrical" ) {
             double particles_r, particles_theta;
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
-                particles->position( 0, p )=indexes[0]+Rand::uniform()*species->cell_length[0];
-                particles_r=sqrt( indexes[1]*indexes[1]+ 2.*Rand::uniform()*( indexes[1]+species->cell_length[1]*0.5 )*species->cell_length[1] );
-                particles_theta=Rand::uniform()*2.*M_PI;
+                particles->position( 0, p )=indexes[0]+rand_gen->uniform()*species->cell_length[0];
+                particles_r=sqrt( indexes[1]*indexes[1]+ 2.*rand_gen->uniform()*( indexes[1]+species->cell_length[1]*0.5 )*species->cell_length[1] );
+                particles_theta=rand_gen->uniform()*2.*M_PI;
                 particles->position( 2, p )=particles_r*sin( particles_theta );
                 particles->position( 1, p )= particles_r*cos( particles_theta );
             }
         } else {
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
                 for( unsigned int i=0; i<species->nDim_particle ; i++ ) {
-                    particles->position( i, p )=indexes[i]+Rand::uniform()*species->cell_length[i];
+                    particles->position( i, p )=indexes[i]+rand_gen->uniform()*species->cell_length[i];
                 }
             }
         }
@@ -673,7 +674,8 @@ void ParticleCreator::createMomentum( std::string momentum_initialization,
                                     unsigned int nPart,
                                     unsigned int iPart,
                                     double * temp,
-                                    double * vel )
+                                    double * vel,
+                                    Random * rand_gen )
 {
     // -------------------------------------------------------------------------
     // Particles
@@ -693,12 +695,12 @@ void ParticleCreator::createMomentum( std::string momentum_initialization,
         } else if( momentum_initialization == "maxwell-juettner" ) {
 
             // Sample the energies in the MJ distribution
-            std::vector<double> energies = maxwellJuttner( species, nPart, temp[0]/species->mass_ );
+            std::vector<double> energies = maxwellJuttner( species, nPart, temp[0]/species->mass_, rand_gen );
 
             // Sample angles randomly and calculate the momentum
             for( unsigned int p=iPart; p<iPart+nPart; p++ ) {
-                double phi   = acos( -Rand::uniform2() );
-                double theta = 2.0*M_PI*Rand::uniform();
+                double phi   = acos( -rand_gen->uniform2() );
+                double theta = 2.0*M_PI*rand_gen->uniform();
                 double psm = sqrt( pow( 1.0+energies[p-iPart], 2 )-1.0 );
 
                 particles->momentum( 0, p ) = psm*cos( theta )*sin( phi );
@@ -720,9 +722,9 @@ void ParticleCreator::createMomentum( std::string momentum_initialization,
 
             double t0 = sqrt( temp[0]/species->mass_ ), t1 = sqrt( temp[1]/species->mass_ ), t2 = sqrt( temp[2]/species->mass_ );
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
-                particles->momentum( 0, p ) = Rand::uniform2() * t0;
-                particles->momentum( 1, p ) = Rand::uniform2() * t1;
-                particles->momentum( 2, p ) = Rand::uniform2() * t2;
+                particles->momentum( 0, p ) = rand_gen->uniform2() * t0;
+                particles->momentum( 1, p ) = rand_gen->uniform2() * t1;
+                particles->momentum( 2, p ) = rand_gen->uniform2() * t2;
             }
         }
 
@@ -768,7 +770,7 @@ void ParticleCreator::createMomentum( std::string momentum_initialization,
                 CheckVelocity = ( vx*particles->momentum( 0, p )
                               + vy*particles->momentum( 1, p )
                               + vz*particles->momentum( 2, p ) ) * inverse_gamma;
-                Volume_Acc = Rand::uniform();
+                Volume_Acc = rand_gen->uniform();
                 if( CheckVelocity > Volume_Acc ) {
 
                     double Phi, Theta, vfl, vflx, vfly, vflz, vpx, vpy, vpz ;
@@ -824,9 +826,9 @@ void ParticleCreator::createMomentum( std::string momentum_initialization,
 
             //double gamma =sqrt(temp[0]*temp[0] + temp[1]*temp[1] + temp[2]*temp[2]);
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
-                particles->momentum( 0, p ) = Rand::uniform2()*temp[0];
-                particles->momentum( 1, p ) = Rand::uniform2()*temp[1];
-                particles->momentum( 2, p ) = Rand::uniform2()*temp[2];
+                particles->momentum( 0, p ) = rand_gen->uniform2()*temp[0];
+                particles->momentum( 1, p ) = rand_gen->uniform2()*temp[1];
+                particles->momentum( 2, p ) = rand_gen->uniform2()*temp[2];
             }
 
         }
@@ -896,7 +898,7 @@ void ParticleCreator::createCharge( Particles * particles, Species * species,
 // ---------------------------------------------------------------------------------------------------------------------
 //! Provides a Maxwell-Juttner distribution of energies
 // ---------------------------------------------------------------------------------------------------------------------
-std::vector<double> ParticleCreator::maxwellJuttner( Species * species, unsigned int npoints, double temperature )
+std::vector<double> ParticleCreator::maxwellJuttner( Species * species, unsigned int npoints, double temperature, Random * rand_gen )
 {
     if( temperature==0. ) {
         ERROR( "The species " << species->species_number_ << " is initializing its momentum with the following temperature : " << temperature );
@@ -911,7 +913,7 @@ std::vector<double> ParticleCreator::maxwellJuttner( Species * species, unsigned
         // For each particle
         for( unsigned int i=0; i<npoints; i++ ) {
             // Pick a random number
-            U = Rand::uniform();
+            U = rand_gen->uniform();
             // Calculate the inverse of F
             lnlnU = log( -log( U ) );
             if( lnlnU>2. ) {
@@ -940,7 +942,7 @@ std::vector<double> ParticleCreator::maxwellJuttner( Species * species, unsigned
         for( unsigned int i=0; i<npoints; i++ ) {
             do {
                 // Pick a random number
-                U = Rand::uniform();
+                U = rand_gen->uniform();
                 // Calculate the inverse of H at the point log(1.-U) + H0
                 lnU = log( -log( 1.-U ) - H0 );
                 if( lnU<-26. ) {
@@ -956,7 +958,7 @@ std::vector<double> ParticleCreator::maxwellJuttner( Species * species, unsigned
                 // Make a first guess for the value of gamma
                 gamma = temperature * invH;
                 // We use the rejection method, so we pick another random number
-                U = Rand::uniform();
+                U = rand_gen->uniform();
                 // And we are done only if U < beta, otherwise we try again
             } while( U >= sqrt( 1.-1./( gamma*gamma ) ) );
             // Store that value of the energy
@@ -19,6 +19,7 @@
 #include "Species.h"
 #include "ParticleInjector.h"
 #include "Field3D.h"
+#include "Random.h"
 
 class ParticleCreator
 {
@@ -48,7 +49,8 @@ public:
                               Particles * particles,
                               Species * species,
                               unsigned int nPart,
-                              unsigned int iPart, double *indexes, Params &params );
+                              unsigned int iPart, double *indexes, Params &params,
+                              Random * rand_gen );
     
     //! Creation of the particle momentum
     static void createMomentum( std::string momentum_initialization,
@@ -57,7 +59,8 @@ public:
                             unsigned int nPart,
                             unsigned int iPart,
                             double *temp,
-                            double *vel);
+                            double *vel,
+                            Random * rand_gen );
     
     //! Creation of the particle weight
     static void createWeight( std::string position_initialization,
@@ -113,7 +116,7 @@ public:
 private:
 
     //! Provides a Maxwell-Juttner distribution of energies
-    static std::vector<double> maxwellJuttner( Species * species, unsigned int npoints, double temperature );
+    static std::vector<double> maxwellJuttner( Species * species, unsigned int npoints, double temperature, Random * rand_gen );
     //! Array used in the Maxwell-Juttner sampling (see doc)
     static const double lnInvF[1000];
     //! Array used in the Maxwell-Juttner sampling (see doc)
@@ -22,6 +22,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "Hilbert_functions.h"
 #include "PatchesFactory.h"
@@ -32,6 +33,7 @@
 #include "ElectroMagnBC_Factory.h"
 #include "DiagnosticFactory.h"
 #include "CollisionsFactory.h"
+#include "DomainDecomposition.h"
 
 using namespace std;
 
@@ -47,6 +49,9 @@ Patch::Patch( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decom
 
     initStep1( params );
 
+    // Initialize the random number generator: one independent stream per patch
+    rand_ = new Random( params.random_seed, hindex, n_moved );
+
 #ifdef  __DETAILED_TIMERS
     // Initialize timers
     // 0 - Interpolation
@@ -80,6 +85,9 @@ Patch::Patch( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition
 
     initStep1( params );
 
+    // Initialize the random number generator (overwritten if the patch content is received from another process)
+    rand_ = new Random( params.random_seed, hindex, n_moved );
+
 #ifdef  __DETAILED_TIMERS
     // Initialize timers
     patch_timers.resize( 15, 0. );
@@ -112,15 +120,6 @@ void Patch::initStep1( Params &params )
         oversize[iDim] = params.oversize[iDim];
     }
 
-    // Initialize the state of the random number generator
-    xorshift32_state = params.random_seed;
-    // Ensure that the random seed is different for each patch
-    xorshift32_state += rand();
-    // zero is not acceptable for xorshift
-    if( xorshift32_state==0 ) {
-        xorshift32_state = 1073741824;
-    }
-
     // Obtain the cell_volume
     cell_volume = params.cell_volume;
 }
@@ -211,6 +210,40 @@ void Patch::finishCloning( Patch *patch, Params &params, SmileiMPI *smpi, unsign
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Recycle a patch which left the moving window as the patch ipatch entering it :
+//   it must have the same transverse coordinates, so that only the position along x changes
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::recycle( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
+{
+    hindex = ipatch;
+    initStep2( params, domain_decomposition );
+    // initStep3 accumulates the patch offset in cell_starting_global_index
+    cell_starting_global_index.assign( params.nDim_field, 0 );
+    initStep3( params, smpi, n_moved );
+
+    // Same random stream as a patch created at this position
+    *rand_ = Random( params.random_seed, hindex, n_moved );
+
+    measured_time_ = 0.;
+    smoothed_load_ = -1.;
+
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++ ) {
+        vecSpecies[ispec]->recycle( params, this );
+    }
+
+    EMfields->recycle( params, this );
+
+    delete probesInterp;
+    probesInterp = InterpolatorFactory::create( params, this, false );
+
+    // MPI datatypes do not depend on the patch position, they are created only once
+    if( has_an_MPI_neighbor() ) {
+        createType( params );
+    }
+
+}
+
 void Patch::finalizeMPIenvironment( Params &params )
 {
     int nb_comms( 9 ); // E, B, B_m : min number of comms
@@ -227,6 +260,14 @@ void Patch::finalizeMPIenvironment( Params &params )
     // add comms for species
     nb_comms += 2*vecSpecies.size();
 
+    // random number generator
+    nb_comms ++;
+
+    // measured load
+    if( params.measured_load ) {
+        nb_comms ++;
+    }
+
     // Adaptive vectorization:
     if( params.has_adaptive_vectorization ) {
         nb_comms += vecSpecies.size();
@@ -367,6 +408,8 @@ Patch::~Patch()
 {
 
     delete probesInterp;
+    
+    delete rand_;
 
     for( unsigned int i=0; i<probes.size(); i++ ) {
         delete probes[i];
@@ -535,6 +578,133 @@ void Patch::initExchParticles( SmileiMPI *smpi, int ispec, Params &params )
 } // initExchParticles(... iDim)
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Compute the Hilbert index and the MPI rank of the 3^ndim patches around (the patch itself included)
+// Recomputed at each exchange: the owners of the patches change with the load balancing
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::updateAllNeighbors( Params &params, DomainDecomposition *domain_decomposition, SmileiMPI *smpi )
+{
+    int ndim = params.nDim_field;
+    int nall = 1;
+    for( int idim=0 ; idim<ndim ; idim++ ) {
+        nall *= 3;
+    }
+    all_neighbors_.resize( nall );
+    MPI_all_neighbors_.resize( nall );
+
+    std::vector<int> xcall( ndim, 0 );
+    for( int k=0 ; k<nall ; k++ ) {
+        bool exists = true;
+        int stride = 1;
+        for( int idim=0 ; idim<ndim ; idim++ ) {
+            xcall[idim] = Pcoordinates[idim] + ( k/stride )%3 - 1;
+            if( params.EM_BCs[idim][0]=="periodic" ) {
+                if( xcall[idim] < 0 ) {
+                    xcall[idim] += domain_decomposition->ndomain_[idim];
+                } else if( xcall[idim] >= ( int )domain_decomposition->ndomain_[idim] ) {
+                    xcall[idim] -= domain_decomposition->ndomain_[idim];
+                }
+            } else if( xcall[idim] < 0 || xcall[idim] >= ( int )domain_decomposition->ndomain_[idim] ) {
+                exists = false;
+            }
+            stride *= 3;
+        }
+        if( exists ) {
+            all_neighbors_[k] = domain_decomposition->getDomainId( xcall );
+            // patch_refHindexes is sorted: binary search of the owner
+            MPI_all_neighbors_[k] = std::upper_bound( smpi->patch_refHindexes.begin(), smpi->patch_refHindexes.end(), all_neighbors_[k] )
+                                    - smpi->patch_refHindexes.begin() - 1;
+        } else {
+            all_neighbors_[k] = MPI_PROC_NULL;
+            MPI_all_neighbors_[k] = MPI_PROC_NULL;
+        }
+    }
+} // END updateAllNeighbors
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy the particles leaving the patch in the buffer of the patch where they arrive, diagonals included,
+// so that a single exchange is required (instead of one per direction)
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::initExchParticlesAllNeighbors( SmileiMPI *smpi, int ispec, Params &params )
+{
+    Particles &cuParticles = ( *vecSpecies[ispec]->particles );
+    SpeciesMPIbuffers &buffer = vecSpecies[ispec]->MPI_buffer_;
+    std::vector<int> &indexes_of_particles_to_exchange = vecSpecies[ispec]->indexes_of_particles_to_exchange;
+    int ndim = params.nDim_field;
+    int nall = buffer.partSendAll.size();
+    int center = ( nall-1 )/2;
+
+    for( int k=0 ; k<nall ; k++ ) {
+        buffer.partSendAll[k].clear();
+    }
+
+    double x_max[3];
+    for( int idim=0 ; idim<ndim ; idim++ ) {
+        x_max[idim] = params.cell_length[idim]*( params.n_space_global[idim] );
+    }
+
+    int n_part_send = indexes_of_particles_to_exchange.size();
+    for( int i=0 ; i<n_part_send ; i++ ) {
+        int iPart = indexes_of_particles_to_exchange[i];
+        int k = 0, stride = 1;
+        bool exists = true;
+        for( int idim=0 ; idim<ndim ; idim++ ) {
+            int offset = 0;
+            if( cuParticles.position( idim, iPart ) < min_local[idim] ) {
+                offset = -1;
+                exists = exists && ( neighbor_[idim][0]!=MPI_PROC_NULL );
+            } else if( cuParticles.position( idim, iPart ) >= max_local[idim] ) {
+                offset = 1;
+                exists = exists && ( neighbor_[idim][1]!=MPI_PROC_NULL );
+            }
+            k += ( offset+1 )*stride;
+            stride *= 3;
+        }
+        //If particle is outside of the global domain (has no neighbor), it is not copied and will simply be deleted.
+        if( !exists || k == center ) {
+            continue;
+        }
+        Particles &partSend = buffer.partSendAll[k];
+        cuParticles.cp_particle( iPart, partSend );
+        // Enabled periodicity
+        int iSend = partSend.size()-1;
+        for( int idim=0 ; idim<ndim ; idim++ ) {
+            if( smpi->periods_[idim]==1 ) {
+                if( ( Pcoordinates[idim] == 0 ) && ( partSend.position( idim, iSend ) < 0. ) ) {
+                    partSend.position( idim, iSend ) += x_max[idim];
+                } else if( ( Pcoordinates[idim] == params.number_of_patches[idim]-1 ) && ( partSend.position( idim, iSend ) >= x_max[idim] ) ) {
+                    partSend.position( idim, iSend ) -= x_max[idim];
+                }
+            }
+        }
+    }
+
+} // END initExchParticlesAllNeighbors
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Particles moving by an offset (ox, oy, oz) are stored in partRecv[idim][iNeighbor], where idim is the first
+// direction of non-zero offset: in Species::sortParticles, particles in partRecv[0] go to the first or last
+// bin, the others are binned according to their position
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::landingSlot( int ioffset, int ndim, int &iDim, int &iNeighbor )
+{
+    iDim = 0;
+    iNeighbor = 0;
+    for( int idim=0 ; idim<ndim ; idim++ ) {
+        int offset = ioffset%3 - 1;
+        ioffset /= 3;
+        if( offset != 0 ) {
+            iDim = idim;
+            // Moving toward +x, the particle comes from the xmin side of the receiver
+            iNeighbor = ( offset > 0 ) ? 0 : 1;
+            return;
+        }
+    }
+} // END landingSlot
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For direction iDim, start exchange of number of particles
 //   - vecPatch : used for intra-MPI process comm (direct copy using Particels::cp_particles)
@@ -653,6 +823,7 @@ void Patch::prepareParticles( SmileiMPI *smpi, int ispec, Params &params, int iD
 void Patch::exchParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim, VectorPatch *vecPatch )
 {
     int n_part_send, n_part_recv;
+    unsigned int packed_size = vecSpecies[ispec]->particles->packedSize();
 
     for( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
 
@@ -661,22 +832,25 @@ void Patch::exchParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim,
         if( ( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL ) && ( n_part_send!=0 ) ) {
             // Send particles
             if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
-                // Then send particles
+                // Then pack particles in the persistent byte buffer and send them
                 int local_hindex = hindex - vecPatch->refHindex_;
                 int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                vecSpecies[ispec]->typePartSend[( iDim*2 )+iNeighbor] = smpi->createMPIparticles( &( vecSpecies[ispec]->MPI_buffer_.partSend[iDim][iNeighbor] ) );
-                MPI_Isend( &( ( vecSpecies[ispec]->MPI_buffer_.partSend[iDim][iNeighbor] ).position( 0, 0 ) ), 1, vecSpecies[ispec]->typePartSend[( iDim*2 )+iNeighbor], MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ) );
+                std::vector<char> &bufferSend = vecSpecies[ispec]->MPI_buffer_.bufferSend[iDim][iNeighbor];
+                bufferSend.resize( ( size_t )n_part_send*packed_size );
+                vecSpecies[ispec]->MPI_buffer_.partSend[iDim][iNeighbor].pack( 0, n_part_send, bufferSend.data() );
+                MPI_Isend( bufferSend.data(), bufferSend.size(), MPI_BYTE, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ) );
             }
         } // END of Send
 
         n_part_recv = vecSpecies[ispec]->MPI_buffer_.part_index_recv_sz[iDim][( iNeighbor+1 )%2];
         if( ( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL ) && ( n_part_recv!=0 ) ) {
             if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
-                // If MPI comm, receive particles in the recv buffer previously initialized.
-                vecSpecies[ispec]->typePartRecv[( iDim*2 )+iNeighbor] = smpi->createMPIparticles( &( vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2] ) );
+                // If MPI comm, receive particles in the byte buffer, unpacked in the recv buffer by finalizeExchParticles
+                std::vector<char> &bufferRecv = vecSpecies[ispec]->MPI_buffer_.bufferRecv[iDim][( iNeighbor+1 )%2];
+                bufferRecv.resize( ( size_t )n_part_recv*packed_size );
                 int local_hindex = neighbor_[iDim][( iNeighbor+1 )%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][( iNeighbor+1 )%2] ];
                 int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Irecv( &( ( vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2] ).position( 0, 0 ) ), 1, vecSpecies[ispec]->typePartRecv[( iDim*2 )+iNeighbor], MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ) );
+                MPI_Irecv( bufferRecv.data(), bufferRecv.size(), MPI_BYTE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag, MPI_COMM_WORLD, &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ) );
             }
 
         } // END of Recv
@@ -711,13 +885,13 @@ void Patch::finalizeExchParticles( SmileiMPI *smpi, int ispec, Params &params, i
         if( ( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL ) && ( n_part_send!=0 ) ) {
             if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
                 MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.srequest[iDim][iNeighbor] ), &( sstat[iNeighbor] ) );
-                MPI_Type_free( &( vecSpecies[ispec]->typePartSend[( iDim*2 )+iNeighbor] ) );
             }
         }
         if( ( neighbor_[iDim][( iNeighbor+1 )%2]!=MPI_PROC_NULL ) && ( n_part_recv!=0 ) ) {
             if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
                 MPI_Wait( &( vecSpecies[ispec]->MPI_buffer_.rrequest[iDim][( iNeighbor+1 )%2] ), &( rstat[( iNeighbor+1 )%2] ) );
-                MPI_Type_free( &( vecSpecies[ispec]->typePartRecv[( iDim*2 )+iNeighbor] ) );
+                // The recv buffer has been initialized with n_part_recv particles by endNbrOfParticles
+                vecSpecies[ispec]->MPI_buffer_.partRecv[iDim][( iNeighbor+1 )%2].unpack( 0, n_part_recv, vecSpecies[ispec]->MPI_buffer_.bufferRecv[iDim][( iNeighbor+1 )%2].data() );
             }
         }
     }
@@ -854,10 +1028,16 @@ void Patch::cleanParticlesOverhead( Params &params )
                 vecSpecies[ispec]->MPI_buffer_.partRecv[idim][iNeighbor].shrink_to_fit( );
                 vecSpecies[ispec]->MPI_buffer_.partSend[idim][iNeighbor].clear();
                 vecSpecies[ispec]->MPI_buffer_.partSend[idim][iNeighbor].shrink_to_fit( );
+                vector<char>().swap( vecSpecies[ispec]->MPI_buffer_.bufferSend[idim][iNeighbor] );
+                vector<char>().swap( vecSpecies[ispec]->MPI_buffer_.bufferRecv[idim][iNeighbor] );
                 vecSpecies[ispec]->MPI_buffer_.part_index_send[idim][iNeighbor].clear();
                 vector<int>( vecSpecies[ispec]->MPI_buffer_.part_index_send[idim][iNeighbor] ).swap( vecSpecies[ispec]->MPI_buffer_.part_index_send[idim][iNeighbor] );
             }
         }
+        for( unsigned int k = 0; k < vecSpecies[ispec]->MPI_buffer_.partSendAll.size(); k++ ) {
+            vecSpecies[ispec]->MPI_buffer_.partSendAll[k].clear();
+            vecSpecies[ispec]->MPI_buffer_.partSendAll[k].shrink_to_fit( );
+        }
 
         cuParticles.shrink_to_fit(  );
     }
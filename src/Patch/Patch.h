@@ -8,6 +8,7 @@
 #include <limits.h>
 
 #include "Params.h"
+#include "Random.h"
 #include "SmileiMPI.h"
 #include "PartWall.h"
 #include "ParticleInjector.h"
@@ -46,6 +47,9 @@ public:
     void finishCreation( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition );
     //! Last cloning step
     void finishCloning( Patch *patch, Params &params, SmileiMPI *smpi, unsigned int n_moved, bool with_particles );
+    //! Re-use a patch which left the moving window as the new patch ipatch (cartesian geometries).
+    //! Fields, particle buffers and MPI datatypes are kept, only what depends on the patch position is re-initialized.
+    void recycle( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved );
     
     //! Finalize MPI environment : especially requests array for non blocking communications
     void finalizeMPIenvironment( Params &params );
@@ -98,19 +102,8 @@ public:
     std::vector<double> patch_timers;
 #endif
     
-    //! Random number generator
-    inline uint32_t xorshift32()
-    {
-        /* Algorithm "xor" from p. 4 of Marsaglia, "Xorshift RNGs" */
-        xorshift32_state ^= xorshift32_state << 13;
-        xorshift32_state ^= xorshift32_state >> 17;
-        xorshift32_state ^= xorshift32_state << 5;
-        return xorshift32_state;
-    }
-    //! State of the random number generator
-    uint32_t xorshift32_state;
-    //! Inverse of the maximum value of the random number generator
-    const double xorshift32_invmax = 1./4294967296.;
+    //! Random number generator of the patch
+    Random *rand_;
     
     // MPI exchange/sum methods for particles/fields
     //   - fields communication specified per geometry (pure virtual)
@@ -138,7 +131,21 @@ public:
     void cleanParticlesOverhead( Params &params );
     //! delete Particles included in the index of particles to exchange. Assumes indexes are sorted.
     void cleanupSentParticles( int ispec, std::vector<int> *indexes_of_particles_to_exchange );
-    
+
+    // Single-pass exchange of particles with the 3^ndim-1 surrounding patches (see SyncVectorPatch::exchangeParticlesAllNeighbors)
+    //! Compute the Hilbert index and the MPI rank of all the surrounding patches (diagonals included)
+    void updateAllNeighbors( Params &params, DomainDecomposition *domain_decomposition, SmileiMPI *smpi );
+    //! Copy the particles leaving the patch in the buffer of their destination (MPI_buffer_.partSendAll)
+    void initExchParticlesAllNeighbors( SmileiMPI *smpi, int ispec, Params &params );
+    //! Receive buffer in which land the particles moving by the offset ioffset (index in MPI_buffer_.partSendAll)
+    //! Chosen so that Species::sortParticles puts them in the right bins, as in the exchange per direction
+    static void landingSlot( int ioffset, int ndim, int &iDim, int &iNeighbor );
+
+    //! Hilbert index of the 3^ndim patches around (offset k = (ox+1) + 3*(oy+1) + 9*(oz+1)), MPI_PROC_NULL if none
+    std::vector<int> all_neighbors_;
+    //! MPI rank of the 3^ndim patches around
+    std::vector<int> MPI_all_neighbors_;
+
     //! init comm / sum densities
     virtual void initSumField( Field *field, int iDim, SmileiMPI *smpi ) = 0;
     //! finalize comm / sum densities
@@ -354,6 +361,11 @@ public:
     
     bool is_small = true;
     
+    //! Compute time of the particles of this patch since the last load balancing (LoadBalancing.measured_load)
+    double measured_time_ = 0.;
+    //! Exponential average of measured_time_ over the load balancing steps (negative if not measured yet)
+    double smoothed_load_ = -1.;
+    
     
     
 protected:
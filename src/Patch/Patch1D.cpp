@@ -19,25 +19,24 @@ using namespace std;
 Patch1D::Patch1D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
     : Patch( params, smpi, domain_decomposition, ipatch, n_moved )
 {
+    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
+        ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
+        ntypeSum_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        
+        ntype_complex_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        ntype_complex_[1][ix_isPrim] = MPI_DATATYPE_NULL;
+        
+        ntypeSum_complex_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        
+    }
+    
     if( !dynamic_cast<GlobalDomainDecomposition *>( domain_decomposition ) ) {
         initStep2( params, domain_decomposition );
         initStep3( params, smpi, n_moved );
         finishCreation( params, smpi, domain_decomposition );
     } else { // Cartesian
         // See void Patch::set( VectorPatch& vecPatch )
-        
-        for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
-            ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-            ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
-            ntypeSum_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-            
-            ntype_complex_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-            ntype_complex_[1][ix_isPrim] = MPI_DATATYPE_NULL;
-            
-            ntypeSum_complex_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-            
-        }
-        
     }
     
 } // End Patch1D::Patch1D
@@ -48,6 +47,18 @@ Patch1D::Patch1D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_d
 Patch1D::Patch1D( Patch1D *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved, bool with_particles = true )
     : Patch( patch, params, smpi, domain_decomposition, ipatch, n_moved, with_particles )
 {
+    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
+        ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
+        ntypeSum_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        
+        ntype_complex_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        ntype_complex_[1][ix_isPrim] = MPI_DATATYPE_NULL;
+        
+        ntypeSum_complex_[0][ix_isPrim] = MPI_DATATYPE_NULL;
+        
+    }
+    
     initStep2( params, domain_decomposition );
     initStep3( params, smpi, n_moved );
     finishCloning( patch, params, smpi, n_moved, with_particles );
@@ -76,12 +87,6 @@ void Patch1D::initStep2( Params &params, DomainDecomposition *domain_decompositi
     }
     neighbor_[0][1] = domain_decomposition->getDomainId( xcall );
     
-    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
-        ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-        ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
-        ntypeSum_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-    }
-    
 }
 
 Patch1D::~Patch1D()
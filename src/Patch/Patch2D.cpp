@@ -19,30 +19,29 @@ using namespace std;
 Patch2D::Patch2D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
     : Patch( params, smpi, domain_decomposition, ipatch, n_moved )
 {
+    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
+        for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
+            ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            
+            ntype_complex_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_complex_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_complex_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_complex_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_complex_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            
+        }
+    }
+    
     if( !dynamic_cast<GlobalDomainDecomposition *>( domain_decomposition ) ) {
         initStep2( params, domain_decomposition );
         initStep3( params, smpi, n_moved );
         finishCreation( params, smpi, domain_decomposition );
     } else { // Cartesian
         // See void Patch::set( VectorPatch& vecPatch )
-        
-        for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
-            for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
-                ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntype_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntype_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                
-                ntype_complex_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntype_complex_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntype_complex_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_complex_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_complex_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-                
-            }
-        }
-        
     }
     
 } // End Patch2D::Patch2D
@@ -54,6 +53,23 @@ Patch2D::Patch2D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_d
 Patch2D::Patch2D( Patch2D *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved, bool with_particles = true )
     : Patch( patch, params, smpi, domain_decomposition, ipatch, n_moved, with_particles )
 {
+    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
+        for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
+            ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            
+            ntype_complex_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_complex_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntype_complex_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_complex_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            ntypeSum_complex_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
+            
+        }
+    }
+    
     initStep2( params, domain_decomposition );
     initStep3( params, smpi, n_moved );
     finishCloning( patch, params, smpi, n_moved, with_particles );
@@ -99,15 +115,6 @@ void Patch2D::initStep2( Params &params, DomainDecomposition *domain_decompositi
     }
     neighbor_[1][1] = domain_decomposition->getDomainId( xcall );
     
-    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
-        for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
-            ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            ntype_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            ntype_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            ntypeSum_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            ntypeSum_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-        }
-    }
     //cout << endl;
     //cout << "Nei\t"  << "\t" << neighbor_[1][1] << endl;
     //cout << "Nei\t"  << neighbor_[0][0] << "\t" << hindex << "\t" << neighbor_[0][1] << endl;
@@ -19,33 +19,32 @@ using namespace std;
 Patch3D::Patch3D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
     : Patch( params, smpi, domain_decomposition, ipatch, n_moved )
 {
+    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
+        for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
+            for( int iz_isPrim=0 ; iz_isPrim<2 ; iz_isPrim++ ) {
+                ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                
+                ntype_complex_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_complex_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_complex_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_complex_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_complex_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_complex_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+            }
+        }
+    }
+    
     if( !dynamic_cast<GlobalDomainDecomposition *>( domain_decomposition ) ) {
         initStep2( params, domain_decomposition );
         initStep3( params, smpi, n_moved );
         finishCreation( params, smpi, domain_decomposition );
     } else { // Cartesian
         // See void Patch::set( VectorPatch& vecPatch )
-        
-        for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
-            for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
-                for( int iz_isPrim=0 ; iz_isPrim<2 ; iz_isPrim++ ) {
-                    ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    
-                    ntype_complex_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntype_complex_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntype_complex_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntypeSum_complex_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntypeSum_complex_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                    ntypeSum_complex_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                }
-            }
-        }
-        
     }
     
 } // End Patch3D::Patch3D
@@ -57,6 +56,26 @@ Patch3D::Patch3D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_d
 Patch3D::Patch3D( Patch3D *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved, bool with_particles = true )
     : Patch( patch, params, smpi, domain_decomposition, ipatch, n_moved, with_particles )
 {
+    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
+        for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
+            for( int iz_isPrim=0 ; iz_isPrim<2 ; iz_isPrim++ ) {
+                ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                
+                ntype_complex_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_complex_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntype_complex_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_complex_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_complex_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+                ntypeSum_complex_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
+            }
+        }
+    }
+    
     initStep2( params, domain_decomposition );
     initStep3( params, smpi, n_moved );
     finishCloning( patch, params, smpi, n_moved, with_particles );
@@ -125,20 +144,6 @@ void Patch3D::initStep2( Params &params, DomainDecomposition *domain_decompositi
     }
     neighbor_[2][1] =  domain_decomposition->getDomainId( xcall );
     
-    for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
-        for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
-            for( int iz_isPrim=0 ; iz_isPrim<2 ; iz_isPrim++ ) {
-                ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
-                
-            }
-        }
-    }
-    
 }
 
 
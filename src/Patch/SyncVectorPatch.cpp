@@ -2,6 +2,9 @@
 #include "SyncVectorPatch.h"
 
 #include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstring>
 
 #include "VectorPatch.h"
 #include "Params.h"
@@ -23,6 +26,15 @@ template void SyncVectorPatch::exchange_along_all_directions_noomp<complex<doubl
 
 void SyncVectorPatch::exchangeParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
 {
+    // Particles only copied in their send buffers, the communications are done in exchangeParticlesAllNeighbors
+    if( params.single_pass_particle_exchange ) {
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            vecPatches( ipatch )->initExchParticlesAllNeighbors( smpi, ispec, params );
+        }
+        return;
+    }
+
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
         vecPatches( ipatch )->initExchParticles( smpi, ispec, params );
@@ -47,10 +59,13 @@ void SyncVectorPatch::exchangeParticles( VectorPatch &vecPatches, int ispec, Par
 // ---------------------------------------------------------------------------------------------------------------------
 void SyncVectorPatch::finalizeAndSortParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
 {
-    SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, 0, params, smpi, timers, itime );
+    // With the single-pass exchange, particles already received by exchangeParticlesAllNeighbors
+    if( !params.single_pass_particle_exchange ) {
+        SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, 0, params, smpi, timers, itime );
+    }
 
     // Per direction
-    for( unsigned int iDim=1 ; iDim<params.nDim_field ; iDim++ ) {
+    for( unsigned int iDim=1 ; iDim<params.nDim_field && !params.single_pass_particle_exchange ; iDim++ ) {
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(runtime)
 #else
@@ -143,16 +158,216 @@ void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int is
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Exchange of the particles of all species with all the surrounding patches (diagonals included) at once.
+//! Particles have been copied in the buffers of their destination patch by Patch::initExchParticlesAllNeighbors.
+//!  - within the process, each patch copies the particles sent by its neighbours (no concurrent writes)
+//!  - between processes, all the particles sent to a process are packed in a single message
+//! Received particles are stored in MPI_buffer_.partRecv so that they are sorted by Species::sortParticles.
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::exchangeParticlesAllNeighbors( VectorPatch &vecPatches, Params &params, SmileiMPI *smpi )
+{
+    ParticleExchangeBuffers &buffers = vecPatches.particle_exchange_;
+    int ndim = params.nDim_field;
+    int h0 = vecPatches( 0 )->hindex;
+    int me = smpi->getRank();
+    unsigned int nspec = vecPatches( 0 )->vecSpecies.size();
+    MPI_Comm comm = smpi->getParticlesComm();
+    const size_t header_size = sizeof( ParticleExchangeBuffers::Header );
+
+    std::vector<unsigned int> packed_size( nspec );
+    for( unsigned int ispec=0 ; ispec<nspec ; ispec++ ) {
+        packed_size[ispec] = vecPatches( 0 )->vecSpecies[ispec]->particles->packedSize();
+    }
+
+    // Neighbours of all patches (their owners change with the load balancing)
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->updateAllNeighbors( params, vecPatches.domain_decomposition_, smpi );
+    }
+    int nall = vecPatches( 0 )->all_neighbors_.size();
+
+    // List of the processes to communicate with (the same on both sides)
+    #pragma omp single
+    {
+        buffers.ranks_.clear();
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            for( int k=0 ; k<nall ; k++ ) {
+                int rank = vecPatches( ipatch )->MPI_all_neighbors_[k];
+                if( rank != MPI_PROC_NULL && rank != me ) {
+                    buffers.ranks_.push_back( rank );
+                }
+            }
+        }
+        std::sort( buffers.ranks_.begin(), buffers.ranks_.end() );
+        buffers.ranks_.erase( std::unique( buffers.ranks_.begin(), buffers.ranks_.end() ), buffers.ranks_.end() );
+
+        unsigned int nranks = buffers.ranks_.size();
+        buffers.send_sizes_.resize( nranks );
+        buffers.recv_sizes_.resize( nranks );
+        buffers.send_buffers_.resize( nranks );
+        buffers.recv_buffers_.resize( nranks );
+        buffers.requests_.resize( 2*nranks );
+        buffers.patch_packets_.resize( vecPatches.size() );
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            buffers.patch_packets_[ipatch].clear();
+        }
+    }
+
+    // Pack the message sent to each process
+    #pragma omp for schedule(dynamic)
+    for( unsigned int irank=0 ; irank<buffers.ranks_.size() ; irank++ ) {
+        int rank = buffers.ranks_[irank];
+        uint64_t size = 0;
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            for( int k=0 ; k<nall ; k++ ) {
+                if( vecPatches( ipatch )->MPI_all_neighbors_[k] == rank ) {
+                    for( unsigned int ispec=0 ; ispec<nspec ; ispec++ ) {
+                        uint64_t n = vecPatches( ipatch )->vecSpecies[ispec]->MPI_buffer_.partSendAll[k].size();
+                        if( n > 0 ) {
+                            size += header_size + n*packed_size[ispec];
+                        }
+                    }
+                }
+            }
+        }
+        buffers.send_sizes_[irank] = size;
+        buffers.send_buffers_[irank].resize( size );
+
+        char *data = buffers.send_buffers_[irank].data();
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            for( int k=0 ; k<nall ; k++ ) {
+                if( vecPatches( ipatch )->MPI_all_neighbors_[k] == rank ) {
+                    for( unsigned int ispec=0 ; ispec<nspec ; ispec++ ) {
+                        Particles &partSend = vecPatches( ipatch )->vecSpecies[ispec]->MPI_buffer_.partSendAll[k];
+                        if( partSend.size() > 0 ) {
+                            ParticleExchangeBuffers::Header header;
+                            header.hindex  = vecPatches( ipatch )->all_neighbors_[k];
+                            header.ispec   = ispec;
+                            header.ioffset = k;
+                            header.n       = partSend.size();
+                            memcpy( data, &header, header_size );
+                            data += header_size;
+                            partSend.pack( 0, header.n, data );
+                            data += header.n*packed_size[ispec];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Exchange the sizes, then the messages
+    #pragma omp single
+    {
+        unsigned int nranks = buffers.ranks_.size();
+        for( unsigned int irank=0 ; irank<nranks ; irank++ ) {
+            MPI_Irecv( &buffers.recv_sizes_[irank], 1, MPI_UINT64_T, buffers.ranks_[irank], 0, comm, &buffers.requests_[2*irank] );
+            MPI_Isend( &buffers.send_sizes_[irank], 1, MPI_UINT64_T, buffers.ranks_[irank], 0, comm, &buffers.requests_[2*irank+1] );
+        }
+        MPI_Waitall( 2*nranks, buffers.requests_.data(), MPI_STATUSES_IGNORE );
+
+        for( unsigned int irank=0 ; irank<nranks ; irank++ ) {
+            if( buffers.recv_sizes_[irank] > INT_MAX || buffers.send_sizes_[irank] > INT_MAX ) {
+                ERROR( "Particle exchange between processes " << me << " and " << buffers.ranks_[irank] << " exceeds 2GB: use more processes" );
+            }
+            buffers.requests_[2*irank  ] = MPI_REQUEST_NULL;
+            buffers.requests_[2*irank+1] = MPI_REQUEST_NULL;
+            buffers.recv_buffers_[irank].resize( buffers.recv_sizes_[irank] );
+            if( buffers.recv_sizes_[irank] > 0 ) {
+                MPI_Irecv( buffers.recv_buffers_[irank].data(), buffers.recv_sizes_[irank], MPI_BYTE, buffers.ranks_[irank], 1, comm, &buffers.requests_[2*irank] );
+            }
+            if( buffers.send_sizes_[irank] > 0 ) {
+                MPI_Isend( buffers.send_buffers_[irank].data(), buffers.send_sizes_[irank], MPI_BYTE, buffers.ranks_[irank], 1, comm, &buffers.requests_[2*irank+1] );
+            }
+        }
+    }
+
+    // Meanwhile, each patch gets the particles sent by the patches of the same process
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        for( unsigned int ispec=0 ; ispec<nspec ; ispec++ ) {
+            SpeciesMPIbuffers &buffer = patch->vecSpecies[ispec]->MPI_buffer_;
+            for( int idim=0 ; idim<ndim ; idim++ ) {
+                for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                    buffer.partRecv[idim][iNeighbor].clear();
+                }
+            }
+            for( int k=0 ; k<nall ; k++ ) {
+                if( patch->all_neighbors_[k] == MPI_PROC_NULL || patch->MPI_all_neighbors_[k] != me ) {
+                    continue;
+                }
+                // The neighbour at offset k sent its particles with the opposite offset
+                int ioffset = nall-1-k;
+                Particles &partSend = vecPatches( patch->all_neighbors_[k]-h0 )->vecSpecies[ispec]->MPI_buffer_.partSendAll[ioffset];
+                int idim, iNeighbor;
+                Patch::landingSlot( ioffset, ndim, idim, iNeighbor );
+                Particles &partRecv = buffer.partRecv[idim][iNeighbor];
+                partSend.cp_particles( 0, partSend.size(), partRecv, partRecv.size() );
+            }
+        }
+    }
+
+    // Find the packets of each local patch in the received messages
+    #pragma omp single
+    {
+        MPI_Waitall( buffers.requests_.size(), buffers.requests_.data(), MPI_STATUSES_IGNORE );
+        for( unsigned int irank=0 ; irank<buffers.ranks_.size() ; irank++ ) {
+            const char *data = buffers.recv_buffers_[irank].data();
+            const char *end  = data + buffers.recv_sizes_[irank];
+            while( data < end ) {
+                ParticleExchangeBuffers::Packet packet;
+                memcpy( &packet.header, data, header_size );
+                packet.data = data + header_size;
+                buffers.patch_packets_[packet.header.hindex-h0].push_back( packet );
+                data += header_size + ( uint64_t )packet.header.n*packed_size[packet.header.ispec];
+            }
+        }
+    }
+
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        for( unsigned int ipacket=0 ; ipacket<buffers.patch_packets_[ipatch].size() ; ipacket++ ) {
+            ParticleExchangeBuffers::Packet &packet = buffers.patch_packets_[ipatch][ipacket];
+            int idim, iNeighbor;
+            Patch::landingSlot( packet.header.ioffset, ndim, idim, iNeighbor );
+            patch->vecSpecies[packet.header.ispec]->MPI_buffer_.partRecv[idim][iNeighbor].unpack( packet.header.n, packet.data );
+        }
+        for( unsigned int ispec=0 ; ispec<nspec ; ispec++ ) {
+            SpeciesMPIbuffers &buffer = patch->vecSpecies[ispec]->MPI_buffer_;
+            for( int idim=0 ; idim<ndim ; idim++ ) {
+                for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                    buffer.part_index_recv_sz[idim][iNeighbor] = buffer.partRecv[idim][iNeighbor].size();
+                }
+            }
+        }
+    }
+
+    // Send buffers of the local patches are no longer needed
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        for( unsigned int ispec=0 ; ispec<nspec ; ispec++ ) {
+            std::vector<Particles> &partSendAll = vecPatches( ipatch )->vecSpecies[ispec]->MPI_buffer_.partSendAll;
+            for( unsigned int k=0 ; k<partSendAll.size() ; k++ ) {
+                partSendAll[k].clear();
+            }
+        }
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // ----------------------------------------------       DENSITIES         ----------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
-void SyncVectorPatch::sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime )
+void SyncVectorPatch::sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime, bool solve_maxwell_interior )
 {
     // Sum Jx, Jy and Jz
-    SyncVectorPatch::sumAllComponents( vecPatches.densities, vecPatches, smpi, timers, itime );
+    SyncVectorPatch::sumAllComponents( vecPatches.densities, vecPatches, smpi, timers, itime, solve_maxwell_interior );
     // Sum rho
     if( ( vecPatches.diag_flag ) || ( params.is_spectral ) ) {
         SyncVectorPatch::sum<double,Field>( vecPatches.listrho_, vecPatches, smpi, timers, itime );
@@ -228,7 +443,7 @@ void SyncVectorPatch::sumRhoJs( Params &params, VectorPatch &vecPatches, int imo
 //         - ... for Y and Z
 //     - These fields are identified with lists of index MPIxIdx and LocalxIdx (... for Y and Z)
 // timers and itime were here introduced for debugging
-void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime )
+void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime, bool solve_maxwell_interior )
 {
     unsigned int h0, oversize[3], n_space[3];
     double *pt1, *pt2;
@@ -299,6 +514,14 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
         }
     }
 
+    // iDim = 0, advance a part of the patch interiors while the messages are in flight
+    if( solve_maxwell_interior ) {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            vecPatches( ipatch )->EMfields->solveMaxwellInterior( 0, nDim );
+        }
+    }
+
     // iDim = 0, finalize (waitall)
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(static)
@@ -373,6 +596,14 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
             }
         }
 
+        // iDim = 1, advance a part of the patch interiors while the messages are in flight
+        if( solve_maxwell_interior ) {
+            #pragma omp for schedule(static)
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                vecPatches( ipatch )->EMfields->solveMaxwellInterior( 1, nDim );
+            }
+        }
+
         // iDim = 1, finalize (waitall)
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
@@ -448,6 +679,14 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
                 }
             }
 
+            // iDim = 2, advance a part of the patch interiors while the messages are in flight
+            if( solve_maxwell_interior ) {
+                #pragma omp for schedule(static)
+                for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                    vecPatches( ipatch )->EMfields->solveMaxwellInterior( 2, nDim );
+                }
+            }
+
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
 #ifndef _NO_MPI_TM
             #pragma omp for schedule(static)
@@ -20,9 +20,11 @@ public :
     static void exchangeParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
     static void finalizeAndSortParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
     static void finalizeExchangeParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
+    //! Particles synchronization of all species with all the surrounding patches at once, one message per MPI process
+    static void exchangeParticlesAllNeighbors( VectorPatch &vecPatches, Params &params, SmileiMPI *smpi );
 
     //! Densities synchronization
-    static void sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
+    static void sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime, bool solve_maxwell_interior = false );
     //! Densities synchronization per mode
     static void sumRhoJ( Params &params, VectorPatch &vecPatches, int imode, SmileiMPI *smpi, Timers &timers, int itime );
     //! Densities synchronization per species
@@ -258,7 +260,7 @@ public :
 
     }
 
-    static void sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
+    static void sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime, bool solve_maxwell_interior = false );
 
     void templateGenerator();
 
@@ -12,6 +12,8 @@
 #include "DomainDecompositionFactory.h"
 #include "PatchesFactory.h"
 #include "Species.h"
+#include "SpeciesV.h"
+#include "SpeciesMetrics.h"
 #include "Particles.h"
 #include "PeekAtSpecies.h"
 #include "SimWindow.h"
@@ -231,6 +233,81 @@ void VectorPatch::configuration( Params &params, Timers &timers, int itime )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Replace the compiled cost model of the adaptive vectorization by times
+// measured on this machine, or read from the cache file
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::calibrateVectorization( Params &params, SmileiMPI *smpi )
+{
+    if( ! params.has_adaptive_vectorization || params.adaptive_cost_model != "benchmark" ) {
+        return;
+    }
+    
+    TITLE( "Calibrating the adaptive vectorization" );
+    
+    // The benchmark uses the first species that projects currents
+    Patch *patch = ( *this )( 0 );
+    SpeciesV *spec = NULL;
+    for( unsigned int ispec=0 ; ispec<patch->vecSpecies.size() ; ispec++ ) {
+        Species *s = patch->vecSpecies[ispec];
+        if( s->mass_ > 0 && ! s->particles->is_test && ! s->ponderomotive_dynamics ) {
+            spec = dynamic_cast<SpeciesV *>( s );
+            break;
+        }
+    }
+    if( ! spec ) {
+        WARNING( "No species can be used to calibrate the adaptive vectorization: the compiled cost model is kept" );
+        return;
+    }
+    
+    // The cached fits are only valid for the same configuration
+    std::string key = SpeciesMetrics::fitKey( params.geometry, params.interpolation_order, spec->name_, spec->pusher_name_ );
+    
+    // All processes must agree on reading the cache file
+    if( params.adaptive_cost_model_file != "" ) {
+        int found = SpeciesMetrics::readFit( params.adaptive_cost_model_file, key ) ? 1 : 0;
+        int found_everywhere;
+        MPI_Allreduce( &found, &found_everywhere, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD );
+        if( found_everywhere ) {
+            MESSAGE( 1, "Cost model read from " << params.adaptive_cost_model_file );
+            return;
+        }
+        MESSAGE( 1, "Cost model file " << params.adaptive_cost_model_file
+                 << " missing, unreadable by some process or not matching " << key );
+    }
+    
+    MESSAGE( 1, "Timing the operators of species " << spec->name_ );
+    
+    std::vector<double> log_particle_number, vecto_time, scalar_time;
+    for( unsigned int particles_per_cell=1 ; particles_per_cell<=256 ; particles_per_cell*=2 ) {
+        log_particle_number.push_back( log( ( double ) particles_per_cell ) );
+        scalar_time.push_back( spec->benchmarkOperators( params, patch, smpi, particles_per_cell, false ) );
+        vecto_time .push_back( spec->benchmarkOperators( params, patch, smpi, particles_per_cell, true ) );
+    }
+    
+    // Average over all processes
+    unsigned int n = log_particle_number.size();
+    MPI_Allreduce( MPI_IN_PLACE, &scalar_time[0], n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( MPI_IN_PLACE, &vecto_time [0], n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    for( unsigned int i=0 ; i<n ; i++ ) {
+        scalar_time[i] /= smpi->getSize();
+        vecto_time [i] /= smpi->getSize();
+        MESSAGE( 2, std::setw( 3 ) << ( 1<<i ) << " particles per cell: "
+                 << std::scientific << std::setprecision( 3 ) << scalar_time[i] << " s (scalar), "
+                 << vecto_time[i] << " s (vectorized) per particle" );
+    }
+    
+    SpeciesMetrics::fit( log_particle_number, vecto_time, scalar_time );
+    
+    // Currents projected by the benchmark are discarded
+    patch->EMfields->restartRhoJ();
+    
+    if( params.adaptive_cost_model_file != "" && smpi->isMaster() ) {
+        SpeciesMetrics::writeFit( params.adaptive_cost_model_file, key );
+        MESSAGE( 1, "Cost model written in " << params.adaptive_cost_model_file );
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Reconfigure all patches for the new time step
 // ---------------------------------------------------------------------------------------------------------------------
@@ -313,6 +390,7 @@ void VectorPatch::dynamics( Params &params,
     ostringstream t;
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        double load_start = params.measured_load ? MPI_Wtime() : 0.;
         ( *this )( ipatch )->EMfields->restartRhoJ();
         //MESSAGE("restart rhoj");
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
@@ -354,6 +432,9 @@ void VectorPatch::dynamics( Params &params,
             } // end if condition on species
         } // end loop on species
         //MESSAGE("species dynamics");
+        if( params.measured_load ) {
+            ( *this )( ipatch )->measured_time_ += MPI_Wtime() - load_start;
+        }
     } // end loop on patches
 
 
@@ -446,6 +527,11 @@ void VectorPatch::finalizeAndSortParticles( Params &params, SmileiMPI *smpi, Sim
     // Particle synchronization and sorting
     // ----------------------------------------
 
+    // All species exchanged at once
+    if( params.single_pass_particle_exchange ) {
+        SyncVectorPatch::exchangeParticlesAllNeighbors( ( *this ), params, smpi );
+    }
+
     for( unsigned int ispec=0 ; ispec<( *this )( 0 )->vecSpecies.size(); ispec++ ) {
         if( ( *this )( 0 )->vecSpecies[ispec]->isProj( time_dual, simWindow ) ) {
             SyncVectorPatch::finalizeAndSortParticles( ( *this ), ispec, params, smpi, timers, itime ); // Included sortParticles
@@ -836,6 +922,18 @@ void VectorPatch::resetRhoJ()
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// The Maxwell solver is split around the sum of the currents only in the main loop (not at initialization)
+// ---------------------------------------------------------------------------------------------------------------------
+bool VectorPatch::overlapMaxwell( Params &params, int itime, double time_dual )
+{
+#ifdef _PICSAR
+    return false;
+#else
+    return params.overlap_maxwell && itime > 0 && time_dual > params.time_fields_frozen;
+#endif
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all patch, sum densities on ghost cells (sum per species if needed, sync per patch and MPI sync)
 // ---------------------------------------------------------------------------------------------------------------------
@@ -848,7 +946,15 @@ void VectorPatch::sumDensities( Params &params, double time_dual, Timers &timers
             some_particles_are_moving = true;
         }
     }
+    bool solve_maxwell_interior = overlapMaxwell( params, itime, time_dual );
     if( !some_particles_are_moving  && !diag_flag ) {
+        if( solve_maxwell_interior ) {
+            // No sum to overlap, but solveMaxwell expects the interior to be done
+            #pragma omp for schedule(static)
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->solveMaxwellInterior( 0, 1 );
+            }
+        }
         return;
     }
 
@@ -864,7 +970,7 @@ void VectorPatch::sumDensities( Params &params, double time_dual, Timers &timers
 
     timers.syncDens.restart();
     if( params.geometry != "AMcylindrical" ) {
-        SyncVectorPatch::sumRhoJ( params, ( *this ), smpi, timers, itime ); // MPI
+        SyncVectorPatch::sumRhoJ( params, ( *this ), smpi, timers, itime, solve_maxwell_interior ); // MPI
     } else {
         for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->Jl_.size() ; imode++ ) {
             SyncVectorPatch::sumRhoJ( params, ( *this ), imode, smpi, timers, itime );
@@ -968,9 +1074,16 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
             }
         }
     }
+    bool interior_solved = overlapMaxwell( params, itime, time_dual );
     #pragma omp for schedule(static)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        if( !params.is_spectral ) {
+        if( interior_solved ) {
+            // B_m was stored and the interior was advanced during the sum of the currents (see sumDensities)
+            ( *this )( ipatch )->EMfields->solveMaxwellBorders();
+            continue;
+        }
+        // The fused Maxwell solver stores B_m itself
+        if( !params.is_spectral && !params.fused_maxwell_solver ) {
             // Saving magnetic fields (to compute centered fields used in the particle pusher)
             // Stores B at time n in B_m.
             ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
@@ -1312,66 +1425,70 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     // compute control parameter
     double ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
 
-    // ---------------------------------------------------------
-    // Starting iterative loop for the conjugate gradient method
-    // ---------------------------------------------------------
-    if( smpi->isMaster() ) {
-        DEBUG( "Starting iterative loop for CG method" );
-    }
-    while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
-        iteration++;
+    if( params.poisson_solver == "pipelined_CG" ) {
+        solvePoissonPipelinedCG( params, smpi, nx_p2_global, iteration, ctrl );
+    } else {
+        // ---------------------------------------------------------
+        // Starting iterative loop for the conjugate gradient method
+        // ---------------------------------------------------------
         if( smpi->isMaster() ) {
-            DEBUG( "iteration " << iteration << " started with control parameter ctrl = " << ctrl*1.e14 << " x 1e-14" );
+            DEBUG( "Starting iterative loop for CG method" );
         }
+        while( ( ctrl > error_max ) && ( iteration<iteration_max ) ) {
+            iteration++;
+            if( smpi->isMaster() ) {
+                DEBUG( "iteration " << iteration << " started with control parameter ctrl = " << ctrl*1.e14 << " x 1e-14" );
+            }
 
-        // scalar product of the residual
-        double r_dot_r = rnew_dot_rnew;
+            // scalar product of the residual
+            double r_dot_r = rnew_dot_rnew;
 
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
-        }
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
+            }
 
-        // Exchange Ap_ (intra & extra MPI)
-        SyncVectorPatch::exchange_along_all_directions<double,Field>( Ap_, *this, smpi );
-        SyncVectorPatch::finalize_exchange_along_all_directions( Ap_, *this );
+            // Exchange Ap_ (intra & extra MPI)
+            SyncVectorPatch::exchange_along_all_directions<double,Field>( Ap_, *this, smpi );
+            SyncVectorPatch::finalize_exchange_along_all_directions( Ap_, *this );
 
-        // scalar product p.Ap
-        double p_dot_Ap       = 0.0;
-        double p_dot_Ap_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            p_dot_Ap_local += ( *this )( ipatch )->EMfields->compute_pAp();
-        }
-        MPI_Allreduce( &p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            // scalar product p.Ap
+            double p_dot_Ap       = 0.0;
+            double p_dot_Ap_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                p_dot_Ap_local += ( *this )( ipatch )->EMfields->compute_pAp();
+            }
+            MPI_Allreduce( &p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
 
 
-        // compute new potential and residual
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
-        }
+            // compute new potential and residual
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            }
 
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
-        }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
-        if( smpi->isMaster() ) {
-            DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
-        }
+            // compute new residual norm
+            rnew_dot_rnew       = 0.0;
+            rnew_dot_rnew_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            }
+            MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            if( smpi->isMaster() ) {
+                DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
+            }
 
-        // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
-        }
+            // compute new directio
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
 
-        // compute control parameter
-        ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
-        if( smpi->isMaster() ) {
-            DEBUG( "iteration " << iteration << " done, exiting with control parameter ctrl = " << ctrl );
-        }
+            // compute control parameter
+            ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
+            if( smpi->isMaster() ) {
+                DEBUG( "iteration " << iteration << " done, exiting with control parameter ctrl = " << ctrl );
+            }
 
-    }//End of the iterative loop
+        }//End of the iterative loop
+    }
 
 
     // --------------------------------
@@ -1536,6 +1653,93 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
 
 } // END solvePoisson
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Pipelined conjugate gradient (Ghysels & Vanroose, Parallel Computing 40, 2014)
+// The two scalar products of an iteration are reduced by a single non-blocking MPI_Iallreduce,
+// which is overlapped with the stencil n = A*w and its exchange between patches
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::solvePoissonPipelinedCG( Params &params, SmileiMPI *smpi, unsigned int nx_p2_global, unsigned int &iteration, double &ctrl )
+{
+    unsigned int iteration_max = params.poisson_max_iteration;
+    double           error_max = params.poisson_max_error;
+
+    std::vector<Field *> w_;
+    std::vector<Field *> n_;
+    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        ( *this )( ipatch )->EMfields->initPipelinedPoisson();
+        w_.push_back( ( *this )( ipatch )->EMfields->w_ );
+        n_.push_back( ( *this )( ipatch )->EMfields->n_ );
+    }
+
+    // w = A*r
+    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        ElectroMagn *EMfields = ( *this )( ipatch )->EMfields;
+        EMfields->compute_Ax( ( *this )( ipatch ), EMfields->r_, EMfields->w_ );
+    }
+    SyncVectorPatch::exchange_along_all_directions<double,Field>( w_, *this, smpi );
+    SyncVectorPatch::finalize_exchange_along_all_directions( w_, *this );
+
+    double dot_local[2], dot[2];
+    double alpha( 0. ), alpha_old( 0. ), beta( 0. ), gamma_old( 0. );
+    MPI_Request request;
+
+    iteration = 0;
+    while( true ) {
+        // gamma = r.r and delta = w.r, reduced together
+        dot_local[0] = 0.;
+        dot_local[1] = 0.;
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ElectroMagn *EMfields = ( *this )( ipatch )->EMfields;
+            dot_local[0] += EMfields->compute_r();
+            dot_local[1] += EMfields->compute_xy( EMfields->w_, EMfields->r_ );
+        }
+        MPI_Iallreduce( dot_local, dot, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &request );
+
+        // n = A*w while the reduction is in progress
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ElectroMagn *EMfields = ( *this )( ipatch )->EMfields;
+            EMfields->compute_Ax( ( *this )( ipatch ), EMfields->w_, EMfields->n_ );
+        }
+        SyncVectorPatch::exchange_along_all_directions<double,Field>( n_, *this, smpi );
+        SyncVectorPatch::finalize_exchange_along_all_directions( n_, *this );
+
+        MPI_Wait( &request, MPI_STATUS_IGNORE );
+        double gamma = dot[0];
+        double delta = dot[1];
+
+        // compute control parameter
+        ctrl = gamma / ( double )( nx_p2_global );
+        if( smpi->isMaster() ) {
+            DEBUG( "pipelined CG iteration " << iteration << " done, control parameter ctrl = " << ctrl );
+        }
+        if( ( ctrl <= error_max ) || ( iteration >= iteration_max ) ) {
+            break;
+        }
+
+        iteration++;
+        if( iteration == 1 ) {
+            beta  = 0.;
+            alpha = gamma / delta;
+        } else {
+            beta  = gamma / gamma_old;
+            alpha = gamma / ( delta - beta * gamma / alpha_old );
+        }
+
+        // update z, s, p, phi, r and w in a single sweep
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->update_pipelined( alpha, beta );
+        }
+
+        gamma_old = gamma;
+        alpha_old = alpha;
+    }
+
+    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        ( *this )( ipatch )->EMfields->deletePipelinedPoisson();
+    }
+
+} // END solvePoissonPipelinedCG
+
 void VectorPatch::solvePoissonAM( Params &params, SmileiMPI *smpi )
 {
     
@@ -3435,9 +3639,13 @@ void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
     
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        double load_start = params.measured_load ? MPI_Wtime() : 0.;
         for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
             patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
         }
+        if( params.measured_load ) {
+            patches_[ipatch]->measured_time_ += MPI_Wtime() - load_start;
+        }
     }
     
     #pragma omp single
@@ -19,6 +19,7 @@
 #include "Timers.h"
 #include "RadiationTables.h"
 #include "ParticleCreator.h"
+#include "ParticleExchangeBuffers.h"
 
 class Field;
 class Timer;
@@ -105,6 +106,9 @@ public :
     //! Reconfigure all patches for the new time step
     void configuration( Params &params, Timers &timers, int itime );
     
+    //! Measure the cost model of the adaptive vectorization, if requested
+    void calibrateVectorization( Params &params, SmileiMPI *smpi );
+    
     //! Reconfigure all patches for the new time step
     void reconfiguration( Params &params, Timers &timers, int itime );
     
@@ -171,6 +175,9 @@ public :
     //! For all patch, sum susceptibility on ghost cells (sum per species if needed, sync per patch and MPI sync)
     void sumSusceptibility( Params &params, double time_dual, Timers &timers, int itime, SimWindow *simWindow, SmileiMPI *smpi );
     
+    //! True if the interior of the patches is advanced by the Maxwell solver during the sum of the currents
+    bool overlapMaxwell( Params &params, int itime, double time_dual );
+    
     //! For all patch, update E and B (Ampere, Faraday, boundary conditions, exchange B and center B)
     void solveMaxwell( Params &params, SimWindow *simWindow, int itime, double time_dual,
                        Timers &timers, SmileiMPI *smpi );
@@ -189,6 +196,8 @@ public :
     
     //! Solve Poisson to initialize E
     void solvePoisson( Params &params, SmileiMPI *smpi );
+    //! Pipelined conjugate gradient iterations of solvePoisson (one reduction per iteration)
+    void solvePoissonPipelinedCG( Params &params, SmileiMPI *smpi, unsigned int nx_p2_global, unsigned int &iteration, double &ctrl );
     void runNonRelativisticPoissonModule( Params &params, SmileiMPI* smpi,  Timers &timers );
     void solvePoissonAM( Params &params, SmileiMPI *smpi);
     
@@ -352,6 +361,9 @@ public :
     
     DomainDecomposition *domain_decomposition_;
     
+    //! Messages of the single-pass particle exchange (Main.single_pass_particle_exchange)
+    ParticleExchangeBuffers particle_exchange_;
+    
     
     //! Methods to access readably to patch PIC operators.
     //!   - patches_ should not be access outsied of VectorPatch
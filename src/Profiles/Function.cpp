@@ -1,6 +1,10 @@
 #include "Function.h"
 #include <complex>
 #include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
 
 using namespace std;
 
@@ -408,3 +412,495 @@ double Function_TimeSin2Plateau::valueAt( double time )
         return 0.;
     }
 }
+
+
+// Compiled expressions
+
+namespace
+{
+
+enum ExpressionOp {
+    PUSH_CONSTANT, PUSH_VARIABLE,
+    // binary
+    ADD, SUB, MUL, DIV, FLOORDIV, MOD, POW, LT, LE, GT, GE, EQ, NE, ATAN2, MINIMUM, MAXIMUM,
+    // unary
+    NEG, SQUARE, EXP, LOG, LOG10, SQRT, SIN, COS, TAN, ASIN, ACOS, ATAN, SINH, COSH, TANH, ABS, FLOOR, CEIL,
+    // ternary
+    WHERE
+};
+
+// Maximum depth of the stack
+const unsigned int max_stack_size = 64;
+
+// Number of points evaluated together by Function_Expression::valuesAt
+const unsigned int block_size = 256;
+
+inline int numberOfOperands( int op )
+{
+    if( op <= PUSH_VARIABLE ) {
+        return 0;
+    } else if( op <= MAXIMUM ) {
+        return 2;
+    } else if( op <= CEIL ) {
+        return 1;
+    } else {
+        return 3;
+    }
+}
+
+inline double applyOp( int op, double a, double b, double c )
+{
+    switch( op ) {
+        case ADD:      return a+b;
+        case SUB:      return a-b;
+        case MUL:      return a*b;
+        case DIV:      return a/b;
+        case FLOORDIV: return floor( a/b );
+        case MOD:      return a-b*floor( a/b );
+        case POW:      return pow( a, b );
+        case LT:       return a< b ? 1. : 0.;
+        case LE:       return a<=b ? 1. : 0.;
+        case GT:       return a> b ? 1. : 0.;
+        case GE:       return a>=b ? 1. : 0.;
+        case EQ:       return a==b ? 1. : 0.;
+        case NE:       return a!=b ? 1. : 0.;
+        case ATAN2:    return atan2( a, b );
+        case MINIMUM:  return a<b ? a : b;
+        case MAXIMUM:  return a>b ? a : b;
+        case NEG:      return -a;
+        case SQUARE:   return a*a;
+        case EXP:      return exp( a );
+        case LOG:      return log( a );
+        case LOG10:    return log10( a );
+        case SQRT:     return sqrt( a );
+        case SIN:      return sin( a );
+        case COS:      return cos( a );
+        case TAN:      return tan( a );
+        case ASIN:     return asin( a );
+        case ACOS:     return acos( a );
+        case ATAN:     return atan( a );
+        case SINH:     return sinh( a );
+        case COSH:     return cosh( a );
+        case TANH:     return tanh( a );
+        case ABS:      return fabs( a );
+        case FLOOR:    return floor( a );
+        case CEIL:     return ceil( a );
+        case WHERE:    return a!=0. ? b : c;
+    }
+    return 0.;
+}
+
+// Recursive descent parser of the expressions produced by _compile_profile,
+// with the precedence rules of python
+class ExpressionParser
+{
+public:
+    ExpressionParser( const std::string &s, unsigned int nvariables ) :
+        s_( s ), pos_( 0 ), nvariables_( nvariables ), error_( false ) {};
+        
+    bool parse( std::vector<Function_Expression::Instruction> &program )
+    {
+        comparison();
+        skipSpaces();
+        if( pos_ != s_.size() ) {
+            error_ = true;
+        }
+        program = program_;
+        return !error_;
+    }
+    
+private:
+    void skipSpaces()
+    {
+        while( pos_ < s_.size() && s_[pos_] == ' ' ) {
+            pos_++;
+        }
+    }
+    
+    bool accept( const char *token )
+    {
+        skipSpaces();
+        size_t n = strlen( token );
+        if( s_.compare( pos_, n, token ) == 0 ) {
+            pos_ += n;
+            return true;
+        }
+        return false;
+    }
+    
+    // Add an instruction, folding the operations on constants
+    void emit( int op, int variable = 0, double value = 0. )
+    {
+        int nop = numberOfOperands( op );
+        if( nop > 0 && ( int )program_.size() >= nop ) {
+            bool constant = true;
+            for( int i=1; i<=nop; i++ ) {
+                constant = constant && program_[program_.size()-i].op == PUSH_CONSTANT;
+            }
+            if( constant ) {
+                double operands[3] = {0., 0., 0.};
+                for( int i=0; i<nop; i++ ) {
+                    operands[i] = program_[program_.size()-nop+i].value;
+                }
+                program_.resize( program_.size()-nop );
+                program_.push_back( { PUSH_CONSTANT, 0, applyOp( op, operands[0], operands[1], operands[2] ) } );
+                return;
+            }
+        }
+        program_.push_back( { op, variable, value } );
+    }
+    
+    void comparison()
+    {
+        sum();
+        const char *tokens[6] = { "<=", ">=", "==", "!=", "<", ">" };
+        const int ops[6] = { LE, GE, EQ, NE, LT, GT };
+        for( int i=0; i<6; i++ ) {
+            if( accept( tokens[i] ) ) {
+                sum();
+                emit( ops[i] );
+                return;
+            }
+        }
+    }
+    
+    void sum()
+    {
+        term();
+        while( !error_ ) {
+            if( accept( "+" ) ) {
+                term();
+                emit( ADD );
+            } else if( accept( "-" ) ) {
+                term();
+                emit( SUB );
+            } else {
+                break;
+            }
+        }
+    }
+    
+    void term()
+    {
+        unary();
+        while( !error_ ) {
+            skipSpaces();
+            if( s_.compare( pos_, 2, "**" ) == 0 ) {
+                break;
+            } else if( accept( "*" ) ) {
+                unary();
+                emit( MUL );
+            } else if( accept( "//" ) ) {
+                unary();
+                emit( FLOORDIV );
+            } else if( accept( "/" ) ) {
+                unary();
+                emit( DIV );
+            } else if( accept( "%" ) ) {
+                unary();
+                emit( MOD );
+            } else {
+                break;
+            }
+        }
+    }
+    
+    void unary()
+    {
+        if( accept( "-" ) ) {
+            unary();
+            emit( NEG );
+        } else if( accept( "+" ) ) {
+            unary();
+        } else {
+            power();
+        }
+    }
+    
+    void power()
+    {
+        primary();
+        if( accept( "**" ) ) {
+            unary();
+            // Integer powers 2 are frequent (gaussians)
+            if( !error_ && program_.back().op == PUSH_CONSTANT && program_.back().value == 2.
+                    && program_[program_.size()-2].op != PUSH_CONSTANT ) {
+                program_.pop_back();
+                emit( SQUARE );
+            } else {
+                emit( POW );
+            }
+        }
+    }
+    
+    void primary()
+    {
+        skipSpaces();
+        if( error_ || pos_ >= s_.size() ) {
+            error_ = true;
+            return;
+        }
+        char c = s_[pos_];
+        if( c == '(' ) {
+            pos_++;
+            comparison();
+            if( !accept( ")" ) ) {
+                error_ = true;
+            }
+        } else if( isdigit( c ) || c == '.' ) {
+            const char *start = s_.c_str() + pos_;
+            char *end;
+            double value = strtod( start, &end );
+            if( end == start ) {
+                error_ = true;
+                return;
+            }
+            pos_ += end - start;
+            emit( PUSH_CONSTANT, 0, value );
+        } else if( isalpha( c ) || c == '_' ) {
+            size_t start = pos_;
+            while( pos_ < s_.size() && ( isalnum( s_[pos_] ) || s_[pos_] == '_' ) ) {
+                pos_++;
+            }
+            std::string name = s_.substr( start, pos_-start );
+            if( accept( "(" ) ) {
+                function( name );
+            } else {
+                variable( name );
+            }
+        } else {
+            error_ = true;
+        }
+    }
+    
+    void variable( const std::string &name )
+    {
+        if( name.size() < 2 || name[0] != 'v' ) {
+            error_ = true;
+            return;
+        }
+        for( unsigned int i=1; i<name.size(); i++ ) {
+            if( !isdigit( name[i] ) ) {
+                error_ = true;
+                return;
+            }
+        }
+        unsigned int index = atoi( name.c_str()+1 );
+        if( index >= nvariables_ ) {
+            error_ = true;
+            return;
+        }
+        emit( PUSH_VARIABLE, index );
+    }
+    
+    void function( const std::string &name )
+    {
+        static const char *names[] = {
+            "exp", "log", "log10", "sqrt", "sin", "cos", "tan", "arcsin", "arccos", "arctan",
+            "sinh", "cosh", "tanh", "abs", "floor", "ceil", "arctan2", "minimum", "maximum", "pow", "where"
+        };
+        static const int ops[] = {
+            EXP, LOG, LOG10, SQRT, SIN, COS, TAN, ASIN, ACOS, ATAN,
+            SINH, COSH, TANH, ABS, FLOOR, CEIL, ATAN2, MINIMUM, MAXIMUM, POW, WHERE
+        };
+        int op = -1;
+        for( unsigned int i=0; i<sizeof( ops )/sizeof( int ); i++ ) {
+            if( name == names[i] ) {
+                op = ops[i];
+            }
+        }
+        if( op < 0 ) {
+            error_ = true;
+            return;
+        }
+        int nop = numberOfOperands( op );
+        for( int i=0; i<nop && !error_; i++ ) {
+            if( i > 0 && !accept( "," ) ) {
+                error_ = true;
+                return;
+            }
+            comparison();
+        }
+        if( !accept( ")" ) ) {
+            error_ = true;
+            return;
+        }
+        emit( op );
+    }
+    
+    const std::string &s_;
+    size_t pos_;
+    unsigned int nvariables_;
+    bool error_;
+    std::vector<Function_Expression::Instruction> program_;
+};
+
+}
+
+Function_Expression::Function_Expression( std::string expression, unsigned int nvariables ) :
+    expression_( expression ), nvariables_( nvariables ), stack_size_( 0 ), valid_( false )
+{
+    ExpressionParser parser( expression, nvariables );
+    if( !parser.parse( program_ ) ) {
+        return;
+    }
+    // Depth of the stack
+    int depth = 0, max_depth = 0;
+    for( unsigned int i=0; i<program_.size(); i++ ) {
+        int nop = numberOfOperands( program_[i].op );
+        depth += ( nop == 0 ) ? 1 : 1-nop;
+        max_depth = std::max( max_depth, depth );
+    }
+    stack_size_ = max_depth;
+    valid_ = ( depth == 1 ) && ( stack_size_ <= max_stack_size );
+}
+
+double Function_Expression::evaluate( const double *x )
+{
+    double stack[max_stack_size];
+    int sp = 0;
+    for( unsigned int i=0; i<program_.size(); i++ ) {
+        const Instruction &inst = program_[i];
+        if( inst.op == PUSH_CONSTANT ) {
+            stack[sp++] = inst.value;
+        } else if( inst.op == PUSH_VARIABLE ) {
+            stack[sp++] = x[inst.variable];
+        } else {
+            int nop = numberOfOperands( inst.op );
+            sp -= nop;
+            stack[sp] = applyOp( inst.op, stack[sp], nop>1 ? stack[sp+1] : 0., nop>2 ? stack[sp+2] : 0. );
+            sp++;
+        }
+    }
+    return stack[0];
+}
+
+double Function_Expression::valueAt( double time )
+{
+    return evaluate( &time );
+}
+double Function_Expression::valueAt( vector<double> x_cell )
+{
+    return evaluate( x_cell.data() );
+}
+double Function_Expression::valueAt( vector<double> x_cell, double time )
+{
+    // As for python profiles: the last variable is the time
+    x_cell.resize( nvariables_ );
+    x_cell[nvariables_-1] = time;
+    return evaluate( x_cell.data() );
+}
+std::complex<double> Function_Expression::complexValueAt( vector<double> x_cell, double time )
+{
+    return valueAt( x_cell, time );
+}
+std::complex<double> Function_Expression::complexValueAt( vector<double> x_cell )
+{
+    return valueAt( x_cell );
+}
+
+// The program is applied to blocks of points: each instruction is a vectorized loop over a block
+void Function_Expression::valuesAt( const std::vector<double *> &x, double *values, unsigned int n )
+{
+    std::vector<double> stack( std::max( stack_size_, 1u )*block_size );
+    
+    for( unsigned int start=0; start<n; start+=block_size ) {
+        unsigned int m = std::min( block_size, n-start );
+        int sp = 0;
+        for( unsigned int i=0; i<program_.size(); i++ ) {
+            const Instruction &inst = program_[i];
+            double *a = &stack[sp*block_size];
+            if( inst.op == PUSH_CONSTANT ) {
+                double value = inst.value;
+                #pragma omp simd
+                for( unsigned int k=0; k<m; k++ ) {
+                    a[k] = value;
+                }
+                sp++;
+                continue;
+            } else if( inst.op == PUSH_VARIABLE ) {
+                const double *v = x[inst.variable] + start;
+                #pragma omp simd
+                for( unsigned int k=0; k<m; k++ ) {
+                    a[k] = v[k];
+                }
+                sp++;
+                continue;
+            }
+            int nop = numberOfOperands( inst.op );
+            sp -= nop;
+            a = &stack[sp*block_size];
+            double *b = a + block_size;
+            double *c = b + block_size;
+            switch( inst.op ) {
+                case ADD:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] += b[k];
+                    }
+                    break;
+                case SUB:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] -= b[k];
+                    }
+                    break;
+                case MUL:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] *= b[k];
+                    }
+                    break;
+                case DIV:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] /= b[k];
+                    }
+                    break;
+                case NEG:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] = -a[k];
+                    }
+                    break;
+                case SQUARE:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] *= a[k];
+                    }
+                    break;
+                case EXP:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] = exp( a[k] );
+                    }
+                    break;
+                case WHERE:
+                    #pragma omp simd
+                    for( unsigned int k=0; k<m; k++ ) {
+                        a[k] = a[k]!=0. ? b[k] : c[k];
+                    }
+                    break;
+                default: {
+                    int op = inst.op;
+                    if( nop == 1 ) {
+                        #pragma omp simd
+                        for( unsigned int k=0; k<m; k++ ) {
+                            a[k] = applyOp( op, a[k], 0., 0. );
+                        }
+                    } else {
+                        #pragma omp simd
+                        for( unsigned int k=0; k<m; k++ ) {
+                            a[k] = applyOp( op, a[k], b[k], 0. );
+                        }
+                    }
+                }
+            }
+            sp++;
+        }
+        double *result = &stack[0];
+        for( unsigned int k=0; k<m; k++ ) {
+            values[start+k] = result[k];
+        }
+    }
+}
@@ -1228,4 +1228,52 @@ private:
     double start, slope1, plateau, slope2, end;
 };
 
+// Class for compiled expressions (see _compile_profile in pyprofiles.py)
+// The expression is converted into a stack program, evaluated without python
+class Function_Expression : public Function
+{
+public:
+    //! \param expression arithmetic expression of the variables v0, v1, ...
+    Function_Expression( std::string expression, unsigned int nvariables );
+    Function_Expression( Function_Expression *f ) :
+        expression_( f->expression_ ), program_( f->program_ ),
+        nvariables_( f->nvariables_ ), stack_size_( f->stack_size_ ), valid_( f->valid_ ) {};
+    double valueAt( double ); // time
+    double valueAt( std::vector<double> ); // space
+    double valueAt( std::vector<double>, double ); // space + time
+    std::complex<double> complexValueAt( std::vector<double>, double ); // space + time
+    std::complex<double> complexValueAt( std::vector<double> ); // space
+    //! Values at n points, the coordinates of which are in x[0], x[1], ... (vectorized)
+    void valuesAt( const std::vector<double *> &x, double *values, unsigned int n );
+    //! Whether the expression could be compiled
+    bool isValid()
+    {
+        return valid_;
+    };
+    std::string getInfo()
+    {
+        return " (compiled)";
+    };
+    
+    //! Instruction of the stack program
+    struct Instruction {
+        int op;
+        //! Index of the variable (op == PUSH_VARIABLE)
+        int variable;
+        //! Value of the constant (op == PUSH_CONSTANT)
+        double value;
+    };
+    
+private:
+    //! Evaluate the program on one point
+    double evaluate( const double *x );
+    
+    std::string expression_;
+    std::vector<Instruction> program_;
+    unsigned int nvariables_;
+    //! Maximum depth of the stack
+    unsigned int stack_size_;
+    bool valid_;
+};
+
 #endif
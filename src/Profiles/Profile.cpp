@@ -11,7 +11,8 @@ using namespace std;
 Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bool try_numpy ) :
     profileName( "" ),
     nvariables_( nvariables ),
-    uses_numpy( false )
+    uses_numpy( false ),
+    is_compiled( false )
 {
     ostringstream info_( "" );
     info_ << nvariables_ << "D";
@@ -216,6 +217,14 @@ Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bo
             ERROR( "Profile `"<<name<<"`: defined with unsupported number of variables (" << nvariables_ << ")" );
         }
         
+        // Try to convert the profile into an expression evaluated without python
+        function = compileProfile( py_profile );
+        if( function ) {
+            is_compiled = true;
+            info_ << " user-defined function";
+            info = info_.str() + function->getInfo();
+            return;
+        }
         
         // Verify that the profile transforms a float in a float
 #ifdef SMILEI_USE_NUMPY
@@ -328,7 +337,10 @@ Profile::Profile( Profile *p )
     nvariables_ = p->nvariables_;
     info        = p->info       ;
     uses_numpy  = p->uses_numpy ;
-    if( profileName != "" ) {
+    is_compiled = p->is_compiled;
+    if( is_compiled ) {
+        function = new Function_Expression( static_cast<Function_Expression *>( p->function ) );
+    } else if( profileName != "" ) {
         if( profileName == "constant" ) {
             if( nvariables_ == 1 ) {
                 function = new Function_Constant1D( static_cast<Function_Constant1D *>( p->function ) );
@@ -411,3 +423,72 @@ Profile::~Profile()
 {
     delete function;
 }
+
+
+// Convert a python profile into a compiled expression (see _compile_profile in pyprofiles.py)
+// The expression is checked against the python function on a few points
+// Returns NULL if the profile cannot be compiled
+Function *Profile::compileProfile( PyObject *py_profile )
+{
+    PyObject *compile = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_compile_profile" );
+    if( ! compile ) {
+        PyErr_Clear();
+        return NULL;
+    }
+    PyObject *py_expression = PyObject_CallFunction( compile, const_cast<char *>( "Oi" ), py_profile, nvariables_ );
+    Py_DECREF( compile );
+    string expression;
+    bool ok = py_expression && py_expression != Py_None && PyTools::convert( py_expression, expression );
+    Py_XDECREF( py_expression );
+    PyErr_Clear();
+    if( ! ok ) {
+        return NULL;
+    }
+    
+    Function_Expression *f = new Function_Expression( expression, nvariables_ );
+    if( ! f->isValid() ) {
+        DEBUG( "Profile could not be compiled: " << expression );
+        delete f;
+        return NULL;
+    }
+    
+    // Test points spanning several orders of magnitude
+    const double test_values[8] = { 0., 0.5, 1.7, 3.1, 10.3, 47.9, 130.7, 1031.3 };
+    const char *formats[4] = { "d", "dd", "ddd", "dddd" };
+    vector<double> x( nvariables_ );
+    int nchecked = 0;
+    for( unsigned int i=0; i<8 && ok; i++ ) {
+        for( int ivar=0; ivar<nvariables_; ivar++ ) {
+            x[ivar] = test_values[( i+3*ivar )%8];
+        }
+        PyObject *py_value;
+        if( nvariables_ == 1 ) {
+            py_value = PyObject_CallFunction( py_profile, const_cast<char *>( formats[0] ), x[0] );
+        } else if( nvariables_ == 2 ) {
+            py_value = PyObject_CallFunction( py_profile, const_cast<char *>( formats[1] ), x[0], x[1] );
+        } else if( nvariables_ == 3 ) {
+            py_value = PyObject_CallFunction( py_profile, const_cast<char *>( formats[2] ), x[0], x[1], x[2] );
+        } else {
+            py_value = PyObject_CallFunction( py_profile, const_cast<char *>( formats[3] ), x[0], x[1], x[2], x[3] );
+        }
+        double value;
+        // Points where python fails (division by zero, ...) are skipped
+        if( !py_value || !PyTools::convert( py_value, value ) ) {
+            Py_XDECREF( py_value );
+            PyErr_Clear();
+            continue;
+        }
+        Py_DECREF( py_value );
+        nchecked++;
+        double compiled_value = f->valueAt( x );
+        ok = ( std::isnan( value ) && std::isnan( compiled_value ) )
+             || value == compiled_value
+             || abs( value-compiled_value ) <= 1e-10*max( abs( value ), abs( compiled_value ) );
+    }
+    if( ! ok || nchecked == 0 ) {
+        DEBUG( "Profile does not match its compiled expression: " << expression );
+        delete f;
+        return NULL;
+    }
+    return f;
+}
@@ -49,6 +49,15 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // If compiled profile, evaluate all points at once without python
+        if( is_compiled ) {
+            std::vector<double *> x( nvar );
+            for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+                x[ivar] = coordinates[ivar]->data();
+            }
+            static_cast<Function_Expression *>( function )->valuesAt( x, ret.data(), size );
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -179,6 +188,12 @@ public:
     
     
     
+    //! Whether several threads may evaluate the profile at once (built-in or compiled profiles, not python)
+    inline bool isThreadSafe()
+    {
+        return is_compiled || profileName != "";
+    };
+    
     //! Get info on the loaded profile, to be printed later
     inline std::string getInfo()
     {
@@ -189,6 +204,9 @@ public:
     std::string profileName;
     
 private:
+    //! Convert a python profile into a compiled expression, if possible
+    Function *compileProfile( PyObject *py_profile );
+    
     //! Object that holds the information on the profile function
     Function *function;
     
@@ -201,6 +219,9 @@ private:
     //! Whether the profile is using numpy
     bool uses_numpy;
     
+    //! Whether the profile is a compiled expression (Function_Expression)
+    bool is_compiled;
+    
 };//END class Profile
 
 
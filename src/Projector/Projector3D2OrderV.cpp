@@ -66,6 +66,9 @@ void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz,
     // -------------------------------------
     
     int npart_total = invgf->size();
+    // Particle arrays are aligned on 64 bytes (see Particles::reallocate)
+    short  *particle_charge = particles.getPtrCharge();
+    double *particle_weight = particles.getPtrWeight();
     int ipo = iold[0];
     int jpo = iold[1];
     int kpo = iold[2];
@@ -107,10 +110,10 @@ void Projector3D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz,
         int np_computed( min( cell_nparts-ivect, vecSize ) );
         int istart0 = ( int )istart + ivect;
         
-        #pragma omp simd
+        #pragma omp simd aligned( particle_charge, particle_weight : 64 )
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
             compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, DSx, DSy, DSz );
-            charge_weight[ipart] = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            charge_weight[ipart] = inv_cell_volume * ( double )( particle_charge[istart0+ipart] )*particle_weight[istart0+ipart];
         }
         
         #pragma omp simd
@@ -369,6 +372,9 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
     // -------------------------------------
     
     int npart_total = invgf->size();
+    // Particle arrays are aligned on 64 bytes (see Particles::reallocate)
+    short  *particle_charge = particles.getPtrCharge();
+    double *particle_weight = particles.getPtrWeight();
     int ipo = iold[0];
     int jpo = iold[1];
     int kpo = iold[2];
@@ -408,10 +414,10 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
         int np_computed( min( cell_nparts-ivect, vecSize ) );
         int istart0 = ( int )istart + ivect;
         
-        #pragma omp simd
+        #pragma omp simd aligned( particle_charge, particle_weight : 64 )
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
             compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sx0_buff_vect, Sy0_buff_vect, Sz0_buff_vect, DSx, DSy, DSz );
-            charge_weight[ipart] = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            charge_weight[ipart] = inv_cell_volume * ( double )( particle_charge[istart0+ipart] )*particle_weight[istart0+ipart];
         }
         
         #pragma omp simd
@@ -454,10 +460,10 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
         int np_computed( min( cell_nparts-ivect, vecSize ) );
         int istart0 = ( int )istart + ivect;
         
-        #pragma omp simd
+        #pragma omp simd aligned( particle_charge, particle_weight : 64 )
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
             compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sx0_buff_vect, Sy0_buff_vect, Sz0_buff_vect, DSx, DSy, DSz );
-            charge_weight[ipart] = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            charge_weight[ipart] = inv_cell_volume * ( double )( particle_charge[istart0+ipart] )*particle_weight[istart0+ipart];
         }
         
         #pragma omp simd
@@ -496,10 +502,10 @@ void Projector3D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles
         int np_computed( min( cell_nparts-ivect, vecSize ) );
         int istart0 = ( int )istart + ivect;
         
-        #pragma omp simd
+        #pragma omp simd aligned( particle_charge, particle_weight : 64 )
         for( int ipart=0 ; ipart<np_computed; ipart++ ) {
             compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sx0_buff_vect, Sy0_buff_vect, Sz0_buff_vect, DSx, DSy, DSz );
-            charge_weight[ipart] = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            charge_weight[ipart] = inv_cell_volume * ( double )( particle_charge[istart0+ipart] )*particle_weight[istart0+ipart];
         }
         
         #pragma omp simd
@@ -35,13 +35,13 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     
     //int* cell_keys;
     
-    double *momentum[3];
-    for( int i = 0 ; i<3 ; i++ ) {
-        momentum[i] =  &( particles.momentum( i, 0 ) );
-    }
+    // Particle arrays are aligned on 64 bytes (see Particles::reallocate)
+    double *momentum_x = particles.getPtrMomentum( 0 );
+    double *momentum_y = particles.getPtrMomentum( 1 );
+    double *momentum_z = particles.getPtrMomentum( 2 );
     double *position[3];
     for( int i = 0 ; i<nDim_ ; i++ ) {
-        position[i] =  &( particles.position( i, 0 ) );
+        position[i] =  particles.getPtrPosition( i );
     }
 #ifdef  __DEBUG
     double *position_old[3];
@@ -49,7 +49,7 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
         position_old[i] =  &( particles.position_old( i, 0 ) );
     }
 #endif
-    short *charge = &( particles.charge( 0 ) );
+    short *charge = particles.getPtrCharge();
     
     int nparts = Epart->size()/3;
     double *Ex = &( ( *Epart )[0*nparts] );
@@ -63,11 +63,12 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     //cell_keys = &( particles.cell_keys[0]);
     
     vector<double> dcharge(nparts);
+    #pragma omp simd aligned( charge : 64 )
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         dcharge[ipart-ipart_ref] = ( double )( charge[ipart] );
     }
     
-    #pragma omp simd
+    #pragma omp simd aligned( momentum_x, momentum_y, momentum_z : 64 )
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         double psm[3], um[3];
         
@@ -79,9 +80,9 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
         psm[2] = charge_over_mass_dts2*( *( Ez+ipart-ipart_ref ) );
         
         //(*this)(particles, ipart, (*Epart)[ipart], (*Bpart)[ipart] , (*invgf)[ipart]);
-        um[0] = momentum[0][ipart] + psm[0];
-        um[1] = momentum[1][ipart] + psm[1];
-        um[2] = momentum[2][ipart] + psm[2];
+        um[0] = momentum_x[ipart] + psm[0];
+        um[1] = momentum_y[ipart] + psm[1];
+        um[2] = momentum_z[ipart] + psm[2];
         
         // Rotation in the magnetic field
         local_invgf = charge_over_mass_dts2 / sqrt( 1.0 + um[0]*um[0] + um[1]*um[1] + um[2]*um[2] );
@@ -98,9 +99,9 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
         local_invgf = 1. / sqrt( 1.0 + psm[0]*psm[0] + psm[1]*psm[1] + psm[2]*psm[2] );
         invgf[ipart-ipart_ref] = local_invgf;
         
-        momentum[0][ipart] = psm[0];
-        momentum[1][ipart] = psm[1];
-        momentum[2][ipart] = psm[2];
+        momentum_x[ipart] = psm[0];
+        momentum_y[ipart] = psm[1];
+        momentum_z[ipart] = psm[2];
         
         // Move the particle
 #ifdef  __DEBUG
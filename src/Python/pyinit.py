@@ -135,9 +135,24 @@ class SmileiComponent(object):
         return "<Smilei "+type(self).__name__+">"
 
 
+# While a particle filter is traced for compilation (see _compile_filter),
+# this holds a list where each read of Main.iteration is recorded
+_iteration_reads = None
+
+class _IterationRead(Exception):
+    """Raised when Main.iteration is read by a filter being traced"""
+    pass
+
 class SmileiSingletonType(SmileiComponentType):
     """Metaclass to all Smilei singletons"""
 
+    # Expressions reading Main.iteration are not traced
+    def __getattribute__(self, name):
+        if name == "iteration" and _iteration_reads is not None:
+            _iteration_reads.append(name)
+            raise _IterationRead("Main.iteration cannot be compiled")
+        return super(SmileiSingletonType, self).__getattribute__(name)
+
     def __repr__(self):
         return "<Smilei "+str(self.__name__)+">"
 
@@ -197,6 +212,7 @@ class Main(SmileiSingleton):
     solve_poisson = True
     poisson_max_iteration = 50000
     poisson_max_error = 1.e-14
+    poisson_solver = "CG"
 
     # Relativistic Poisson tuning
     solve_relativistic_poisson = False
@@ -205,6 +221,9 @@ class Main(SmileiSingleton):
 
     # Default fields
     maxwell_solver = 'Yee'
+    fused_maxwell_solver = False
+    overlap_maxwell = False
+    single_pass_particle_exchange = False
     EM_boundary_conditions = [["periodic"]]
     EM_boundary_conditions_k = []
     save_magnectic_fields_for_SM = True
@@ -216,6 +235,7 @@ class Main(SmileiSingleton):
     print_every = None
     random_seed = None
     print_expected_disk_usage = True
+    compile_profiles = True
 
     def __init__(self, **kwargs):
         # Load all arguments to Main()
@@ -297,6 +317,8 @@ class LoadBalancing(SmileiSingleton):
     initial_balance      = True
     cell_load            = 1.0
     frozen_particle_load = 0.1
+    measured_load        = False
+    load_smoothing       = 0.5
 
 # Radiation reaction configuration (continuous and MC algorithms)
 class Vectorization(SmileiSingleton):
@@ -306,6 +328,8 @@ class Vectorization(SmileiSingleton):
     mode                = "off"
     reconfigure_every   = 20
     initial_mode        = "off"
+    cost_model          = "fit"
+    cost_model_file     = ""
 
 
 class MovingWindow(SmileiSingleton):
@@ -328,6 +352,7 @@ class Checkpoints(SmileiSingleton):
     dump_deflate = 0
     exit_after_dump = True
     file_grouping = None
+    async_dump = False
     restart_files = []
 
 class CurrentFilter(SmileiSingleton):
@@ -420,6 +445,7 @@ class Laser(SmileiComponent):
     delay_phase = [0., 0.]
     space_time_profile = None
     space_time_profile_AM = None
+    space_time_table = []
     file = None
     _offset = None
 
@@ -490,6 +516,10 @@ class DiagFields(SmileiComponent):
     time_average = 1
     subgrid = None
     flush_every = 1
+    aggregate_fields = False
+    compression = "none"
+    compression_level = 4
+    aggregators = 0
 
 class DiagTrackParticles(SmileiComponent):
     """Track diagnostic"""
@@ -498,6 +528,7 @@ class DiagTrackParticles(SmileiComponent):
     flush_every = 1
     filter = None
     attributes = ["x", "y", "z", "px", "py", "pz"]
+    buffered_steps = 1
 
 class DiagPerformances(SmileiSingleton):
     """Performances diagnostic"""
@@ -569,6 +600,8 @@ class RadiationReaction(SmileiComponent):
     xip_chiph_dim = 128
     # Output format, can be "ascii", "binary", "hdf5"
     output_format = "hdf5"
+    # Path to the cache of computed tables (no cache if empty)
+    table_cache_path = ""
 
 # MutliphotonBreitWheeler pair creation
 class MultiphotonBreitWheeler(SmileiComponent):
@@ -594,6 +627,8 @@ class MultiphotonBreitWheeler(SmileiComponent):
     xip_chiph_dim = 128
     # Output format, can be "ascii", "binary", "hdf5"
     output_format = "hdf5"
+    # Path to the cache of computed tables (no cache if empty)
+    table_cache_path = ""
 
 # Smilei-defined
 smilei_mpi_rank = 0
@@ -456,6 +456,205 @@ def tsin2plateau(start=0., fwhm=0., plateau=None, slope1=None, slope2=None):
     return f
 
 
+# Compiled profiles
+# A user-defined profile made only of arithmetic operations and numpy functions
+# is converted into an expression that is evaluated in C++ instead of calling python.
+# The conversion calls the profile with symbolic variables (_ProfileTracer) that record
+# the operations. Anything else (branches, math module, random numbers, ...) stops the
+# conversion and the profile stays a python function.
+
+class _ProfileTracerError(Exception):
+    pass
+
+class _ProfileTracer(object):
+    """Symbolic variable recording the operations of a profile"""
+    _functions = {
+        "exp":"exp", "log":"log", "log10":"log10", "sqrt":"sqrt",
+        "sin":"sin", "cos":"cos", "tan":"tan", "arcsin":"arcsin", "arccos":"arccos", "arctan":"arctan",
+        "sinh":"sinh", "cosh":"cosh", "tanh":"tanh", "absolute":"abs", "fabs":"abs",
+        "floor":"floor", "ceil":"ceil",
+    }
+    _operators = {
+        "add":"+", "subtract":"-", "multiply":"*", "divide":"/", "true_divide":"/", "power":"**",
+        "remainder":"%", "mod":"%", "floor_divide":"//",
+        "less":"<", "less_equal":"<=", "greater":">", "greater_equal":">=", "equal":"==", "not_equal":"!=",
+    }
+    _binary_functions = {
+        "arctan2":"arctan2", "minimum":"minimum", "maximum":"maximum", "fmin":"minimum", "fmax":"maximum",
+    }
+    __hash__ = None
+    def __init__(self, expression):
+        self.expression = expression
+    @staticmethod
+    def str(a):
+        if isinstance(a, _ProfileTracer):
+            return a.expression
+        if isinstance(a, bool):
+            raise _ProfileTracerError()
+        # 0-d arrays returned by numpy operations on tracers
+        if getattr(a, "dtype", None) == object and getattr(a, "ndim", None) == 0:
+            return _ProfileTracer.str(a.item())
+        try:
+            value = float(a)
+        except Exception:
+            raise _ProfileTracerError()
+        if value != value or value in [float("inf"), -float("inf")]:
+            raise _ProfileTracerError()
+        return repr(value)
+    @staticmethod
+    def operation(op, a, b):
+        return _ProfileTracer("("+_ProfileTracer.str(a)+op+_ProfileTracer.str(b)+")")
+    @staticmethod
+    def function(name, *args):
+        return _ProfileTracer(name+"("+",".join([_ProfileTracer.str(a) for a in args])+")")
+    def __add__     (self, o): return _ProfileTracer.operation("+" , self, o)
+    def __radd__    (self, o): return _ProfileTracer.operation("+" , o, self)
+    def __sub__     (self, o): return _ProfileTracer.operation("-" , self, o)
+    def __rsub__    (self, o): return _ProfileTracer.operation("-" , o, self)
+    def __mul__     (self, o): return _ProfileTracer.operation("*" , self, o)
+    def __rmul__    (self, o): return _ProfileTracer.operation("*" , o, self)
+    def __truediv__ (self, o): return _ProfileTracer.operation("/" , self, o)
+    def __rtruediv__(self, o): return _ProfileTracer.operation("/" , o, self)
+    __div__  = __truediv__ # python2
+    __rdiv__ = __rtruediv__
+    def __floordiv__ (self, o): return _ProfileTracer.operation("//", self, o)
+    def __rfloordiv__(self, o): return _ProfileTracer.operation("//", o, self)
+    def __mod__     (self, o): return _ProfileTracer.operation("%" , self, o)
+    def __rmod__    (self, o): return _ProfileTracer.operation("%" , o, self)
+    def __pow__     (self, o): return _ProfileTracer.operation("**", self, o)
+    def __rpow__    (self, o): return _ProfileTracer.operation("**", o, self)
+    def __lt__(self, o): return _ProfileTracer.operation("<" , self, o)
+    def __le__(self, o): return _ProfileTracer.operation("<=", self, o)
+    def __gt__(self, o): return _ProfileTracer.operation(">" , self, o)
+    def __ge__(self, o): return _ProfileTracer.operation(">=", self, o)
+    def __eq__(self, o): return _ProfileTracer.operation("==", self, o)
+    def __ne__(self, o): return _ProfileTracer.operation("!=", self, o)
+    # Logical operators on conditions (used by particle filters)
+    @staticmethod
+    def logical(op, a, b):
+        a, b = _ProfileTracer.str(a), _ProfileTracer.str(b)
+        if op == "and": return _ProfileTracer("(("+a+"!=0.0)*("+b+"!=0.0))")
+        if op == "or" : return _ProfileTracer("((("+a+"!=0.0)+("+b+"!=0.0))!=0.0)")
+        return _ProfileTracer("(("+a+"!=0.0)!=("+b+"!=0.0))")
+    def __and__ (self, o): return _ProfileTracer.logical("and", self, o)
+    def __rand__(self, o): return _ProfileTracer.logical("and", o, self)
+    def __or__  (self, o): return _ProfileTracer.logical("or" , self, o)
+    def __ror__ (self, o): return _ProfileTracer.logical("or" , o, self)
+    def __xor__ (self, o): return _ProfileTracer.logical("xor", self, o)
+    def __rxor__(self, o): return _ProfileTracer.logical("xor", o, self)
+    def __invert__(self): return _ProfileTracer("("+self.expression+"==0.0)")
+    def __neg__(self): return _ProfileTracer("(-"+self.expression+")")
+    def __pos__(self): return self
+    def __abs__(self): return _ProfileTracer.function("abs", self)
+    # The value of a tracer is unknown: branches and conversions are not supported
+    def __bool__(self): raise _ProfileTracerError()
+    __nonzero__ = __bool__ # python2
+    def __float__(self): raise _ProfileTracerError()
+    def __int__(self): raise _ProfileTracerError()
+    def __index__(self): raise _ProfileTracerError()
+    def __complex__(self): raise _ProfileTracerError()
+    # numpy functions
+    def __array_ufunc__(self, ufunc, method, *inputs, **kwargs):
+        name = ufunc.__name__
+        if method != "__call__" or kwargs:
+            raise _ProfileTracerError()
+        if name in _ProfileTracer._functions and len(inputs)==1:
+            return _ProfileTracer.function(_ProfileTracer._functions[name], inputs[0])
+        if name in _ProfileTracer._operators and len(inputs)==2:
+            return _ProfileTracer.operation(_ProfileTracer._operators[name], inputs[0], inputs[1])
+        if name in _ProfileTracer._binary_functions and len(inputs)==2:
+            return _ProfileTracer.function(_ProfileTracer._binary_functions[name], inputs[0], inputs[1])
+        if name in ["logical_and", "bitwise_and"] and len(inputs)==2:
+            return _ProfileTracer.logical("and", inputs[0], inputs[1])
+        if name in ["logical_or", "bitwise_or"] and len(inputs)==2:
+            return _ProfileTracer.logical("or", inputs[0], inputs[1])
+        if name in ["logical_xor", "bitwise_xor"] and len(inputs)==2:
+            return _ProfileTracer.logical("xor", inputs[0], inputs[1])
+        if name in ["logical_not", "invert"]:
+            return ~inputs[0]
+        if name == "negative": return -inputs[0]
+        if name == "positive": return inputs[0]
+        if name == "square"  : return _ProfileTracer.operation("**", inputs[0], 2.)
+        raise _ProfileTracerError()
+
+def _trace_profile(f, nvariables):
+    """Expression of the profile `f` in terms of the variables v0, v1, ..., or None"""
+    try:
+        result = f(*[_ProfileTracer("v"+str(i)) for i in range(nvariables)])
+        return _ProfileTracer.str(result)
+    except Exception:
+        return None
+
+def _compile_profile(f, nvariables):
+    global Main
+    if len(Main)>0 and not Main.compile_profiles:
+        return None
+    return _trace_profile(f, nvariables)
+
+class _ParticlesTracer(object):
+    """Particles whose attributes are symbolic variables, for tracing filters"""
+    def __init__(self, ndim, chi):
+        names = ["x","y","z"][:ndim] + ["px","py","pz","weight","charge"] + (["chi"] if chi else [])
+        for i, name in enumerate(names):
+            setattr(self, name, _ProfileTracer("v"+str(i)))
+
+def _compile_filter(f, ndim, chi):
+    """Expression of the particle filter `f` in terms of the variables
+    x, (y, z,) px, py, pz, weight, charge, (chi,) named v0, v1, ..., or None"""
+    global Main, _iteration_reads
+    if len(Main)>0 and not Main.compile_profiles:
+        return None
+    # Filters reading Main.iteration cannot be compiled: any read is recorded,
+    # even when the filter catches the exception it raises
+    _iteration_reads = []
+    try:
+        expression = _ProfileTracer.str(f(_ParticlesTracer(ndim, chi)))
+        return None if _iteration_reads else expression
+    except Exception:
+        return None
+    finally:
+        _iteration_reads = None
+
+def expression(expr, variables=None, **constants):
+    """Profile defined by a string containing an arithmetic expression.
+    Available functions: exp, log, log10, sqrt, sin, cos, tan, arcsin, arccos, arctan,
+    sinh, cosh, tanh, abs, floor, ceil, arctan2, minimum, maximum, where(condition, a, b).
+    """
+    import math
+    global Main
+    if len(Main)==0:
+        raise Exception("expression profile has been defined before `Main()`")
+    if variables is None:
+        if   Main.geometry == "1Dcartesian": variables = ["x"]
+        elif (Main.geometry == "2Dcartesian" or Main.geometry == "AMcylindrical"): variables = ["x","y"]
+        elif Main.geometry == "3Dcartesian": variables = ["x","y","z"]
+    if isinstance(variables, str):
+        variables = [variables]
+    def dispatch(name, math_function):
+        def f(*args):
+            if any([isinstance(a, _ProfileTracer) for a in args]):
+                return _ProfileTracer.function(name, *args)
+            return math_function(*args)
+        return f
+    def where(c, a, b):
+        if any([isinstance(v, _ProfileTracer) for v in [c, a, b]]):
+            return _ProfileTracer.function("where", c, a, b)
+        return a if c else b
+    namespace = {"__builtins__":{}, "pi":math.pi, "where":where,
+        "abs":dispatch("abs", abs), "arctan2":dispatch("arctan2", math.atan2),
+        "minimum":dispatch("minimum", min), "maximum":dispatch("maximum", max)}
+    for name, math_name in [("exp","exp"), ("log","log"), ("log10","log10"), ("sqrt","sqrt"),
+            ("sin","sin"), ("cos","cos"), ("tan","tan"), ("arcsin","asin"), ("arccos","acos"), ("arctan","atan"),
+            ("sinh","sinh"), ("cosh","cosh"), ("tanh","tanh"), ("floor","floor"), ("ceil","ceil")]:
+        namespace[name] = dispatch(name, getattr(math, math_name))
+    namespace.update(constants)
+    f = eval("lambda "+",".join(variables)+": "+expr, namespace)
+    if _trace_profile(f, len(variables)) is None:
+        raise Exception("expression profile `"+expr+"` could not be compiled")
+    return f
+expression._reserved = True
+
+
 def transformPolarization(polarization_phi, ellipticity):
     from math import pi, sqrt, sin, cos, tan, atan
     e2 = ellipticity**2
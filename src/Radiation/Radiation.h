@@ -36,6 +36,7 @@ public:
     //! \param smpi        MPI properties
     //! \param RadiationTables Cross-section data tables and useful functions
     //                     for nonlinear inverse Compton scattering
+    //! \param rand_gen    Random number generator of the patch
     //! \param istart      Index of the first particle
     //! \param iend        Index of the last particle
     //! \param ithread     Thread index
@@ -44,6 +45,7 @@ public:
         Species *photon_species,
         SmileiMPI *smpi,
         RadiationTables &RadiationTables,
+        Random *rand_gen,
         int istart,
         int iend,
         int ithread, int ipart_ref = 0 ) = 0;
@@ -50,6 +50,7 @@ void RadiationCorrLandauLifshitz::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand_gen,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -49,6 +49,7 @@ public:
         Species *photon_species,
         SmileiMPI *smpi,
         RadiationTables &RadiationTables,
+        Random *rand_gen,
         int istart,
         int iend,
         int ithread, int ipart_ref = 0 );
@@ -47,6 +47,7 @@ void RadiationLandauLifshitz::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand_gen,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -53,6 +53,7 @@ void RadiationMonteCarlo::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand_gen,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -72,17 +73,8 @@ void RadiationMonteCarlo::operator()(
     double *By = &( ( *Bpart )[1*nparts] );
     double *Bz = &( ( *Bpart )[2*nparts] );
 
-    // Charge divided by the square of the mass
-    double charge_over_mass2;
-
     const double one_over_mass_2 = pow( one_over_mass_, 2. );
 
-    // Temporary quantum parameter
-    double particle_chi;
-
-    // Temporary Lorentz factor
-    double gamma;
-
     // Radiated energy
     double cont_rad_energy;
 
@@ -92,12 +84,6 @@ void RadiationMonteCarlo::operator()(
     // Time to emission
     double emission_time;
 
-    // time spent in the iteration
-    double local_it_time;
-
-    // Number of Monte-Carlo iteration
-    int mc_it_nb;
-
     // Momentum shortcut
     double *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
@@ -125,167 +111,221 @@ void RadiationMonteCarlo::operator()(
     // Reinitialize the cumulative radiated energy for the current thread
     radiated_energy_ = 0.;
 
+    const double minimum_chi_discontinuous = RadiationTables.getMinimumChiDiscontinuous();
+    const double minimum_chi_continuous = RadiationTables.getMinimumChiContinuous();
+
     // _______________________________________________________________
     // Computation
+    // The Monte-Carlo iterations inside the time step are done for all the
+    // particles at once: each pass computes gamma, chi and the table
+    // lookups of all the particles that have not reached the end of the
+    // time step in vectorized loops.
+
+    int n_active = iend-istart;
+    resizeBuffers( n_active );
+    int *active = active_.data();
+    double *local_it_time = local_it_time_.data();
+    int *mc_it_nb = mc_it_nb_.data();
+    double *gamma = gamma_.data();
+    double *particle_chi = particle_chi_.data();
+
+    for( int k=0 ; k<n_active ; k++ ) {
+        active[k] = istart+k;
+        local_it_time[k] = 0.;
+        mc_it_nb[k] = 0;
+    }
 
-    for( int ipart=istart ; ipart<iend; ipart++ ) {
-        charge_over_mass2 = ( double )( charge[ipart] )*one_over_mass_2;
-
-        // Init local variables
-        emission_time = 0;
-        local_it_time = 0;
-        mc_it_nb = 0;
-
-        // Monte-Carlo Manager inside the time step
-        while( ( local_it_time < dt_ )
-                &&( mc_it_nb < max_monte_carlo_iterations_ ) ) {
-
-            // Gamma
-            gamma = sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
-                          + momentum[1][ipart]*momentum[1][ipart]
-                          + momentum[2][ipart]*momentum[2][ipart] );
+    while( n_active > 0 ) {
+
+        // Gamma and Lorentz invariant quantum parameter
+        #pragma omp simd
+        for( int k=0 ; k<n_active ; k++ ) {
+            int ipart = active[k];
+            double charge_over_mass2 = ( double )( charge[ipart] )*one_over_mass_2;
+            double px = momentum[0][ipart];
+            double py = momentum[1][ipart];
+            double pz = momentum[2][ipart];
+            gamma[k] = sqrt( 1.0 + px*px + py*py + pz*pz );
+            particle_chi[k] = Radiation::computeParticleChi( charge_over_mass2,
+                              px, py, pz,
+                              gamma[k],
+                              ( *( Ex+ipart-ipart_ref ) ), ( *( Ey+ipart-ipart_ref ) ), ( *( Ez+ipart-ipart_ref ) ),
+                              ( *( Bx+ipart-ipart_ref ) ), ( *( By+ipart-ipart_ref ) ), ( *( Bz+ipart-ipart_ref ) ) );
+        }
 
-            if( gamma==1. ){ // does not apply the MC routine for particles with 0 kinetic energy
-                break;
+        // Discontinuous emission: New emission
+        // If tau[ipart] <= 0, this is a new emission
+        // We also check that particle_chi > chipa_threshold,
+        // else particle_chi is too low to induce a discontinuous emission
+        // The particles with an emission under progress are gathered
+        int n_mc = 0;
+        for( int k=0 ; k<n_active ; k++ ) {
+            int ipart = active[k];
+            // does not apply the MC routine for particles with 0 kinetic energy
+            if( gamma[k]==1. ) {
+                continue;
             }
-
-            // Computation of the Lorentz invariant quantum parameter
-            particle_chi = Radiation::computeParticleChi( charge_over_mass2,
-                           momentum[0][ipart], momentum[1][ipart], momentum[2][ipart],
-                           gamma,
-                           ( *( Ex+ipart-ipart_ref ) ), ( *( Ey+ipart-ipart_ref ) ), ( *( Ez+ipart-ipart_ref ) ),
-                           ( *( Bx+ipart-ipart_ref ) ), ( *( By+ipart-ipart_ref ) ), ( *( Bz+ipart-ipart_ref ) ) );
-
-            // Update the quantum parameter in species
-            // chi[ipart] = particle_chi;
-
-            // Discontinuous emission: New emission
-            // If tau[ipart] <= 0, this is a new emission
-            // We also check that particle_chi > chipa_threshold,
-            // else particle_chi is too low to induce a discontinuous emission
-            if( ( particle_chi > RadiationTables.getMinimumChiDiscontinuous() )
+            if( ( particle_chi[k] > minimum_chi_discontinuous )
                     && ( tau[ipart] <= epsilon_tau_ ) ) {
                 // New final optical depth to reach for emision
                 while( tau[ipart] <= epsilon_tau_ ) {
-                    tau[ipart] = -log( 1.-Rand::uniform() );
+                    tau[ipart] = -log( 1.-rand_gen->uniform() );
                 }
-
             }
-
-            // Discontinuous emission: emission under progress
-            // If epsilon_tau_ > 0
             if( tau[ipart] > epsilon_tau_ ) {
-
-                // from the cross section
-                temp = RadiationTables.computePhotonProductionYield( particle_chi, gamma );
-
-                // Time to discontinuous emission
-                // If this time is > the remaining iteration time,
-                // we have a synchronization
-                emission_time = std::min( tau[ipart]/temp, dt_ - local_it_time );
-
-                // Update of the optical depth
-                tau[ipart] -= temp*emission_time;
-
-                // If the final optical depth is reached
-                if( tau[ipart] <= epsilon_tau_ ) {
-
-                    // Emission of a photon
-                    RadiationMonteCarlo::photonEmission( ipart,
-                                                         particle_chi, gamma,
-                                                         position,
-                                                         momentum,
-                                                         weight,
-                                                         photon_species,
-                                                         RadiationTables );
-
-                    // Optical depth becomes negative meaning
-                    // that a new drawing is possible
-                    // at the next Monte-Carlo iteration
-                    tau[ipart] = -1.;
-                }
-
-                // Incrementation of the Monte-Carlo iteration counter
-                mc_it_nb ++;
-                // Update of the local time
-                local_it_time += emission_time;
-
+                mc_index_[n_mc] = k;
+                mc_chi_[n_mc] = particle_chi[k];
+                mc_gamma_[n_mc] = gamma[k];
+                n_mc++;
             }
+        }
 
-            // Continuous emission
-            // particle_chi needs to be below the discontinuous threshold
-            // particle_chi needs to be above the continuous threshold
-            // No discontunous emission is in progress:
-            // tau[ipart] <= epsilon_tau_
-            else if( ( particle_chi <= RadiationTables.getMinimumChiDiscontinuous() )
-                     && ( tau[ipart] <= epsilon_tau_ )
-                     && ( particle_chi > RadiationTables.getMinimumChiContinuous() )
-                     && ( gamma > 1. ) ) {
-
-                // Remaining time of the iteration
-                emission_time = dt_ - local_it_time;
-
-                // Radiated energy during emission_time
-                cont_rad_energy =
-                    RadiationTables.getRidgersCorrectedRadiatedEnergy( particle_chi,
-                            emission_time );
-
-                // Effect on the momentum
-                temp = cont_rad_energy*gamma/( gamma*gamma-1. );
-                for( int i = 0 ; i<3 ; i++ ) {
-                    momentum[i][ipart] -= temp*momentum[i][ipart];
+        // Continuous emission
+        // particle_chi needs to be below the discontinuous threshold
+        // particle_chi needs to be above the continuous threshold
+        // No discontunous emission is in progress:
+        // tau[ipart] <= epsilon_tau_
+        for( int k=0 ; k<n_active ; k++ ) {
+            int ipart = active[k];
+            if( gamma[k]==1. ) {
+                local_it_time[k] = dt_;
+            } else if( tau[ipart] <= epsilon_tau_ ) {
+                if( ( particle_chi[k] <= minimum_chi_discontinuous )
+                        && ( particle_chi[k] > minimum_chi_continuous )
+                        && ( gamma[k] > 1. ) ) {
+
+                    // Remaining time of the iteration
+                    emission_time = dt_ - local_it_time[k];
+
+                    // Radiated energy during emission_time
+                    cont_rad_energy =
+                        RadiationTables.getRidgersCorrectedRadiatedEnergy( particle_chi[k],
+                                emission_time );
+
+                    // Effect on the momentum
+                    temp = cont_rad_energy*gamma[k]/( gamma[k]*gamma[k]-1. );
+                    for( int i = 0 ; i<3 ; i++ ) {
+                        momentum[i][ipart] -= temp*momentum[i][ipart];
+                    }
+
+                    // Incrementation of the radiated energy cumulative parameter
+                    radiated_energy_ += weight[ipart]*( gamma[k] - sqrt( 1.0
+                                                        + momentum[0][ipart]*momentum[0][ipart]
+                                                        + momentum[1][ipart]*momentum[1][ipart]
+                                                        + momentum[2][ipart]*momentum[2][ipart] ) );
                 }
-
-                // Incrementation of the radiated energy cumulative parameter
-                radiated_energy_ += weight[ipart]*( gamma - sqrt( 1.0
-                                                    + momentum[0][ipart]*momentum[0][ipart]
-                                                    + momentum[1][ipart]*momentum[1][ipart]
-                                                    + momentum[2][ipart]*momentum[2][ipart] ) );
-
                 // End for this particle
-                local_it_time = dt_;
+                // (no emission if particle_chi is too low)
+                local_it_time[k] = dt_;
             }
-            // No emission since particle_chi is too low
-            else { // if (particle_chi < RadiationTables.getMinimumChiContinuous())
-                local_it_time = dt_;
+        }
+
+        // Photon production yields from the cross section
+        RadiationTables.computePhotonProductionYield( n_mc, mc_chi_.data(), mc_gamma_.data(), mc_yield_.data() );
+
+        // Discontinuous emission: emission under progress
+        int n_emit = 0;
+        for( int imc=0 ; imc<n_mc ; imc++ ) {
+            int k = mc_index_[imc];
+            int ipart = active[k];
+
+            // Time to discontinuous emission
+            // If this time is > the remaining iteration time,
+            // we have a synchronization
+            emission_time = std::min( tau[ipart]/mc_yield_[imc], dt_ - local_it_time[k] );
+
+            // Update of the optical depth
+            tau[ipart] -= mc_yield_[imc]*emission_time;
+
+            // If the final optical depth is reached, a photon is emitted (below)
+            // Optical depth becomes negative meaning
+            // that a new drawing is possible
+            // at the next Monte-Carlo iteration
+            if( tau[ipart] <= epsilon_tau_ ) {
+                mc_index_[n_emit] = k;
+                mc_chi_[n_emit] = particle_chi[k];
+                n_emit++;
+                tau[ipart] = -1.;
             }
 
+            // Incrementation of the Monte-Carlo iteration counter
+            mc_it_nb[k] ++;
+            // Update of the local time
+            local_it_time[k] += emission_time;
+        }
+
+        // Emission of the photons
+        RadiationTables.computeRandomPhotonChi( n_emit, mc_chi_.data(), photon_chi_.data(), rand_gen );
+        for( int iemit=0 ; iemit<n_emit ; iemit++ ) {
+            int k = mc_index_[iemit];
+            RadiationMonteCarlo::photonEmission( active[k],
+                                                 particle_chi[k], gamma[k],
+                                                 photon_chi_[iemit],
+                                                 position,
+                                                 momentum,
+                                                 weight,
+                                                 photon_species );
         }
 
+        // Particles which have not reached the end of the time step
+        int n_left = 0;
+        for( int k=0 ; k<n_active ; k++ ) {
+            if( ( local_it_time[k] < dt_ ) && ( mc_it_nb[k] < max_monte_carlo_iterations_ ) ) {
+                active[n_left] = active[k];
+                local_it_time[n_left] = local_it_time[k];
+                mc_it_nb[n_left] = mc_it_nb[k];
+                n_left++;
+            }
+        }
+        n_active = n_left;
     }
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Resize the buffers of the Monte-Carlo passes for n particles
+// ---------------------------------------------------------------------------------------------------------------------
+void RadiationMonteCarlo::resizeBuffers( int n )
+{
+    if( ( int )active_.size() < n ) {
+        active_.resize( n );
+        local_it_time_.resize( n );
+        mc_it_nb_.resize( n );
+        gamma_.resize( n );
+        particle_chi_.resize( n );
+        mc_index_.resize( n );
+        mc_chi_.resize( n );
+        mc_gamma_.resize( n );
+        mc_yield_.resize( n );
+        photon_chi_.resize( n );
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 //! Perform the photon emission (creation of a super-photon
 //! and slow down of the emitting particle)
 //! \param ipart              particle index
 //! \param particle_chi              particle quantum parameter
 //! \param particle_gamma            particle gamma factor
+//! \param photon_chi         photon quantum parameter (from RadiationTables::computeRandomPhotonChi)
 //! \param position           particle position
 //! \param momentum           particle momentum
-//! \param RadiationTables    Cross-section data tables and useful functions
-//                        for nonlinear inverse Compton scattering
 // ---------------------------------------------------------------------------------------------------------------------
 void RadiationMonteCarlo::photonEmission( int ipart,
         double &particle_chi,
         double &particle_gamma,
+        double photon_chi,
         double *position[3],
         double *momentum[3],
         double *weight,
-        Species *photon_species,
-        RadiationTables &RadiationTables )
+        Species *photon_species )
 {
     // ____________________________________________________
     // Parameters
-    double photon_chi;      // Photon quantum parameter
     double gammaph;    // Photon gamma factor
     double inv_old_norm_p;
     //double new_norm_p;
 
-    // Get the photon quantum parameter from the table xip
-    photon_chi = RadiationTables.computeRandomPhotonChi( particle_chi );
-
     // compute the photon gamma factor
     gammaph = photon_chi/particle_chi*( particle_gamma-1.0 );
 
@@ -49,6 +49,7 @@ public:
         Species *photon_species,
         SmileiMPI *smpi,
         RadiationTables &RadiationTables,
+        Random *rand_gen,
         int istart,
         int iend,
         int ithread, int ipart_ref = 0 );
@@ -59,19 +60,18 @@ public:
     //! \param ipart              particle index
     //! \param particle_chi          particle quantum parameter
     //! \param particle_gamma          particle gamma factor
+    //! \param photon_chi         photon quantum parameter
     //! \param position           particle position
     //! \param momentum           particle momentum
-    //! \param RadiationTables    Cross-section data tables and useful functions
-    //                        for nonlinear inverse Compton scattering
     // ---------------------------------------------------------------------
     void photonEmission( int ipart,
                          double &particle_chi,
                          double &particle_gamma,
+                         double photon_chi,
                          double *position[3],
                          double *momentum[3],
                          double *weight,
-                         Species *photon_species,
-                         RadiationTables &RadiationTables );
+                         Species *photon_species );
                          
 protected:
 
@@ -97,6 +97,27 @@ protected:
     
 private:
 
+    //! Resize the buffers of the Monte-Carlo passes for n particles
+    void resizeBuffers( int n );
+
+    // Buffers of the Monte-Carlo passes over the particles that have not
+    // reached the end of the time step (kept between calls)
+
+    //! Indexes of these particles
+    std::vector<int> active_;
+    //! Time spent in the current time step
+    std::vector<double> local_it_time_;
+    //! Number of Monte-Carlo iterations in the current time step
+    std::vector<int> mc_it_nb_;
+    //! Lorentz factor and quantum parameter
+    std::vector<double> gamma_, particle_chi_;
+    //! Particles with a discontinuous emission under progress (index in active_),
+    //! then particles emitting a photon
+    std::vector<int> mc_index_;
+    //! Quantum parameter, Lorentz factor and photon production yield of these particles
+    std::vector<double> mc_chi_, mc_gamma_, mc_yield_;
+    //! Quantum parameter of the emitted photons
+    std::vector<double> photon_chi_;
 };
 
 #endif
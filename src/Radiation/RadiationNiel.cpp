@@ -50,6 +50,7 @@ void RadiationNiel::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand_gen,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -146,33 +147,10 @@ void RadiationNiel::operator()(
     
     //double t1 = MPI_Wtime();
     
-    // Non-vectorized computation of the random number
-    /*for (ipart=0 ; ipart < nbparticles; ipart++ )
-    {
-    
-        // Below particle_chi = minimum_chi_continuous_, radiation losses are negligible
-        if (particle_chi[ipart] > minimum_chi_continuous_)
-        {
-    
-          // Pick a random number in the normal distribution of standard
-          // deviation sqrt(dt_) (variance dt_)
-          random_numbers[ipart] = Rand::normal(sqrtdt);
-        }
-    }*/
-    
     // Vectorized computation of the random number in a uniform distribution
-    #pragma omp simd
-    for( ipart=0 ; ipart < nbparticles; ipart++ ) {
-    
-        // Below particle_chi = minimum_chi_continuous_, radiation losses are negligible
-        if( particle_chi[ipart] > minimum_chi_continuous_ ) {
-        
-            // Pick a random number in the normal distribution of standard
-            // deviation sqrt(dt_) (variance dt_)
-            //random_numbers[ipart] = 2.*Rand::uniform() -1.;
-            random_numbers[ipart] = 2.*drand48() -1.;
-        }
-    }
+    // Below particle_chi = minimum_chi_continuous_, radiation losses are negligible
+    // and the random numbers are simply not used
+    rand_gen->uniform2( random_numbers, nbparticles );
     
     // Vectorized computation of the random number in a normal distribution
     double p;
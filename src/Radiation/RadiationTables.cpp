@@ -16,8 +16,10 @@
 #include <iomanip>
 
 #include <cmath>
+#include <algorithm>
 
 #include "userFunctions.h"
+#include "TableCache.h"
 
 // -----------------------------------------------------------------------------
 // INITILIZATION AND DESTRUCTION
@@ -131,6 +133,9 @@ void RadiationTables::initializeParameters( Params &params , SmileiMPI *smpi )
             if( params.hasNielRadiation || params.hasMCRadiation ) {
                 // Format of the tables
                 PyTools::extract( "output_format", output_format_, "RadiationReaction" );
+
+                // Cache of the computed tables
+                PyTools::extract( "table_cache_path", table_cache_path_, "RadiationReaction" );
             }
 
             // Some checks for the table parameters
@@ -279,10 +284,6 @@ void RadiationTables::computeHTable( SmileiMPI *smpi )
     // Allocation of the array h_table
     h_table.resize( h_dim );
 
-    // Allocation of the table for load repartition
-    imin_table = new int[nb_ranks];
-    length_table = new int[nb_ranks];
-
     // Computation of the delta
     h_chipa_delta = ( log10( h_chipa_max )
                       - h_log10_chipa_min )/( h_dim-1 );
@@ -290,6 +291,19 @@ void RadiationTables::computeHTable( SmileiMPI *smpi )
     // Inverse delta
     h_chipa_inv_delta = 1./h_chipa_delta;
 
+    // The table may have been computed by a previous run with the same parameters
+    TableCache cache( table_cache_path_, "radiation_h" );
+    cache << h_dim << h_chipa_min << h_chipa_max;
+    if( cache.load( smpi, { &h_table } ) ) {
+        h_computed = true;
+        MESSAGE( 2,"Read from the cache `" << cache.filename() << "`" );
+        return;
+    }
+
+    // Allocation of the table for load repartition
+    imin_table = new int[nb_ranks];
+    length_table = new int[nb_ranks];
+
     // Load repartition
     userFunctions::distributeArray( nb_ranks,
             h_dim,
@@ -342,6 +356,9 @@ void RadiationTables::computeHTable( SmileiMPI *smpi )
     // flag computed at true
     h_computed = true;
 
+    // Store the table for the next runs
+    cache.store( smpi, { &h_table } );
+
     // Free memory
     delete buffer;
     delete imin_table;
@@ -392,10 +409,6 @@ void RadiationTables::computeIntegfochiTable( SmileiMPI *smpi )
     // Allocation of the array integfochi_table
     integfochi_table.resize( integfochi_dim );
 
-    // Allocation of the table for load repartition
-    imin_table = new int[nb_ranks];
-    length_table = new int[nb_ranks];
-
     // Computation of the delta
     integfochi_chipa_delta = ( log10( integfochi_chipa_max )
                                - integfochi_log10_chipa_min )/( integfochi_dim-1 );
@@ -403,6 +416,19 @@ void RadiationTables::computeIntegfochiTable( SmileiMPI *smpi )
     // Inverse delta
     integfochi_chipa_inv_delta = 1./integfochi_chipa_delta;
 
+    // The table may have been computed by a previous run with the same parameters
+    TableCache cache( table_cache_path_, "radiation_integfochi" );
+    cache << integfochi_dim << integfochi_chipa_min << integfochi_chipa_max;
+    if( cache.load( smpi, { &integfochi_table } ) ) {
+        integfochi_computed = true;
+        MESSAGE( 2,"Read from the cache `" << cache.filename() << "`" );
+        return;
+    }
+
+    // Allocation of the table for load repartition
+    imin_table = new int[nb_ranks];
+    length_table = new int[nb_ranks];
+
     // Load repartition
     userFunctions::distributeArray( nb_ranks,
             integfochi_dim,
@@ -447,6 +473,9 @@ void RadiationTables::computeIntegfochiTable( SmileiMPI *smpi )
     // flag computed at true
     integfochi_computed = true;
 
+    // Store the table for the next runs
+    cache.store( smpi, { &integfochi_table } );
+
     // Free memory
     delete buffer;
     delete imin_table;
@@ -511,10 +540,6 @@ void RadiationTables::computeXipTable( SmileiMPI *smpi )
     // Allocation of the array xip_table
     xip_table.resize( xip_chipa_dim*xip_chiph_dim );
 
-    // Allocation of the table for load repartition
-    imin_table = new int[nb_ranks];
-    length_table = new int[nb_ranks];
-
     // Computation of the delta
     xip_chipa_delta = ( log10( xip_chipa_max )
                         - xip_log10_chipa_min )/( xip_chipa_dim-1 );
@@ -522,6 +547,19 @@ void RadiationTables::computeXipTable( SmileiMPI *smpi )
     // Inverse of delta
     xip_chipa_inv_delta = 1./xip_chipa_delta;
 
+    // The table may have been computed by a previous run with the same parameters
+    TableCache cache( table_cache_path_, "radiation_xip" );
+    cache << xip_chipa_dim << xip_chiph_dim << xip_chipa_min << xip_chipa_max << xip_power << xip_threshold;
+    if( cache.load( smpi, { &xip_chiphmin_table, &xip_table } ) ) {
+        xip_computed = true;
+        MESSAGE( 2,"Read from the cache `" << cache.filename() << "`" );
+        return;
+    }
+
+    // Allocation of the table for load repartition
+    imin_table = new int[nb_ranks];
+    length_table = new int[nb_ranks];
+
     // Load repartition
     userFunctions::distributeArray( nb_ranks,
             xip_chipa_dim,
@@ -674,6 +712,9 @@ void RadiationTables::computeXipTable( SmileiMPI *smpi )
     // flag computed at true
     xip_computed = true;
 
+    // Store the table for the next runs
+    cache.store( smpi, { &xip_chiphmin_table, &xip_table } );
+
     // clean temporary arrays
     delete buffer;
     delete length_table;
@@ -1108,156 +1149,99 @@ void RadiationTables::outputTables( SmileiMPI *smpi )
 // -----------------------------------------------------------------------------
 
 // -----------------------------------------------------------------------------
-//! Computation of the photon quantum parameter photon_chi for emission
+//! Computation of the photon quantum parameters photon_chi for n emissions
 //! ramdomly and using the tables xip and chiphmin
 //
-//! \param particle_chi particle quantum parameter
+//! \param n number of emitting particles
+//! \param particle_chi particle quantum parameters
+//! \param photon_chi photon quantum parameters (output)
+//! \param rand_gen random number generator of the patch
 // -----------------------------------------------------------------------------
-double RadiationTables::computeRandomPhotonChi( double particle_chi )
+void RadiationTables::computeRandomPhotonChi( int n, const double *particle_chi, double *photon_chi, Random *rand_gen )
 {
-    // Log10 of particle_chi
-    double logchipa;
-    double photon_chi;
-    double chiph_xip_delta;
-    // Random xip
-    double xip;
-    int ichipa;
-    int ichiph;
-    // For the interpolation
-    double log10_chiphm;
-    double log10_chiphp;
-    double d;
-    int ixip;
-
-    logchipa = log10( particle_chi );
-
-    // ---------------------------------------
-    // index of particle_chi in xip_table
-    // ---------------------------------------
-    // Use floor so that particle_chi corresponding to ichipa is <= given particle_chi
-    ichipa = int( floor( ( logchipa-xip_log10_chipa_min )*( xip_chipa_inv_delta ) ) );
-
-    // Checking that ichipa is in the range of the tables
-    // Else we use the values at the boundaries
-    if( ichipa < 0 ) {
-        ichipa = 0;
-    } else if( ichipa > xip_chipa_dim-1 ) {
-        ichipa = xip_chipa_dim-1;
-    }
-
-    // ---------------------------------------
-    // Search of the index ichiph for photon_chi
-    // ---------------------------------------
-
-    // First, we compute a random xip in [0,1[
-    xip = Rand::uniform();
-
-    // If the randomly computed xip if below the first one of the row,
-    // we take the first one which corresponds to the minimal photon photon_chi
-    if( xip <= xip_table[ichipa*xip_chiph_dim] ) {
-        ichiph = 0;
-        xip = xip_table[ichipa*xip_chiph_dim];
-    }
-    // Above the last xip of the row, the last one corresponds
-    // to the maximal photon photon_chi
-    else if( xip > xip_table[( ichipa+1 )*xip_chiph_dim-2] ) {
-        ichiph = xip_chiph_dim-2;
-        xip = xip_table[( ichipa+1 )*xip_chiph_dim-1];
-        // If nearest point: ichiph = xip_chiph_dim-1
-    } else {
-        // Search for the corresponding index ichiph for xip
-        ichiph = userFunctions::searchValuesInMonotonicArray(
-                     &xip_table[ichipa*xip_chiph_dim], xip, xip_chiph_dim );
-    }
-
-    // Corresponding particle_chi for ichipa
-    logchipa = ichipa*xip_chipa_delta+xip_log10_chipa_min;
-
-    // Delta for the corresponding particle_chi
-    chiph_xip_delta = ( logchipa - xip_chiphmin_table[ichipa] )
-                      *xip_inv_chiph_dim_minus_one;
-
-    // --------------------------------------------------------------------
-    // Compute photon_chi
-    // This method is slow but more accurate than taking the nearest point
-    // --------------------------------------------------------------------
-
-    ixip = ichipa*xip_chiph_dim + ichiph;
-
-    // Computation of the final photon_chi by interpolation
-    if( xip_table[ixip+1] - xip_table[ixip] > 1e-15 ) {
-        log10_chiphm = ichiph*chiph_xip_delta
-                       + xip_chiphmin_table[ichipa];
-        log10_chiphp = log10_chiphm + chiph_xip_delta;
-
-        d = ( xip - xip_table[ixip] ) / ( xip_table[ixip+1] - xip_table[ixip] );
-
-        // Chiph after linear interpolation in the logarithmic scale
-        photon_chi = pow( 10., log10_chiphm*( 1.0-d ) + log10_chiphp*( d ) );
-    } else
+    // Random xip in [0,1[ drawn for all particles, stored in photon_chi
+    rand_gen->uniform( photon_chi, n );
+
+    const double *table = xip_table.data();
+    const double *chiphmin = xip_chiphmin_table.data();
+    const int chipa_dim = xip_chipa_dim;
+    const int chiph_dim = xip_chiph_dim;
+
+    #pragma omp simd
+    for( int i=0 ; i<n ; i++ ) {
+        double xip = photon_chi[i];
+
+        // Index of particle_chi in xip_table
+        // Use floor so that particle_chi corresponding to ichipa is <= given particle_chi
+        // Out of the table, we use the values at the boundaries
+        int ichipa = int( floor( ( log10( particle_chi[i] )-xip_log10_chipa_min )*( xip_chipa_inv_delta ) ) );
+        ichipa = std::min( std::max( ichipa, 0 ), chipa_dim-1 );
+        const double *row = &table[ichipa*chiph_dim];
+
+        // Index ichiph for photon_chi
+        int ichiph = userFunctions::searchValuesInMonotonicArrayBranchless( row, xip, chiph_dim );
+        // Below the first xip of the row: minimal photon_chi
+        // Above the last xip of the row: maximal photon_chi
+        bool below = ( xip <= row[0] );
+        bool above = ( xip > row[chiph_dim-2] );
+        ichiph = below ? 0 : ( above ? chiph_dim-2 : ichiph );
+        xip    = below ? row[0] : ( above ? row[chiph_dim-1] : xip );
+
+        // Corresponding particle_chi for ichipa
+        double logchipa = ichipa*xip_chipa_delta+xip_log10_chipa_min;
+
+        // Delta for the corresponding particle_chi
+        double chiph_xip_delta = ( logchipa - chiphmin[ichipa] )
+                                 *xip_inv_chiph_dim_minus_one;
+
+        // Computation of the final photon_chi by interpolation in the logarithmic scale
         // For integration reasons, we can have xip_table[ixip+1] = xip_table[ixip]
         // In this case, no interpolation
-    {
-        photon_chi = pow( 10., ichiph*chiph_xip_delta
-                          + xip_chiphmin_table[ichipa] );
-    }
-
-    // ------------------------------------------------------------
-    // Compute photon_chi
-    // Fastest method using the nearest point but less accurate
-    // ------------------------------------------------------------
+        double log10_chiphm = ichiph*chiph_xip_delta + chiphmin[ichipa];
+        double log10_chiphp = log10_chiphm + chiph_xip_delta;
+        double dxip = row[ichiph+1] - row[ichiph];
+        double d = ( dxip > 1e-15 ) ? ( xip - row[ichiph] ) / dxip : 0.;
 
-    /*photon_chi = pow(10.,ichiph*chiph_xip_delta
-           + xip_chiphmin_table[ichipa]);*/
-
-
-    return photon_chi;
+        photon_chi[i] = pow( 10., log10_chiphm*( 1.0-d ) + log10_chiphp*( d ) );
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 //! Computation of the Cross Section dNph/dt which is also
-//! the number of photons generated per time unit.
+//! the number of photons generated per time unit, for n particles.
+//! Out of the table, the values at the boundaries are used.
 //
-//! \param particle_chi particle quantum parameter
-//! \param particle_gamma particle gamma factor
+//! \param n number of particles
+//! \param particle_chi particle quantum parameters
+//! \param particle_gamma particle gamma factors
+//! \param yield dNph/dt (output)
 // ---------------------------------------------------------------------------------------------------------------------
-double RadiationTables::computePhotonProductionYield( double particle_chi, double particle_gamma )
+void RadiationTables::computePhotonProductionYield( int n, const double *particle_chi, const double *particle_gamma, double *yield )
 {
+    const double *table = integfochi_table.data();
+    const int dim = integfochi_dim;
 
-    // Log of the particle quantum parameter particle_chi
-    double logchipa;
-    double logchipam;
-    double logchipap;
-    // Index
-    int ichipa;
-    // final value
-    double dNphdt;
-
-    logchipa = log10( particle_chi );
-
-    // Lower index for interpolation in the table integfochi
-    ichipa = int( floor( ( logchipa-integfochi_log10_chipa_min )
-                         *integfochi_chipa_inv_delta ) );
-
-    // If we are not in the table...
-    if( ichipa < 0 ) {
-        ichipa = 0;
-        dNphdt = integfochi_table[ichipa];
-    } else if( ichipa >= integfochi_dim-1 ) {
-        ichipa = integfochi_dim-2;
-        dNphdt = integfochi_table[ichipa];
-    } else {
-        // Upper and lower values for linear interpolation
-        logchipam = ichipa*integfochi_chipa_delta + integfochi_log10_chipa_min;
-        logchipap = logchipam + integfochi_chipa_delta;
+    #pragma omp simd
+    for( int i=0 ; i<n ; i++ ) {
+        double logchipa = log10( particle_chi[i] );
 
-        // Interpolation
-        dNphdt = ( integfochi_table[ichipa+1]*fabs( logchipa-logchipam ) +
-                   integfochi_table[ichipa]*fabs( logchipap - logchipa ) )*integfochi_chipa_inv_delta;
-    }
+        // Lower index for interpolation in the table integfochi
+        int ichipa = int( floor( ( logchipa-integfochi_log10_chipa_min )
+                                 *integfochi_chipa_inv_delta ) );
+        bool inside = ( ichipa >= 0 ) && ( ichipa < dim-1 );
+        ichipa = std::min( std::max( ichipa, 0 ), dim-2 );
 
-    return factor_dNphdt*dNphdt*particle_chi/particle_gamma;
+        // Upper and lower values for linear interpolation
+        double logchipam = ichipa*integfochi_chipa_delta + integfochi_log10_chipa_min;
+        double logchipap = logchipam + integfochi_chipa_delta;
+
+        double dNphdt = inside ?
+                        ( table[ichipa+1]*fabs( logchipa-logchipam ) +
+                          table[ichipa]*fabs( logchipap - logchipa ) )*integfochi_chipa_inv_delta
+                        : table[ichipa];
 
+        yield[i] = factor_dNphdt*dNphdt*particle_chi[i]/particle_gamma[i];
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1452,10 +1436,12 @@ double RadiationTables::getHNielFromTable( double particle_chi )
 //! of Niel et al.
 //! \param gamma particle Lorentz factor
 //! \param particle_chi particle quantum parameter
+//! \param rand_gen random number generator of the patch
 // -----------------------------------------------------------------------------
 double RadiationTables::getNielStochasticTerm( double gamma,
         double particle_chi,
-        double sqrtdt )
+        double sqrtdt,
+        Random *rand_gen )
 {
     // Get the value of h for the corresponding particle_chi
     double h, r;
@@ -1464,12 +1450,7 @@ double RadiationTables::getNielStochasticTerm( double gamma,
 
     // Pick a random number in the normal distribution of standard
     // deviation sqrt(dt) (variance dt)
-    r = Rand::normal( sqrtdt );
-
-    /*std::random_device device;
-    std::mt19937 gen(device());
-    std::normal_distribution<double> normal_distribution(0., sqrt(dt));
-    r = normal_distribution(gen);*/
+    r = rand_gen->normal( sqrtdt );
 
     return sqrt( factor_classical_radiated_power_*gamma*h )*r;
 }
@@ -19,6 +19,7 @@
 
 #include "Params.h"
 #include "H5.h"
+#include "Random.h"
 
 //------------------------------------------------------------------------------
 //! RadiationTables class: holds parameters, tables and functions to compute
@@ -57,8 +58,11 @@ public:
             double eps );
 
     //! Computation of the photon production yield dNph/dt which is
-    //! also the cross-section for the Monte-Carlo
-    double computePhotonProductionYield( double particle_chi, double particle_gamma );
+    //! also the cross-section for the Monte-Carlo, for n particles (vectorized)
+    //! \param particle_chi particle quantum parameters
+    //! \param particle_gamma particle Lorentz factors
+    //! \param yield photon production yields (output)
+    void computePhotonProductionYield( int n, const double *particle_chi, const double *particle_gamma, double *yield );
 
     //! Compute the integration of the synchrotron emissivity S/chi
     //! refered to as K in the documentation
@@ -72,12 +76,14 @@ public:
             int nb_iterations,
             double eps );
 
-    //! Determine randomly a photon quantum parameter photon_chi
-    //! for an emission process
-    //! from a particle chi value (particle_chi) and
-    //! using the tables xip and chiphmin
-    //! \param particle_chi particle quantum parameter
-    double computeRandomPhotonChi( double particle_chi );
+    //! Determine randomly the photon quantum parameters photon_chi
+    //! of n emission processes
+    //! from the particle chi values (particle_chi) and
+    //! using the tables xip and chiphmin (vectorized)
+    //! \param particle_chi particle quantum parameters
+    //! \param photon_chi photon quantum parameters (output)
+    //! \param rand_gen random number generator of the patch
+    void computeRandomPhotonChi( int n, const double *particle_chi, double *photon_chi, Random *rand_gen );
 
     //! Return the value of the function h(particle_chi) of Niel et al.
     //! Use an integration of Gauss-Legendre
@@ -97,9 +103,11 @@ public:
     //! \param gamma particle Lorentz factor
     //! \param particle_chi particle quantum parameter
     //! \param dt time step
+    //! \param rand_gen random number generator of the patch
     double getNielStochasticTerm( double gamma,
                                   double particle_chi,
-                                  double dt );
+                                  double dt,
+                                  Random *rand_gen );
 
     //! Computation of the corrected continuous quantum radiated energy
     //! during dt from the quantum parameter particle_chi using the Ridgers
@@ -298,6 +306,9 @@ private:
     //! Path to the tables
     std::string table_path_;
 
+    //! Path to the cache of computed tables (no cache if empty)
+    std::string table_cache_path_;
+
     //! Flag that activate the table computation
     bool compute_table_;
 
@@ -149,6 +149,7 @@ int main( int argc, char *argv[] )
         // vecPatches data read in restartAll according to smpi.patch_count
         checkpoint.restartAll( vecPatches, &smpi, simWindow, params, openPMD );
         vecPatches.sortAllParticles( params );
+        vecPatches.calibrateVectorization( params, &smpi );
 
         // Patch reconfiguration for the adaptive vectorization
         if( params.has_adaptive_vectorization ) {
@@ -167,6 +168,7 @@ int main( int argc, char *argv[] )
 
         PatchesFactory::createVector( vecPatches, params, &smpi, openPMD, 0 );
         vecPatches.sortAllParticles( params );
+        vecPatches.calibrateVectorization( params, &smpi );
         //MESSAGE ("create vector");
         // Initialize the electromagnetic fields
         // -------------------------------------
@@ -407,6 +409,8 @@ int main( int argc, char *argv[] )
 
     } //End omp parallel region
 
+    // Make sure the last dump is on disk
+    checkpoint.waitDump();
     smpi.barrier();
 
     // ------------------------------------------------------------------
@@ -186,6 +186,8 @@ void SpeciesMPIbuffers::allocate( unsigned int ndims )
     
     partRecv.resize( ndims );
     partSend.resize( ndims );
+    bufferSend.resize( ndims );
+    bufferRecv.resize( ndims );
     
     part_index_send.resize( ndims );
     part_index_send_sz.resize( ndims );
@@ -196,10 +198,18 @@ void SpeciesMPIbuffers::allocate( unsigned int ndims )
         rrequest[i].resize( 2 );
         partRecv[i].resize( 2 );
         partSend[i].resize( 2 );
+        bufferSend[i].resize( 2 );
+        bufferRecv[i].resize( 2 );
         part_index_send[i].resize( 2 );
         part_index_send_sz[i].resize( 2 );
         part_index_recv_sz[i].resize( 2 );
     }
     
+    unsigned int nall = 1;
+    for( unsigned int i=0 ; i<ndims ; i++ ) {
+        nall *= 3;
+    }
+    partSendAll.resize( nall );
+    
 }
 
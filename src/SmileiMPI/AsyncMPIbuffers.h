@@ -47,6 +47,17 @@ public:
     //! ndim vectors of 2 received packets of particles (1 per direction)
     std::vector< std::vector<Particles > > partSend;
     
+    //! 3^ndim packets of particles sent directly to each surrounding patch, diagonals included
+    //! (single-pass exchange). Index (ox+1) + 3*(oy+1) + 9*(oz+1) for a patch offset (ox, oy, oz)
+    std::vector<Particles> partSendAll;
+    
+    //! ndim vectors of 2 byte buffers in which partSend is packed (1 per direction), kept between iterations
+    std::vector< std::vector< std::vector<char> > > bufferSend;
+    //! ndim vectors of 2 byte buffers received before being unpacked in partRecv (1 per direction)
+    std::vector< std::vector< std::vector<char> > > bufferRecv;
+    //! Byte buffer in which all the particles are packed when the patch is sent to another process
+    std::vector<char> bufferPatch;
+    
     //! ndim vectors of 2 vectors of index particles to send (1 per direction)
     //!   - not sent
     //    - used to sort Species::indexes_of_particles_to_exchange built in Species::dynamics
@@ -0,0 +1,51 @@
+#ifndef PARTICLEEXCHANGEBUFFERS_H
+#define PARTICLEEXCHANGEBUFFERS_H
+
+#include <mpi.h>
+#include <vector>
+#include <cstdint>
+
+//! Buffers of the single-pass particle exchange (see SyncVectorPatch::exchangeParticlesAllNeighbors)
+//! All the particles sent by the patches of this process to the patches of another process,
+//! for all species, are packed in a single message. The buffers are kept between iterations.
+class ParticleExchangeBuffers
+{
+public:
+    ParticleExchangeBuffers() {};
+    ~ParticleExchangeBuffers() {};
+
+    //! Header of a packet of particles in a message, followed by n*Particles::packedSize() bytes
+    struct Header {
+        //! Hindex of the destination patch
+        int hindex;
+        //! Species of the particles
+        int ispec;
+        //! Offset from the source to the destination patch, as in SpeciesMPIbuffers::partSendAll
+        int ioffset;
+        //! Number of particles
+        int n;
+    };
+
+    //! Packet of particles received for a local patch
+    struct Packet {
+        Header header;
+        const char *data;
+    };
+
+    //! Ranks of the processes owning a patch around the local patches (diagonals included)
+    std::vector<int> ranks_;
+
+    //! Number of bytes sent to / received from each process
+    std::vector<uint64_t> send_sizes_, recv_sizes_;
+
+    //! Messages sent to / received from each process
+    std::vector<std::vector<char> > send_buffers_, recv_buffers_;
+
+    //! Send and receive requests (2 per process)
+    std::vector<MPI_Request> requests_;
+
+    //! Packets received by each local patch
+    std::vector<std::vector<Packet> > patch_packets_;
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <climits>
 
 #include <iostream>
 #include <sstream>
@@ -61,6 +62,7 @@ SmileiMPI::SmileiMPI( int *argc, char ***argv )
     SMILEI_COMM_WORLD = MPI_COMM_WORLD;
     MPI_Comm_size( SMILEI_COMM_WORLD, &smilei_sz );
     MPI_Comm_rank( SMILEI_COMM_WORLD, &smilei_rk );
+    MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_PARTICLES );
     
 } // END SmileiMPI::SmileiMPI
 
@@ -73,6 +75,7 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
     
+    MPI_Comm_free( &SMILEI_COMM_PARTICLES );
     MPI_Finalize();
     
 } // END SmileiMPI::~SmileiMPI
@@ -416,21 +419,50 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         Lp_right.resize( patch_count[smilei_rk+1] );
     }
     
+    //Compute particle contribution to Local Loads of each Patch
+    std::vector<double> particle_load( patch_count[smilei_rk], 0. );
+    for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+        for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
+            particle_load[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen_ ) ) ;
+        }
+    }
     
+    //Replace it by the measured compute time of the patches, when available.
+    //The times are converted to particle loads (the average particle keeps a load of 1) so that cell_load keeps its meaning.
+    if( params.measured_load ) {
+        double measured_loc[2] = { 0., 0. }, measured[2];
+        for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+            Patch *patch = vecpatches( ipatch );
+            if( patch->measured_time_ > 0. ) {
+                if( patch->smoothed_load_ < 0. ) {
+                    patch->smoothed_load_ = patch->measured_time_;
+                } else {
+                    patch->smoothed_load_ = params.load_smoothing * patch->measured_time_ + ( 1.-params.load_smoothing ) * patch->smoothed_load_;
+                }
+                patch->measured_time_ = 0.;
+            }
+            if( patch->smoothed_load_ >= 0. ) {
+                measured_loc[0] += patch->smoothed_load_;
+                measured_loc[1] += particle_load[ipatch];
+            }
+        }
+        MPI_Allreduce( measured_loc, measured, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        if( measured[0] > 0. ) {
+            double time_to_load = measured[1] / measured[0];
+            for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+                if( vecpatches( ipatch )->smoothed_load_ >= 0. ) {
+                    particle_load[ipatch] = time_to_load * vecpatches( ipatch )->smoothed_load_;
+                }
+            }
+        }
+    }
     
     while( recompute_tload ) {
     
         Tload_loc = 0.;
         Ncur = 0; // Variation of the number of patches assigned to current rank r.
         for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            Lp[ipatch] =  cells_load ;
-        }
-        
-        //Compute particle contribution to Local Loads of each Patch (Lp)
-        for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
-                Lp[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen_ ) ) ;
-            }
+            Lp[ipatch] = cells_load + particle_load[ipatch];
             Tload_loc += Lp[ipatch];
         }
         
@@ -570,58 +602,6 @@ int SmileiMPI::hrank( int h )
 } // END hrank
 
 
-// ----------------------------------------------------------------------
-// Create MPI type to exchange all particles properties of particles
-// ----------------------------------------------------------------------
-MPI_Datatype SmileiMPI::createMPIparticles( Particles *particles )
-{
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
-    
-    MPI_Aint address[nbrOfProp];
-    for( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->double_prop[iprop] ) )[0] ), &( address[iprop] ) );
-    }
-    for( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->short_prop[iprop] ) )[0] ), &( address[particles->double_prop.size()+iprop] ) );
-    }
-    for( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->uint64_prop[iprop] ) )[0] ), &( address[particles->double_prop.size()+particles->short_prop.size()+iprop] ) );
-    }
-    
-    int nbr_parts[nbrOfProp];
-    // number of elements per property
-    for( int i=0 ; i<nbrOfProp ; i++ ) {
-        nbr_parts[i] = particles->size();
-    }
-    
-    MPI_Aint disp[nbrOfProp];
-    // displacement between 2 properties
-    disp[0] = 0;
-    for( int i=1 ; i<nbrOfProp ; i++ ) {
-        disp[i] = address[i] - address[0];
-    }
-    
-    MPI_Datatype partDataType[nbrOfProp];
-    // define MPI type of each property, default is DOUBLE
-    for( unsigned int i=0 ; i<particles->double_prop.size() ; i++ ) {
-        partDataType[i] = MPI_DOUBLE;
-    }
-    for( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ ) {
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
-    }
-    for( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ ) {
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED_LONG_LONG;
-    }
-    
-    MPI_Datatype typeParticlesMPI;
-    MPI_Type_create_struct( nbrOfProp, &( nbr_parts[0] ), &( disp[0] ), &( partDataType[0] ), &typeParticlesMPI );
-    MPI_Type_commit( &typeParticlesMPI );
-    
-    return typeParticlesMPI;
-    
-} // END createMPIparticles
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // -----------------------------------------       PATCH SEND / RECV METHODS        ------------------------------------
@@ -654,8 +634,7 @@ void SmileiMPI::isend( Patch *patch, int to, int tag, Params &params )
     for( int ispec=0 ; ispec<( int )patch->vecSpecies.size() ; ispec++ ) {
         isend( &( patch->vecSpecies[ispec]->last_index ), to, tag+maxtag+2*ispec+1, patch->requests_[maxtag+2*ispec] );
         if( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            patch->vecSpecies[ispec]->exchangePatch = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            isend( patch->vecSpecies[ispec]->particles, to, tag+maxtag+2*ispec, patch->vecSpecies[ispec]->exchangePatch, patch->requests_[maxtag+2*ispec+1] );
+            isend( patch->vecSpecies[ispec]->particles, to, tag+maxtag+2*ispec, patch->vecSpecies[ispec]->MPI_buffer_.bufferPatch, patch->requests_[maxtag+2*ispec+1] );
         }
     }
     
@@ -678,6 +657,16 @@ void SmileiMPI::isend( Patch *patch, int to, int tag, Params &params )
         }
     }
     
+    // Send the state of the random number generator
+    MPI_Isend( patch->rand_, sizeof( Random ), MPI_BYTE, to, tag + maxtag, SMILEI_COMM_WORLD, &patch->requests_[maxtag] );
+    maxtag ++;
+    
+    // Send the measured load, so that its history follows the patch
+    if( params.measured_load ) {
+        MPI_Isend( &( patch->smoothed_load_ ), 1, MPI_DOUBLE, to, tag + maxtag, SMILEI_COMM_WORLD, &patch->requests_[maxtag] );
+        maxtag ++;
+    }
+    
     // Send fields
     if( params.geometry != "AMcylindrical" ) {
         isend( patch->EMfields, to, maxtag, patch->requests_, tag );
@@ -716,8 +705,7 @@ void SmileiMPI::isend_species( Patch *patch, int to, int tag, Params &params )
     for( int ispec=0 ; ispec<( int )patch->vecSpecies.size() ; ispec++ ) {
         isend( &( patch->vecSpecies[ispec]->last_index ), to, tag+maxtag+2*ispec+1, patch->requests_[maxtag+2*ispec] );
         if( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            patch->vecSpecies[ispec]->exchangePatch = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            isend( patch->vecSpecies[ispec]->particles, to, tag+maxtag+2*ispec, patch->vecSpecies[ispec]->exchangePatch, patch->requests_[maxtag+2*ispec+1] );
+            isend( patch->vecSpecies[ispec]->particles, to, tag+maxtag+2*ispec, patch->vecSpecies[ispec]->MPI_buffer_.bufferPatch, patch->requests_[maxtag+2*ispec+1] );
         }
     }
     
@@ -743,6 +731,15 @@ void SmileiMPI::isend_species( Patch *patch, int to, int tag, Params &params )
             }
         }
     }
+    
+    // Send the state of the random number generator
+    MPI_Isend( patch->rand_, sizeof( Random ), MPI_BYTE, to, tag + maxtag, SMILEI_COMM_WORLD, &patch->requests_[maxtag] );
+    maxtag ++;
+    
+    // Send the measured load, so that its history follows the patch
+    if( params.measured_load ) {
+        MPI_Isend( &( patch->smoothed_load_ ), 1, MPI_DOUBLE, to, tag + maxtag, SMILEI_COMM_WORLD, &patch->requests_[maxtag] );
+    }
 }
 
 void SmileiMPI::isend_fields( Patch *patch, int to, int tag, Params &params )
@@ -769,20 +766,15 @@ void SmileiMPI::waitall( Patch *patch )
         //patch->requests_[ireq] = MPI_REQUEST_NULL;
     }
     
+    // Release the buffers of the sent particles
     for( int ispec=0 ; ispec<( int )patch->vecSpecies.size() ; ispec++ ) {
-        if( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            if( patch->vecSpecies[ispec]->exchangePatch != MPI_DATATYPE_NULL ) {
-                MPI_Type_free( &( patch->vecSpecies[ispec]->exchangePatch ) );
-                patch->vecSpecies[ispec]->exchangePatch = MPI_DATATYPE_NULL;
-            }
-        }
+        std::vector<char>().swap( patch->vecSpecies[ispec]->MPI_buffer_.bufferPatch );
     }
     
 }
 
 void SmileiMPI::recv( Patch *patch, int from, int tag, Params &params )
 {
-    MPI_Datatype recvParts;
     int nbrOfPartsRecv;
     
     // Count number max of comms :int tag
@@ -821,9 +813,7 @@ void SmileiMPI::recv( Patch *patch, int from, int tag, Params &params )
         patch->vecSpecies[ispec]->particles->initialize( nbrOfPartsRecv, params.nDim_particle );
         //Receive particles
         if( nbrOfPartsRecv > 0 ) {
-            recvParts = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            recv( patch->vecSpecies[ispec]->particles, from, maxtag+2*ispec, recvParts );
-            MPI_Type_free( &( recvParts ) );
+            recv( patch->vecSpecies[ispec]->particles, from, maxtag+2*ispec );
         }
         /*std::cerr << "Species: " << ispec
                   << " last_index: " <<  patch->vecSpecies[ispec]->last_index[0]
@@ -855,6 +845,17 @@ void SmileiMPI::recv( Patch *patch, int from, int tag, Params &params )
         }
     }
     
+    // Receive the state of the random number generator
+    MPI_Status status;
+    MPI_Recv( patch->rand_, sizeof( Random ), MPI_BYTE, from, maxtag, SMILEI_COMM_WORLD, &status );
+    maxtag ++;
+    
+    // Receive the measured load
+    if( params.measured_load ) {
+        MPI_Recv( &( patch->smoothed_load_ ), 1, MPI_DOUBLE, from, maxtag, SMILEI_COMM_WORLD, &status );
+        maxtag ++;
+    }
+    
     // Receive EM fields
     patch->EMfields->initAntennas( patch );
     if( params.geometry != "AMcylindrical" ) {
@@ -868,7 +869,6 @@ void SmileiMPI::recv( Patch *patch, int from, int tag, Params &params )
 
 void SmileiMPI::recv_species( Patch *patch, int from, int tag, Params &params )
 {
-    MPI_Datatype recvParts;
     int nbrOfPartsRecv;
     
     // Count number max of comms :int tag
@@ -907,9 +907,7 @@ void SmileiMPI::recv_species( Patch *patch, int from, int tag, Params &params )
         patch->vecSpecies[ispec]->particles->initialize( nbrOfPartsRecv, params.nDim_particle );
         //Receive particles
         if( nbrOfPartsRecv > 0 ) {
-            recvParts = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            recv( patch->vecSpecies[ispec]->particles, from, maxtag+2*ispec, recvParts );
-            MPI_Type_free( &( recvParts ) );
+            recv( patch->vecSpecies[ispec]->particles, from, maxtag+2*ispec );
         }
         /*std::cerr << "Species: " << ispec
                   << " last_index: " <<  patch->vecSpecies[ispec]->last_index[0]
@@ -940,6 +938,16 @@ void SmileiMPI::recv_species( Patch *patch, int from, int tag, Params &params )
             }
         }
     }
+    
+    // Receive the state of the random number generator
+    MPI_Status status;
+    MPI_Recv( patch->rand_, sizeof( Random ), MPI_BYTE, from, maxtag, SMILEI_COMM_WORLD, &status );
+    maxtag ++;
+    
+    // Receive the measured load
+    if( params.measured_load ) {
+        MPI_Recv( &( patch->smoothed_load_ ), 1, MPI_DOUBLE, from, maxtag, SMILEI_COMM_WORLD, &status );
+    }
 }
 
 void SmileiMPI::recv_fields( Patch *patch, int from, int tag, Params &params )
@@ -955,17 +963,26 @@ void SmileiMPI::recv_fields( Patch *patch, int from, int tag, Params &params )
 } // END recv ( Patch )
 
 
-void SmileiMPI::isend( Particles *particles, int to, int tag, MPI_Datatype typePartSend, MPI_Request &request )
+// Particles packed in buffer, which must be kept until the request completes
+void SmileiMPI::isend( Particles *particles, int to, int tag, std::vector<char> &buffer, MPI_Request &request )
 {
-    MPI_Isend( &( particles->position( 0, 0 ) ), 1, typePartSend, to, tag, MPI_COMM_WORLD, &request );
+    buffer.resize( ( size_t )particles->size()*particles->packedSize() );
+    particles->pack( 0, particles->size(), buffer.data() );
+    if( buffer.size() > INT_MAX ) {
+        ERROR( "Cannot send more than 2GB of particles in a patch" );
+    }
+    MPI_Isend( buffer.data(), buffer.size(), MPI_BYTE, to, tag, MPI_COMM_WORLD, &request );
     
 } // END isend( Particles )
 
 
-void SmileiMPI::recv( Particles *particles, int to, int tag, MPI_Datatype typePartRecv )
+// Particles must have been initialized to the number of particles received
+void SmileiMPI::recv( Particles *particles, int from, int tag )
 {
     MPI_Status status;
-    MPI_Recv( &( particles->position( 0, 0 ) ), 1, typePartRecv, to, tag, MPI_COMM_WORLD, &status );
+    std::vector<char> buffer( ( size_t )particles->size()*particles->packedSize() );
+    MPI_Recv( buffer.data(), buffer.size(), MPI_BYTE, from, tag, MPI_COMM_WORLD, &status );
+    particles->unpack( 0, particles->size(), buffer.data() );
     
 } // END recv( Particles )
 
@@ -1082,6 +1099,17 @@ void SmileiMPI::isend( ElectroMagn *EM, int to, int tag, vector<MPI_Request> &re
                 tag++;
                 isend( profile->phase, to, mpi_tag+tag, requests[tag] );
                 tag++;
+            } else {
+                for( unsigned int iprof=0; iprof<2; iprof++ ) {
+                    if( ! laser->spacetime[iprof] ) {
+                        continue;
+                    }
+                    LaserProfileNonSeparable *profile = static_cast<LaserProfileNonSeparable *>( laser->profiles[iprof] );
+                    if( profile->table ) {
+                        isend( profile->table, to, mpi_tag+tag, requests[tag] );
+                        tag++;
+                    }
+                }
             }
         }
         
@@ -1345,6 +1373,17 @@ void SmileiMPI::recv( ElectroMagn *EM, int from, int tag )
                 tag++;
                 recv( profile->phase, from, tag );
                 tag++;
+            } else {
+                for( unsigned int iprof=0; iprof<2; iprof++ ) {
+                    if( ! laser->spacetime[iprof] ) {
+                        continue;
+                    }
+                    LaserProfileNonSeparable *profile = static_cast<LaserProfileNonSeparable *>( laser->profiles[iprof] );
+                    if( profile->table ) {
+                        recv( profile->table, from, tag );
+                        tag++;
+                    }
+                }
             }
         }
         
@@ -1585,6 +1624,7 @@ void SmileiMPI::recv( ProbeParticles *probe, int from, int tag, unsigned int nDi
     MPI_Recv( &nPart, 1, MPI_INT, from, tag+1, MPI_COMM_WORLD, &status );
     // Resize particles
     probe->particles.initialize( nPart, nDim_particles );
+    probe->stencil_ready = false;
     // receive particles
     if( nPart>0 )
         for( unsigned int i=0; i<nDim_particles; i++ ) {
@@ -1726,6 +1766,7 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScalar *scalars, int timestep )
 void SmileiMPI::computeGlobalDiags( DiagnosticParticleBinning *diagParticles, int timestep )
 {
     if( timestep - diagParticles->timeSelection->previousTime() == diagParticles->time_average-1 ) {
+        diagParticles->reduceThreads();
         MPI_Reduce( diagParticles->filename.size()?MPI_IN_PLACE:&diagParticles->data_sum[0], &diagParticles->data_sum[0], diagParticles->output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
         
         if( !isMaster() ) {
@@ -1740,6 +1781,7 @@ void SmileiMPI::computeGlobalDiags( DiagnosticParticleBinning *diagParticles, in
 void SmileiMPI::computeGlobalDiags( DiagnosticScreen *diagScreen, int timestep )
 {
     if( diagScreen->timeSelection->theTimeIsNow( timestep ) ) {
+        diagScreen->reduceThreads();
         MPI_Reduce( diagScreen->filename.size()?MPI_IN_PLACE:&diagScreen->data_sum[0], &diagScreen->data_sum[0], diagScreen->output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
         
         if( !isMaster() ) {
@@ -60,9 +60,6 @@ public:
     // Returns the rank of the MPI process currently owning patch h.
     int hrank( int h );
     
-    // Create MPI type to exchange all particles properties of particles
-    MPI_Datatype createMPIparticles( Particles *particles );
-    
     
     // PATCH SEND / RECV METHODS
     //     - during load balancing process
@@ -77,8 +74,8 @@ public:
     void isend_species( Patch *patch, int to, int hindex, Params &params );
     void recv_species( Patch *patch, int from, int hindex, Params &params );
     
-    void isend( Particles *particles, int to, int hindex, MPI_Datatype datatype, MPI_Request &request );
-    void recv( Particles *partictles, int from, int hindex, MPI_Datatype datatype );
+    void isend( Particles *particles, int to, int hindex, std::vector<char> &buffer, MPI_Request &request );
+    void recv( Particles *particles, int from, int hindex );
     void isend( std::vector<int> *vec, int to, int hindex, MPI_Request &request );
     void recv( std::vector<int> *vec, int from, int hindex );
     
@@ -142,6 +139,12 @@ public:
         return SMILEI_COMM_WORLD;
     }
     
+    //! Return the communicator of the single-pass particle exchange
+    inline MPI_Comm getParticlesComm()
+    {
+        return SMILEI_COMM_PARTICLES;
+    }
+    
     //! Return MPI_Comm_size
     inline int getOMPMaxThreads()
     {
@@ -221,6 +224,10 @@ protected:
     //! Global MPI Communicator
     MPI_Comm SMILEI_COMM_WORLD;
     
+    //! Copy of the global communicator for the single-pass particle exchange,
+    //! whose messages must not match those of the patch exchanges
+    MPI_Comm SMILEI_COMM_PARTICLES;
+    
     //! Number of MPI process in the current communicator
     int smilei_sz;
     //! MPI process Id in the current communicator
@@ -69,6 +69,7 @@ SmileiMPI_test::SmileiMPI_test( int *argc, char ***argv )
     SMILEI_COMM_WORLD = MPI_COMM_WORLD;
     MPI_Comm_size( SMILEI_COMM_WORLD, &smilei_sz );
     MPI_Comm_rank( SMILEI_COMM_WORLD, &smilei_rk );
+    MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_PARTICLES );
     
     if( smilei_sz > 1 ) {
         ERROR( "Test mode cannot be run with several MPI processes. Instead, indicate the MPIxOMP intended partition after the -T argument." );
@@ -89,7 +89,7 @@ PartBoundCond::PartBoundCond( Params &params, Species *species, Patch *patch ) :
     // Define the kind of applied boundary conditions
     // ----------------------------------------------
     
-    int ( *remove )( Particles &, int, int, double, Species *, double & );
+    int ( *remove )( Particles &, int, int, double, Species *, Random *, double & );
     if( species->mass_ == 0 ) {
         remove = &remove_photon;
     } else {
@@ -21,17 +21,17 @@ public:
     
     //! Xmin particles boundary conditions pointers (same prototypes for all conditions)
     //! @see BoundaryConditionType.h for functions that this pointers will target
-    int ( *bc_xmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_xmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     //! Xmax particles boundary conditions pointers
-    int ( *bc_xmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_xmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     //! Ymin particles boundary conditions pointers
-    int ( *bc_ymin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_ymin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     //! Ymax particles boundary conditions pointers
-    int ( *bc_ymax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_ymax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     //! Zmin particles boundary conditions pointers
-    int ( *bc_zmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_zmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     //! Zmax particles boundary conditions pointers
-    int ( *bc_zmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_zmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     
     //! Method which applies particles boundary conditions.
     //! If the MPI process is not a border process, particles will be flagged as an exchange particle returning 0
@@ -39,7 +39,7 @@ public:
     //! The decision whether the particle is added or not on the Exchange Particle List is defined by the final
     //! value of keep_part.
     //! Be careful, once an a BC along a given dimension set keep_part to 0, it will remain to 0.
-    inline int apply( Particles &particles, int ipart, Species *species, double &nrj_iPart )  //, bool &contribute ) {
+    inline int apply( Particles &particles, int ipart, Species *species, Random *rand_gen, double &nrj_iPart )  //, bool &contribute ) {
     {
     
         /*if ((particles.position(0, ipart) > x_max)
@@ -63,13 +63,13 @@ public:
             if( bc_xmin==NULL ) {
                 keep_part = 0;
             } else {
-                keep_part = ( *bc_xmin )( particles, ipart, 0, 2.*x_min, species, nrj_iPart );
+                keep_part = ( *bc_xmin )( particles, ipart, 0, 2.*x_min, species, rand_gen, nrj_iPart );
             }
         } else if( particles.position( 0, ipart ) >= x_max ) {
             if( bc_xmax==NULL ) {
                 keep_part = 0;
             } else {
-                keep_part = ( *bc_xmax )( particles, ipart, 0, 2.*x_max, species, nrj_iPart );
+                keep_part = ( *bc_xmax )( particles, ipart, 0, 2.*x_max, species, rand_gen, nrj_iPart );
             }
         }
         
@@ -81,13 +81,13 @@ public:
                     if( bc_ymin==NULL ) {
                         keep_part = 0;
                     } else {
-                        keep_part *= ( *bc_ymin )( particles, ipart, 1, 2.*y_min, species, nrj_iPart );
+                        keep_part *= ( *bc_ymin )( particles, ipart, 1, 2.*y_min, species, rand_gen, nrj_iPart );
                     }
                 } else if( particles.position( 1, ipart ) >= y_max ) {
                     if( bc_ymax==NULL ) {
                         keep_part = 0;
                     } else {
-                        keep_part *= ( *bc_ymax )( particles, ipart, 1, 2.*y_max, species, nrj_iPart );
+                        keep_part *= ( *bc_ymax )( particles, ipart, 1, 2.*y_max, species, rand_gen, nrj_iPart );
                     }
                 }
                 // iDim = 2
@@ -97,13 +97,13 @@ public:
                         if( bc_zmin==NULL ) {
                             keep_part = 0;
                         } else {
-                            keep_part *= ( *bc_zmin )( particles, ipart, 2, 2.*z_min, species, nrj_iPart );
+                            keep_part *= ( *bc_zmin )( particles, ipart, 2, 2.*z_min, species, rand_gen, nrj_iPart );
                         }
                     } else if( particles.position( 2, ipart ) >= z_max ) {
                         if( bc_zmax==NULL ) {
                             keep_part = 0;
                         } else {
-                            keep_part *= ( *bc_zmax )( particles, ipart, 2, 2.*z_max, species, nrj_iPart );
+                            keep_part *= ( *bc_zmax )( particles, ipart, 2, 2.*z_max, species, rand_gen, nrj_iPart );
                         }
                     }
                 } // end if (nDim_particle == 3)
@@ -115,7 +115,7 @@ public:
                 if( bc_ymax==NULL ) {
                     keep_part = 0;
                 } else {
-                    keep_part *= ( *bc_ymax )( particles, ipart, -1, 2.*y_max, species, nrj_iPart );
+                    keep_part *= ( *bc_ymax )( particles, ipart, -1, 2.*y_max, species, rand_gen, nrj_iPart );
                 }
             }
             if( particles.distance2_to_axis( ipart ) < y_min2 ) {
@@ -7,6 +7,7 @@
 class Patch;
 class Species;
 class Particles;
+class Random;
 
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class PartWall
@@ -26,10 +27,10 @@ public:
     
     //! Wall boundary condition pointer (same prototypes for all conditions)
     //! @see BoundaryConditionType.h for functions that this pointer will target
-    int ( *wall )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *wall )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, Random *rand_gen, double &nrj_iPart );
     
     //! Method which applies particles wall
-    int apply( Particles &particles, int ipart, Species *species, double dtgf, double &nrj_iPart );
+    int apply( Particles &particles, int ipart, Species *species, double dtgf, Random *rand_gen, double &nrj_iPart );
     
 private:
     //! position of a wall in its direction
@@ -0,0 +1,98 @@
+#ifndef PARTICLEPROPERTY_H
+#define PARTICLEPROPERTY_H
+
+#include <vector>
+
+class Particles;
+
+//----------------------------------------------------------------------------------------------------------------------
+//! View on one property (position, momentum, weight, ...) of a Particles object
+//! The data is not owned by the view: all the properties of a Particles object are
+//! stored in a single aligned arena (see Particles::reallocate). The number of
+//! particles is shared by all the properties and can only be changed through
+//! the methods of Particles.
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+class ParticleProperty
+{
+    friend class Particles;
+
+public:
+    ParticleProperty() : data_( nullptr ), size_( nullptr ), capacity_( nullptr ) {}
+
+    //! Number of particles (0 if the property is not used)
+    inline unsigned int size() const
+    {
+        return size_ ? *size_ : 0;
+    }
+
+    //! Number of particles that fit in the arena
+    inline unsigned int capacity() const
+    {
+        return capacity_ ? *capacity_ : 0;
+    }
+
+    inline bool empty() const
+    {
+        return size() == 0;
+    }
+
+    inline T &operator[]( unsigned int i )
+    {
+        return data_[i];
+    }
+    inline const T &operator[]( unsigned int i ) const
+    {
+        return data_[i];
+    }
+
+    //! Pointer to the data, aligned on 64 bytes
+    inline T *data()
+    {
+        return data_;
+    }
+    inline const T *data() const
+    {
+        return data_;
+    }
+
+    inline T *begin()
+    {
+        return data_;
+    }
+    inline T *end()
+    {
+        return data_ + size();
+    }
+    inline const T *begin() const
+    {
+        return data_;
+    }
+    inline const T *end() const
+    {
+        return data_ + size();
+    }
+
+    inline T &back()
+    {
+        return data_[size()-1];
+    }
+
+    //! Copy of the data in a std::vector
+    inline std::vector<T> toVector() const
+    {
+        return std::vector<T>( begin(), end() );
+    }
+
+private:
+    //! Location of the property in the arena
+    T *data_;
+
+    //! Number of particles, owned by the Particles object
+    const unsigned int *size_;
+
+    //! Capacity of the arena, owned by the Particles object
+    const unsigned int *capacity_;
+};
+
+#endif
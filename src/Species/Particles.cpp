@@ -1,5 +1,6 @@
 #include "Particles.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 
@@ -11,13 +12,21 @@
 
 using namespace std;
 
+// Number of bytes occupied by one property of the arena (rounded up to 64 bytes)
+static inline size_t arenaStride( size_t nbytes )
+{
+    return ( ( nbytes + 63 ) / 64 ) * 64;
+}
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructor for Particle
 // ---------------------------------------------------------------------------------------------------------------------
 Particles::Particles():
-    tracked( false )
+    tracked( false ),
+    arena_( nullptr ),
+    n_particles_( 0 ),
+    capacity_( 0 )
 {
     Position.resize( 0 );
     Position_old.resize( 0 );
@@ -32,64 +41,182 @@ Particles::Particles():
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Create nParticles null particles of nDim size
+// Copy constructor for Particle
 // ---------------------------------------------------------------------------------------------------------------------
-void Particles::initialize( unsigned int nParticles, unsigned int nDim )
+Particles::Particles( const Particles &part ):
+    Particles()
 {
-    //if (nParticles > Weight.capacity()) {
-    //    WARNING("You should increase c_part_max in specie namelist");
-    //}
-    if( Weight.size()==0 ) {
-        float c_part_max =1.2;
-        //float c_part_max = part.c_part_max;
-        //float c_part_max = params.species_param[0].c_part_max;
-        reserve( round( c_part_max * nParticles ), nDim );
+    *this = part;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Destructor for Particle
+// ---------------------------------------------------------------------------------------------------------------------
+Particles::~Particles()
+{
+    free( arena_ );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Assignment: same properties, data copied in a new arena
+// ---------------------------------------------------------------------------------------------------------------------
+Particles &Particles::operator=( const Particles &part )
+{
+    if( this == &part ) {
+        return *this;
     }
 
-    resize( nParticles, nDim );
-    cell_keys.resize( nParticles );
+    free( arena_ );
+    arena_ = nullptr;
+    n_particles_ = 0;
+    capacity_ = 0;
 
-    if( double_prop.empty() ) {  // do this just once
+    Position.clear();
+    Position_old.clear();
+    Momentum.clear();
+    Weight = ParticleProperty<double>();
+    Chi    = ParticleProperty<double>();
+    Tau    = ParticleProperty<double>();
+    Charge = ParticleProperty<short>();
+    Id     = ParticleProperty<uint64_t>();
+    double_prop.clear();
+    short_prop.clear();
+    uint64_prop.clear();
 
-        Position.resize( nDim );
-        for( unsigned int i=0 ; i< nDim ; i++ ) {
-            double_prop.push_back( &( Position[i] ) );
-        }
+    is_test = part.is_test;
+    tracked = part.tracked;
+    isQuantumParameter = part.isQuantumParameter;
+    isMonteCarlo = part.isMonteCarlo;
+    cell_keys = part.cell_keys;
+
+    if( ! part.double_prop.empty() ) {
+        initializeProperties( part.dimension() );
+        resize( part.size() );
 
-        for( unsigned int i=0 ; i< 3 ; i++ ) {
-            double_prop.push_back( &( Momentum[i] ) );
+        unsigned int ndouble = min( double_prop.size(), part.double_prop.size() );
+        unsigned int nshort  = min( short_prop.size(), part.short_prop.size() );
+        unsigned int nuint   = min( uint64_prop.size(), part.uint64_prop.size() );
+        for( unsigned int iprop=0 ; iprop<ndouble ; iprop++ ) {
+            memcpy( double_prop[iprop]->data(), part.double_prop[iprop]->data(), n_particles_*sizeof( double ) );
+        }
+        for( unsigned int iprop=0 ; iprop<nshort ; iprop++ ) {
+            memcpy( short_prop[iprop]->data(), part.short_prop[iprop]->data(), n_particles_*sizeof( short ) );
+        }
+        for( unsigned int iprop=0 ; iprop<nuint ; iprop++ ) {
+            memcpy( uint64_prop[iprop]->data(), part.uint64_prop[iprop]->data(), n_particles_*sizeof( uint64_t ) );
         }
+    }
+
+    return *this;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Declare the properties, depending on the particle type (done once)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::initializeProperties( unsigned int nDim )
+{
+    if( ! double_prop.empty() ) {
+        return;
+    }
+
+    Position.resize( nDim );
+    for( unsigned int i=0 ; i< nDim ; i++ ) {
+        bindProperty( Position[i], double_prop );
+    }
+
+    Momentum.resize( 3 );
+    for( unsigned int i=0 ; i< 3 ; i++ ) {
+        bindProperty( Momentum[i], double_prop );
+    }
 
-        double_prop.push_back( &Weight );
+    bindProperty( Weight, double_prop );
 
 #ifdef  __DEBUG
-        Position_old.resize( nDim );
-        for( unsigned int i=0 ; i< nDim ; i++ ) {
-            double_prop.push_back( &( Position_old[i] ) );
-        }
+    Position_old.resize( nDim );
+    for( unsigned int i=0 ; i< nDim ; i++ ) {
+        bindProperty( Position_old[i], double_prop );
+    }
 #endif
 
-        short_prop.push_back( &Charge );
-        if( tracked ) {
-            uint64_prop.push_back( &Id );
-        }
+    bindProperty( Charge, short_prop );
+    if( tracked ) {
+        bindProperty( Id, uint64_prop );
+    }
 
-        // Quantum parameter (for QED effects):
-        // - if radiation reaction (continuous or discontinuous)
-        // - if multiphoton-Breit-Wheeler if photons
-        if( isQuantumParameter ) {
-            double_prop.push_back( &Chi );
-        }
+    // Quantum parameter (for QED effects):
+    // - if radiation reaction (continuous or discontinuous)
+    // - if multiphoton-Breit-Wheeler if photons
+    if( isQuantumParameter ) {
+        bindProperty( Chi, double_prop );
+    }
 
-        // Optical Depth for Monte-Carlo processes:
-        // - if the discontinuous (Monte-Carlo) radiation reaction
-        // are activated, tau is the incremental optical depth to emission
-        if( isMonteCarlo ) {
-            double_prop.push_back( &Tau );
+    // Optical Depth for Monte-Carlo processes:
+    // - if the discontinuous (Monte-Carlo) radiation reaction
+    // are activated, tau is the incremental optical depth to emission
+    if( isMonteCarlo ) {
+        bindProperty( Tau, double_prop );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Move the properties of one type to their new location in the arena
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+void Particles::moveProperties( vector< ParticleProperty<T>* > &prop_list, char *&location, size_t stride, unsigned int n_kept )
+{
+    for( unsigned int iprop=0 ; iprop<prop_list.size() ; iprop++ ) {
+        T *new_data = ( T * )location;
+        if( prop_list[iprop]->data_ && n_kept > 0 ) {
+            memcpy( new_data, prop_list[iprop]->data_, n_kept*sizeof( T ) );
         }
+        prop_list[iprop]->data_ = new_data;
+        location += stride;
+    }
+}
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Allocate a new arena for n_part_max particles and move all properties in it (one allocation for all properties)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::reallocate( unsigned int n_part_max )
+{
+    size_t double_stride = arenaStride( ( size_t )n_part_max*sizeof( double ) );
+    size_t short_stride  = arenaStride( ( size_t )n_part_max*sizeof( short ) );
+    size_t uint64_stride = arenaStride( ( size_t )n_part_max*sizeof( uint64_t ) );
+    size_t arena_size = double_prop.size()*double_stride
+                        + short_prop.size()*short_stride
+                        + uint64_prop.size()*uint64_stride;
+
+    char *new_arena = nullptr;
+    if( arena_size > 0 ) {
+        void *ptr = nullptr;
+        if( posix_memalign( &ptr, 64, arena_size ) != 0 ) {
+            ERROR( "Unable to allocate " << arena_size << " bytes for " << n_part_max << " particles" );
+        }
+        new_arena = ( char * )ptr;
     }
 
+    // Doubles first, then shorts and uint64: every property starts on a 64-byte boundary
+    unsigned int n_kept = min( n_particles_, n_part_max );
+    char *location = new_arena;
+    moveProperties( double_prop, location, double_stride, n_kept );
+    moveProperties( short_prop, location, short_stride, n_kept );
+    moveProperties( uint64_prop, location, uint64_stride, n_kept );
+
+    free( arena_ );
+    arena_ = new_arena;
+    capacity_ = n_part_max;
+    n_particles_ = n_kept;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Create nParticles null particles of nDim size
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::initialize( unsigned int nParticles, unsigned int nDim )
+{
+    initializeProperties( nDim );
+
+    resize( nParticles );
+    cell_keys.resize( nParticles );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -115,33 +242,12 @@ void Particles::initialize( unsigned int nParticles, Particles &part )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
 {
-    return;
-
-    Position.resize( nDim );
-    Position_old.resize( nDim );
-    for( unsigned int i=0 ; i< nDim ; i++ ) {
-        Position[i].reserve( n_part_max );
-        Position_old[i].reserve( n_part_max );
-    }
-    Momentum.resize( 3 );
-    for( unsigned int i=0 ; i< 3 ; i++ ) {
-        Momentum[i].reserve( n_part_max );
-    }
-    Weight.reserve( n_part_max );
-    Charge.reserve( n_part_max );
-
-    if( tracked ) {
-        Id.reserve( n_part_max );
-    }
-
-    if( isQuantumParameter ) {
-        Chi.reserve( n_part_max );
-    }
-
-    if( isMonteCarlo ) {
-        Tau.reserve( n_part_max );
+    // Properties are declared by initialize, when the particle type is known
+    if( double_prop.empty() || n_part_max <= capacity_ ) {
+        return;
     }
 
+    reallocate( n_part_max );
 }
 
 void Particles::initialize_reserve( unsigned int npart_max, Particles &part )
@@ -157,57 +263,41 @@ void Particles::initialize_reserve( unsigned int npart_max, Particles &part )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::resize( unsigned int nParticles, unsigned int nDim )
 {
-    Position.resize( nDim );
-    for( unsigned int i=0 ; i<nDim ; i++ ) {
-        Position[i].resize( nParticles, 0. );
-    }
-#ifdef  __DEBUG
-    Position_old.resize( nDim );
-    for( unsigned int i=0 ; i<nDim ; i++ ) {
-        Position_old[i].resize( nParticles, 0. );
-    }
-#endif
-
-    Momentum.resize( 3 );
-    for( unsigned int i=0 ; i< 3 ; i++ ) {
-        Momentum[i].resize( nParticles, 0. );
-    }
-
-    Weight.resize( nParticles, 0. );
-    Charge.resize( nParticles, 0 );
-
-    if( tracked ) {
-        Id.resize( nParticles, 0 );
-    }
-
-    if( isQuantumParameter ) {
-        Chi.resize( nParticles, 0. );
-    }
-
-    if( isMonteCarlo ) {
-        Tau.resize( nParticles, 0. );
-    }
+    initializeProperties( nDim );
 
+    resize( nParticles );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Resize Particle vectors with nParticles
+// New particles are set to 0. The arena grows geometrically, as std::vector does.
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::resize( unsigned int nParticles)
 {
-
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).resize( nParticles, 0. );
+    if( double_prop.empty() ) {
+        return;
     }
 
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).resize( nParticles, 0 );
+    if( nParticles > capacity_ ) {
+        reallocate( max( nParticles, 2*n_particles_ ) );
     }
 
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).resize( nParticles, 0 );
+    if( nParticles > n_particles_ ) {
+        unsigned int nnew = nParticles - n_particles_;
+        for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+            memset( &( *double_prop[iprop] )[n_particles_], 0, nnew*sizeof( double ) );
+        }
+
+        for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+            memset( &( *short_prop[iprop] )[n_particles_], 0, nnew*sizeof( short ) );
+        }
+
+        for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+            memset( &( *uint64_prop[iprop] )[n_particles_], 0, nnew*sizeof( uint64_t ) );
+        }
     }
 
+    n_particles_ = nParticles;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -215,53 +305,26 @@ void Particles::resize( unsigned int nParticles)
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::shrink_to_fit()
 {
-
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        std::vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        std::vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        std::vector<uint64_t>( *uint64_prop[iprop] ).swap( *uint64_prop[iprop] );
+    if( capacity_ > n_particles_ ) {
+        reallocate( n_particles_ );
     }
 }
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Reset of Particles vectors
+// Reset of Particles vectors (the capacity is kept)
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::clear()
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        double_prop[iprop]->clear();
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        short_prop[iprop]->clear();
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        uint64_prop[iprop]->clear();
-    }
+    n_particles_ = 0;
 }
 
 
 void Particles::cp_particle( unsigned int ipart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        uint64_prop[iprop]->push_back( ( *uint64_prop[iprop] )[ipart] );
-    }
+    unsigned int nParticles = size();
+    resize( nParticles+1 );
+    overwrite_part( ipart, nParticles );
 }
 
 
@@ -270,57 +333,95 @@ void Particles::cp_particle( unsigned int ipart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particle( unsigned int ipart, Particles &dest_parts )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        dest_parts.double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
-    }
+    unsigned int nParticles = dest_parts.size();
+    dest_parts.resize( nParticles+1 );
+    overwrite_part( ipart, dest_parts, nParticles );
+}
 
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert particle iPart at dest_id in dest_parts
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::cp_particle( unsigned int ipart, Particles &dest_parts, int dest_id )
+{
+    dest_parts.create_particles( 1, dest_id );
+    if( &dest_parts == this && ipart >= ( unsigned int )dest_id ) {
+        ipart++;
     }
+    overwrite_part( ipart, dest_parts, dest_id );
+}
 
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->push_back( ( *uint64_prop[iprop] )[ipart] );
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert nPart particles starting at ipart to dest_id in dest_parts
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::cp_particles( unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id )
+{
+    if( nPart == 0 ) {
+        return;
     }
+    dest_parts.create_particles( nPart, dest_id );
+    overwrite_part( iPart, dest_parts, dest_id, nPart );
 }
 
+
 // ---------------------------------------------------------------------------------------------------------------------
-// Insert particle iPart at dest_id in dest_parts
+// Number of bytes of one particle in the buffers of pack / unpack
 // ---------------------------------------------------------------------------------------------------------------------
-void Particles::cp_particle( unsigned int ipart, Particles &dest_parts, int dest_id )
+unsigned int Particles::packedSize()
+{
+    return double_prop.size()*sizeof( double ) + short_prop.size()*sizeof( short ) + uint64_prop.size()*sizeof( uint64_t );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy nPart particles starting at iPart in a contiguous buffer of nPart*packedSize() bytes
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::pack( unsigned int iPart, unsigned int nPart, char *buffer )
 {
     for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, ( *double_prop[iprop] )[ipart] );
+        memcpy( buffer, &( *double_prop[iprop] )[iPart], nPart*sizeof( double ) );
+        buffer += nPart*sizeof( double );
     }
-
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, ( *short_prop[iprop] )[ipart] );
+        memcpy( buffer, &( *short_prop[iprop] )[iPart], nPart*sizeof( short ) );
+        buffer += nPart*sizeof( short );
     }
-
     for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->insert( dest_parts.uint64_prop[iprop]->begin() + dest_id, ( *uint64_prop[iprop] )[ipart] );
+        memcpy( buffer, &( *uint64_prop[iprop] )[iPart], nPart*sizeof( uint64_t ) );
+        buffer += nPart*sizeof( uint64_t );
     }
+}
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Append nPart particles read from a buffer filled by pack
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::unpack( unsigned int nPart, const char *buffer )
+{
+    if( nPart == 0 ) {
+        return;
+    }
+    unsigned int iPart = size();
+    resize( iPart+nPart );
+    unpack( iPart, nPart, buffer );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Insert nPart particles starting at ipart to dest_id in dest_parts
+// Overwrite nPart particles starting at iPart with a buffer filled by pack
 // ---------------------------------------------------------------------------------------------------------------------
-void Particles::cp_particles( unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id )
+void Particles::unpack( unsigned int iPart, unsigned int nPart, const char *buffer )
 {
     for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, double_prop[iprop]->begin()+iPart, double_prop[iprop]->begin()+iPart+nPart );
+        memcpy( &( *double_prop[iprop] )[iPart], buffer, nPart*sizeof( double ) );
+        buffer += nPart*sizeof( double );
     }
-
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, short_prop[iprop]->begin()+iPart, short_prop[iprop]->begin()+iPart+nPart );
+        memcpy( &( *short_prop[iprop] )[iPart], buffer, nPart*sizeof( short ) );
+        buffer += nPart*sizeof( short );
     }
-
     for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->insert( dest_parts.uint64_prop[iprop]->begin() + dest_id, uint64_prop[iprop]->begin()+iPart, uint64_prop[iprop]->begin()+iPart+nPart );
+        memcpy( &( *uint64_prop[iprop] )[iPart], buffer, nPart*sizeof( uint64_t ) );
+        buffer += nPart*sizeof( uint64_t );
     }
 }
 
-
 // ---------------------------------------------------------------------------------------------------------------------
 // Copy particle iPart at the end of dest_parts -- safe
 // ---------------------------------------------------------------------------------------------------------------------
@@ -334,17 +435,20 @@ void Particles::cp_particle_safe( unsigned int ipart, Particles &dest_parts )
     if( dest_parts.uint64_prop.size() < nuint ) {
         nuint = dest_parts.uint64_prop.size();
     }
-    
+
+    unsigned int nParticles = dest_parts.size();
+    dest_parts.resize( nParticles+1 );
+
     for( unsigned int iprop=0 ; iprop<ndouble ; iprop++ ) {
-        dest_parts.double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
+        ( *dest_parts.double_prop[iprop] )[nParticles] = ( *double_prop[iprop] )[ipart];
     }
     
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        dest_parts.short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
+        ( *dest_parts.short_prop[iprop] )[nParticles] = ( *short_prop[iprop] )[ipart];
     }
     
     for( unsigned int iprop=0 ; iprop<nuint ; iprop++ ) {
-        dest_parts.uint64_prop[iprop]->push_back( ( *uint64_prop[iprop] )[ipart] );
+        ( *dest_parts.uint64_prop[iprop] )[nParticles] = ( *uint64_prop[iprop] )[ipart];
     }
 }
 
@@ -354,18 +458,7 @@ void Particles::cp_particle_safe( unsigned int ipart, Particles &dest_parts )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::erase_particle( unsigned int ipart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).erase( ( *uint64_prop[iprop] ).begin()+ipart );
-    }
-
+    erase_particle( ipart, 1 );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -373,36 +466,28 @@ void Particles::erase_particle( unsigned int ipart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::erase_particle_trail( unsigned int ipart )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart, ( *double_prop[iprop] ).end() );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart, ( *short_prop[iprop] ).end() );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).erase( ( *uint64_prop[iprop] ).begin()+ipart, ( *uint64_prop[iprop] ).end() );
-    }
-
+    resize( ipart );
 }
 // ---------------------------------------------------------------------------------------------------------------------
 // Suppress npart particles from ipart
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::erase_particle( unsigned int ipart, unsigned int npart )
 {
+    unsigned int nmoved = n_particles_ - ipart - npart;
+
     for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart, ( *double_prop[iprop] ).begin()+ipart+npart );
+        memmove( &( *double_prop[iprop] )[ipart], &( *double_prop[iprop] )[ipart+npart], nmoved*sizeof( double ) );
     }
 
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart, ( *short_prop[iprop] ).begin()+ipart+npart );
+        memmove( &( *short_prop[iprop] )[ipart], &( *short_prop[iprop] )[ipart+npart], nmoved*sizeof( short ) );
     }
 
     for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).erase( ( *uint64_prop[iprop] ).begin()+ipart, ( *uint64_prop[iprop] ).begin()+ipart+npart );
+        memmove( &( *uint64_prop[iprop] )[ipart], &( *uint64_prop[iprop] )[ipart+npart], nmoved*sizeof( uint64_t ) );
     }
 
+    n_particles_ -= npart;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -700,18 +785,7 @@ void Particles::push_to_end( unsigned int iPart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::create_particle()
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).push_back( 0. );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).push_back( 0 );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).push_back( 0 );
-    }
-//MESSAGE("create1");
+    resize( size()+1 );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -719,20 +793,7 @@ void Particles::create_particle()
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::create_particles( int nAdditionalParticles )
 {
-    int nParticles = size();
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0. );
-    }
-
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0 );
-    }
-
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0 );
-    }
-
-//MESSAGE("create2");
+    resize( size()+nAdditionalParticles );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -813,24 +874,30 @@ void Particles::compressParticles( int istart, int iend) {
 // }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Create nParticles new particles at the end of vectors
+// Create nParticles new particles at position pstart (following particles are shifted)
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::create_particles( int nAdditionalParticles, int pstart )
 {
-    int nParticles = size();
+    unsigned int nmoved = size() - pstart;
+    resize( size()+nAdditionalParticles );
+
     for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).insert( ( *double_prop[iprop] ).begin()+pstart, nAdditionalParticles, 0. );
+        double *data = double_prop[iprop]->data();
+        memmove( &data[pstart+nAdditionalParticles], &data[pstart], nmoved*sizeof( double ) );
+        memset( &data[pstart], 0, nAdditionalParticles*sizeof( double ) );
     }
     
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).insert( ( *short_prop[iprop] ).begin()+pstart, nAdditionalParticles, 0 );
+        short *data = short_prop[iprop]->data();
+        memmove( &data[pstart+nAdditionalParticles], &data[pstart], nmoved*sizeof( short ) );
+        memset( &data[pstart], 0, nAdditionalParticles*sizeof( short ) );
     }
     
     for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).insert( ( *uint64_prop[iprop] ).begin()+pstart, nAdditionalParticles, 0 );
+        uint64_t *data = uint64_prop[iprop]->data();
+        memmove( &data[pstart+nAdditionalParticles], &data[pstart], nmoved*sizeof( uint64_t ) );
+        memset( &data[pstart], 0, nAdditionalParticles*sizeof( uint64_t ) );
     }
-    
-//MESSAGE("create2");
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -838,18 +905,8 @@ void Particles::create_particles( int nAdditionalParticles, int pstart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::mv_particles( int iPart, int new_pos )
 {
-    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
-        ( *double_prop[iprop] ).insert( ( *double_prop[iprop] ).begin()+new_pos,( *double_prop[iprop] )[iPart]  );
-    }
-    
-    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
-        ( *short_prop[iprop] ).insert( ( *short_prop[iprop] ).begin()+new_pos, ( *short_prop[iprop] )[iPart] );
-    }
-    
-    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
-        ( *uint64_prop[iprop] ).insert( ( *uint64_prop[iprop] ).begin()+new_pos,( *uint64_prop[iprop] )[iPart]  );
-    }
-  
+    create_particles( 1, new_pos );
+    overwrite_part( new_pos <= iPart ? iPart+1 : iPart, new_pos );
     erase_particle( iPart+1 );
 }
 
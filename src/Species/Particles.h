@@ -9,6 +9,7 @@
 
 #include "Tools.h"
 #include "TimeSelection.h"
+#include "ParticleProperty.h"
 
 class Particle;
 
@@ -27,8 +28,14 @@ public:
     //! Constructor for Particle
     Particles();
 
+    //! Copy constructor: the arena is duplicated
+    Particles( const Particles &part );
+
     //! Destructor for Particle
-    ~Particles() {}
+    ~Particles();
+
+    //! Assignment: the arena is duplicated
+    Particles &operator=( const Particles &part );
 
     //! Create nParticles null particles of nDim size
     void initialize( unsigned int nParticles, unsigned int nDim );
@@ -57,13 +64,13 @@ public:
     //! Get number of particules
     inline unsigned int size() const
     {
-        return Weight.size();
+        return n_particles_;
     }
 
-    //! Get number of particules
+    //! Get number of particules that fit in the arena
     inline unsigned int capacity() const
     {
-        return Weight.capacity();
+        return capacity_;
     }
 
     //! Get dimension of particules
@@ -86,6 +93,15 @@ public:
     //! Copy particle iPart at the end of dest_parts -- safe
     void cp_particle_safe( unsigned int ipart, Particles &dest_parts );
     
+    //! Number of bytes of one particle in the buffers of pack / unpack
+    unsigned int packedSize();
+    //! Copy nPart particles starting at iPart in a contiguous buffer, property after property
+    void pack( unsigned int iPart, unsigned int nPart, char *buffer );
+    //! Append nPart particles read from a buffer filled by pack
+    void unpack( unsigned int nPart, const char *buffer );
+    //! Overwrite nPart particles starting at iPart with a buffer filled by pack
+    void unpack( unsigned int iPart, unsigned int nPart, const char *buffer );
+    
     //! Suppress particle iPart
     void erase_particle( unsigned int iPart );
     //! Suppress nPart particles from iPart
@@ -182,7 +198,7 @@ public:
     //! Method used to get the list of Particle position
     inline std::vector<double>  position( unsigned int idim ) const
     {
-        return Position[idim];
+        return Position[idim].toVector();
     }
 
     //! Method used to get the Particle momentum
@@ -198,7 +214,7 @@ public:
     //! Method used to get the Particle momentum
     inline std::vector<double>  momentum( unsigned int idim ) const
     {
-        return Momentum[idim];
+        return Momentum[idim].toVector();
     }
 
     //! Method used to get the Particle weight
@@ -214,7 +230,7 @@ public:
     //! Method used to get the Particle weight
     inline std::vector<double>  weight() const
     {
-        return Weight;
+        return Weight.toVector();
     }
 
     //! Method used to get the Particle charge
@@ -230,7 +246,7 @@ public:
     //! Method used to get the list of Particle charges
     inline std::vector<short>  charge() const
     {
-        return Charge;
+        return Charge.toVector();
     }
 
 
@@ -255,31 +271,31 @@ public:
     //! Partiles properties, respect type order : all double, all short, all unsigned int
 
     //! array containing the particle position
-    std::vector< std::vector<double> > Position;
+    std::vector< ParticleProperty<double> > Position;
 
     //! array containing the particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
+    std::vector< ParticleProperty<double> > Position_old;
 
     //! array containing the particle moments
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< ParticleProperty<double> > Momentum;
 
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Weight;
+    ParticleProperty<double> Weight;
 
     //! containing the particle quantum parameter
-    std::vector<double> Chi;
+    ParticleProperty<double> Chi;
 
     //! charge state of the particle (multiples of e>0)
-    std::vector<short> Charge;
+    ParticleProperty<short> Charge;
 
     //! Id of the particle
-    std::vector<uint64_t> Id;
+    ParticleProperty<uint64_t> Id;
 
     // Discontinuous radiation losses
 
     //! Incremental optical depth for
     //! the Monte-Carlo process
-    std::vector<double> Tau;
+    ParticleProperty<double> Tau;
 
     //! cell_keys of the particle
     std::vector<int> cell_keys;
@@ -312,7 +328,7 @@ public:
     //! Method used to get the Particle Ids
     inline std::vector<uint64_t> id() const
     {
-        return Id;
+        return Id.toVector();
     }
     void sortById();
 
@@ -338,7 +354,7 @@ public:
     //! Method used to get the Particle chi factor
     inline std::vector<double>  chi() const
     {
-        return Chi;
+        return Chi.toVector();
     }
 
     //! Method used to get the Particle optical depth
@@ -355,13 +371,33 @@ public:
     //! Method used to get the Particle optical depth
     inline std::vector<double>  tau() const
     {
-        return Tau;
+        return Tau.toVector();
     }
 
 
-    std::vector< std::vector<double  >*> double_prop;
-    std::vector< std::vector<short   >*> short_prop;
-    std::vector< std::vector<uint64_t>*> uint64_prop;
+    //! Pointers to the active properties, sorted by type
+    std::vector< ParticleProperty<double  >*> double_prop;
+    std::vector< ParticleProperty<short   >*> short_prop;
+    std::vector< ParticleProperty<uint64_t>*> uint64_prop;
+
+    //! Pointers to the arrays of the arena, aligned on 64 bytes.
+    //! They are invalidated when the number of particles exceeds the capacity.
+    inline double *getPtrPosition( unsigned int idim )
+    {
+        return Position[idim].data();
+    }
+    inline double *getPtrMomentum( unsigned int idim )
+    {
+        return Momentum[idim].data();
+    }
+    inline double *getPtrWeight()
+    {
+        return Weight.data();
+    }
+    inline short *getPtrCharge()
+    {
+        return Charge.data();
+    }
 
 
 #ifdef __DEBUG
@@ -386,21 +422,50 @@ public:
     Particle operator()( unsigned int iPart );
 
     //! Methods to obtain any property, given its index in the arrays double_prop, uint64_prop, or short_prop
-    void getProperty( unsigned int iprop, std::vector<uint64_t> *&prop )
+    void getProperty( unsigned int iprop, ParticleProperty<uint64_t> *&prop )
     {
         prop = uint64_prop[iprop];
     }
-    void getProperty( unsigned int iprop, std::vector<short> *&prop )
+    void getProperty( unsigned int iprop, ParticleProperty<short> *&prop )
     {
         prop = short_prop[iprop];
     }
-    void getProperty( unsigned int iprop, std::vector<double> *&prop )
+    void getProperty( unsigned int iprop, ParticleProperty<double> *&prop )
     {
         prop = double_prop[iprop];
     }
 
 private:
 
+    //! Declares the active properties (once) and binds them to the arena
+    void initializeProperties( unsigned int nDim );
+
+    //! Moves all the properties to a new arena of n_part_max particles
+    void reallocate( unsigned int n_part_max );
+
+    //! Moves the properties of one type to their location in a new arena
+    template<typename T>
+    void moveProperties( std::vector< ParticleProperty<T>* > &prop_list, char *&location, size_t stride, unsigned int n_kept );
+
+    //! Binds a property to the arena sizes
+    template<typename T>
+    void bindProperty( ParticleProperty<T> &prop, std::vector< ParticleProperty<T>* > &prop_list )
+    {
+        prop.size_ = &n_particles_;
+        prop.capacity_ = &capacity_;
+        prop_list.push_back( &prop );
+    }
+
+    //! Single memory block holding all the properties.
+    //! Each property starts on a 64-byte boundary: the stride is the capacity rounded up to 64 bytes.
+    char *arena_;
+
+    //! Number of particles
+    unsigned int n_particles_;
+
+    //! Number of particles that fit in the arena
+    unsigned int capacity_;
+
 };
 
 
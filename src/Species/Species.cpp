@@ -232,10 +232,53 @@ void Species::initOperators( Params &params, Patch *patch )
             MPI_buffer_.part_index_send_sz[iDim][iNeighbor] = 0;
         }
     }
-    typePartSend.resize( nDim_particle*2, MPI_DATATYPE_NULL );
-    typePartRecv.resize( nDim_particle*2, MPI_DATATYPE_NULL );
-    exchangePatch = MPI_DATATYPE_NULL;
+    for( unsigned int i=0 ; i<MPI_buffer_.partSendAll.size() ; i++ ) {
+        MPI_buffer_.partSendAll[i].initialize( 0, ( *particles ) );
+    }
+
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Prepare the species of a patch recycled by the moving window:
+// the particles are discarded but their buffers are kept, the operators depending on the patch position are re-created
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::recycle( Params &params, Patch *patch )
+{
+    particles->clear();
+    for( unsigned int ibin=0 ; ibin<first_index.size() ; ibin++ ) {
+        first_index[ibin] = 0;
+        last_index[ibin] = 0;
+    }
+
+    min_loc_vec = patch->getDomainLocalMin();
+    min_loc = patch->getDomainLocalMin( 0 );
+
+    nrj_bc_lost = 0.;
+    nrj_mw_lost = 0.;
+    new_particles_energy_ = 0.;
+    nrj_radiation = 0.;
 
+    delete Interp;
+    Interp = InterpolatorFactory::create( params, patch, this->vectorized_operators && !params.cell_sorting );
+
+    delete Proj;
+    Proj = ProjectorFactory::create( params, patch, this->vectorized_operators && !params.cell_sorting );
+
+    delete partBoundCond;
+    partBoundCond = new PartBoundCond( params, this, patch );
+
+    for( unsigned int iDim=0 ; iDim < nDim_particle ; iDim++ ) {
+        for( unsigned int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            MPI_buffer_.partRecv[iDim][iNeighbor].clear();
+            MPI_buffer_.partSend[iDim][iNeighbor].clear();
+            MPI_buffer_.part_index_send[iDim][iNeighbor].resize( 0 );
+            MPI_buffer_.part_index_recv_sz[iDim][iNeighbor] = 0;
+            MPI_buffer_.part_index_send_sz[iDim][iNeighbor] = 0;
+        }
+    }
+    for( unsigned int i=0 ; i<MPI_buffer_.partSendAll.size() ; i++ ) {
+        MPI_buffer_.partSendAll[i].clear();
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -371,6 +414,7 @@ void Species::dynamics( double time_dual, unsigned int ispec,
                 // Radiation process
                 ( *Radiate )( *particles, this->photon_species, smpi,
                               RadiationTables,
+                              patch->rand_,
                               first_index[ibin], last_index[ibin], ithread );
 
                 // Update scalar variable for diagnostics
@@ -400,6 +444,7 @@ void Species::dynamics( double time_dual, unsigned int ispec,
                 ( *Multiphoton_Breit_Wheeler_process )( *particles,
                                                         smpi,
                                                         MultiphotonBreitWheelerTables,
+                                                        patch->rand_,
                                                         first_index[ibin], last_index[ibin], ithread );
 
                 // Update scalar variable for diagnostics
@@ -445,7 +490,7 @@ void Species::dynamics( double time_dual, unsigned int ispec,
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                             nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         }
                     }
@@ -454,11 +499,11 @@ void Species::dynamics( double time_dual, unsigned int ispec,
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         //}
-                        //else if ( partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                        //else if ( partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         //std::cout<<"removed particle position"<< particles->position(0,iPart)<<" , "<<particles->position(1,iPart)<<" ,"<<particles->position(2,iPart)<<std::endl;
                     }
                 }
@@ -467,7 +512,7 @@ void Species::dynamics( double time_dual, unsigned int ispec,
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                             nrj_lost_per_thd[tid] += ener_iPart;
                         }
                     }
@@ -477,7 +522,7 @@ void Species::dynamics( double time_dual, unsigned int ispec,
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += ener_iPart;
                     }
@@ -1337,7 +1382,7 @@ void Species::ponderomotiveUpdatePositionAndCurrents( double time_dual, unsigned
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                             nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         }
                     }
@@ -1347,7 +1392,7 @@ void Species::ponderomotiveUpdatePositionAndCurrents( double time_dual, unsigned
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                     }
@@ -1368,7 +1413,7 @@ void Species::ponderomotiveUpdatePositionAndCurrents( double time_dual, unsigned
                 // // apply returns 0 if iPart is not in the local domain anymore
                 // //        if omp, create a list per thread
                 // for (iPart=first_index[ibin] ; (int)iPart<last_index[ibin]; iPart++ ) {
-                //     if ( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                //     if ( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                 //         addPartInExchList( iPart );
                 //         nrj_lost_per_thd[tid] += ener_iPart;
                 //     }
@@ -200,11 +200,6 @@ public:
     //! Oversize (copy from Params)
     std::vector<unsigned int> oversize;
 
-    //! MPI structure to exchange particles
-    std::vector<MPI_Datatype> typePartSend ;
-    std::vector<MPI_Datatype> typePartRecv ;
-    MPI_Datatype exchangePatch;
-
     //! Cell_length (copy from Params)
     std::vector<double> cell_length;
     //! min_loc_vec (copy from picparams)
@@ -325,6 +320,9 @@ public:
     //! Initialize operators (must be separate from parameters init, because of cloning)
     void initOperators( Params &, Patch * );
 
+    //! Prepare the species of a patch recycled by the moving window (see Patch::recycle)
+    void recycle( Params &, Patch * );
+
     //! Method returning the Particle list for the considered Species
     inline Particles getParticlesList() const
     {
@@ -9,6 +9,14 @@
 
 #include "SpeciesMetrics.h"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+bool SpeciesMetrics::calibrated_ = false;
+double SpeciesMetrics::vecto_fit_[5] = { 0., 0., 0., 0., 0. };
+double SpeciesMetrics::scalar_fit_[2] = { 0., 0. };
+
 
 
 // -----------------------------------------------------------------------------
@@ -125,6 +133,10 @@ double SpeciesMetrics::get_particle_computation_time_vectorization(const double
 //#pragma omp declare simd
 float SpeciesMetrics::get_particle_computation_time_vectorization( const float log_particle_number )
 {
+    if( calibrated_ ) {
+        return vecto_fit_[0] + log_particle_number*( vecto_fit_[1] + log_particle_number*( vecto_fit_[2]
+                + log_particle_number*( vecto_fit_[3] + log_particle_number*vecto_fit_[4] ) ) );
+    }
 // Cascade lake 6248 (Ex: Jean Zay)
 #if defined __INTEL_CASCADELAKE_6248
     return -3.878426186471072e-03 * pow(log_particle_number,4)
@@ -185,6 +197,9 @@ double SpeciesMetrics::get_particle_computation_time_scalar(const double log_par
 //#pragma omp declare simd
 float SpeciesMetrics::get_particle_computation_time_scalar( const float log_particle_number )
 {
+    if( calibrated_ ) {
+        return scalar_fit_[0] + log_particle_number*scalar_fit_[1];
+    }
 // Cascade lake 6248 (Ex: Jean Zay)
 #if defined __INTEL_CASCADELAKE_6248
     return  -1.109419407609368e-02 * log_particle_number
@@ -211,3 +226,163 @@ float SpeciesMetrics::get_particle_computation_time_scalar( const float log_part
             + 9.405673399529412e-01;
 #endif
 };
+
+// -----------------------------------------------------------------------------
+//! Least-square fit of a polynomial of degree `n-1` (n <= 5)
+//! by solving the normal equations
+// -----------------------------------------------------------------------------
+static void polynomialFit( const std::vector<double> &x, const std::vector<double> &y, unsigned int n, double *coefficients )
+{
+    double A[5][6] = {};
+    for( unsigned int ip=0; ip<x.size(); ip++ ) {
+        double xi[5];
+        xi[0] = 1.;
+        for( unsigned int i=1; i<n; i++ ) {
+            xi[i] = xi[i-1]*x[ip];
+        }
+        for( unsigned int i=0; i<n; i++ ) {
+            for( unsigned int j=0; j<n; j++ ) {
+                A[i][j] += xi[i]*xi[j];
+            }
+            A[i][n] += xi[i]*y[ip];
+        }
+    }
+    // Gauss elimination with partial pivoting
+    for( unsigned int i=0; i<n; i++ ) {
+        unsigned int pivot = i;
+        for( unsigned int k=i+1; k<n; k++ ) {
+            if( std::fabs( A[k][i] ) > std::fabs( A[pivot][i] ) ) {
+                pivot = k;
+            }
+        }
+        for( unsigned int j=0; j<=n; j++ ) {
+            std::swap( A[i][j], A[pivot][j] );
+        }
+        for( unsigned int k=i+1; k<n; k++ ) {
+            double f = A[k][i] / A[i][i];
+            for( unsigned int j=i; j<=n; j++ ) {
+                A[k][j] -= f*A[i][j];
+            }
+        }
+    }
+    for( int i=n-1; i>=0; i-- ) {
+        double sum = A[i][n];
+        for( unsigned int j=i+1; j<n; j++ ) {
+            sum -= A[i][j]*coefficients[j];
+        }
+        coefficients[i] = sum / A[i][i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+//! Replace the compiled fits by fits of measured times.
+//! Times are normalized by the mean scalar time, as the compiled fits.
+// -----------------------------------------------------------------------------
+void SpeciesMetrics::fit( const std::vector<double> &log_particle_number,
+                          const std::vector<double> &vecto_time,
+                          const std::vector<double> &scalar_time )
+{
+    double norm = 0.;
+    for( unsigned int i=0; i<scalar_time.size(); i++ ) {
+        norm += scalar_time[i];
+    }
+    norm = scalar_time.size() / norm;
+    
+    std::vector<double> vecto( vecto_time.size() ), scalar( scalar_time.size() );
+    for( unsigned int i=0; i<vecto_time.size(); i++ ) {
+        vecto [i] = vecto_time [i] * norm;
+        scalar[i] = scalar_time[i] * norm;
+    }
+    
+    polynomialFit( log_particle_number, vecto , std::min( 5u, ( unsigned int ) vecto.size() ), vecto_fit_ );
+    polynomialFit( log_particle_number, scalar, std::min( 2u, ( unsigned int ) scalar.size() ), scalar_fit_ );
+    calibrated_ = true;
+}
+
+// -----------------------------------------------------------------------------
+//! Key of the fits file: the calibration is only valid for the same configuration
+// -----------------------------------------------------------------------------
+std::string SpeciesMetrics::fitKey( const std::string &geometry,
+                                    unsigned int interpolation_order,
+                                    const std::string &species_name,
+                                    const std::string &pusher_name )
+{
+    std::ostringstream key;
+    key << "geometry " << geometry
+        << ", interpolation order " << interpolation_order
+        << ", species " << species_name
+        << ", pusher " << pusher_name
+        << ", flags";
+#ifdef _VECTO
+    key << " _VECTO";
+#endif
+#ifdef __INTEL_CASCADELAKE_6248
+    key << " __INTEL_CASCADELAKE_6248";
+#endif
+#ifdef __INTEL_SKYLAKE_8168
+    key << " __INTEL_SKYLAKE_8168";
+#endif
+#ifdef __INTEL_KNL_7250
+    key << " __INTEL_KNL_7250";
+#endif
+#ifdef __INTEL_BDW_E5_2697_V4
+    key << " __INTEL_BDW_E5_2697_V4";
+#endif
+#ifdef __INTEL_HSW_E5_2680_v3
+    key << " __INTEL_HSW_E5_2680_v3";
+#endif
+    return key.str();
+}
+
+// -----------------------------------------------------------------------------
+//! Read the fits from a file
+// -----------------------------------------------------------------------------
+bool SpeciesMetrics::readFit( const std::string &file_name, const std::string &key )
+{
+    std::ifstream file( file_name.c_str() );
+    if( ! file.is_open() ) {
+        return false;
+    }
+    std::string header, file_key, vecto_name, scalar_name;
+    std::getline( file, header );
+    std::getline( file, file_key );
+    if( file.fail() || file_key != "# " + key ) {
+        return false;
+    }
+    double vecto_fit[5], scalar_fit[2];
+    file >> vecto_name;
+    for( unsigned int i=0; i<5; i++ ) {
+        file >> vecto_fit[i];
+    }
+    file >> scalar_name;
+    for( unsigned int i=0; i<2; i++ ) {
+        file >> scalar_fit[i];
+    }
+    if( file.fail() || vecto_name != "vectorized" || scalar_name != "scalar" ) {
+        return false;
+    }
+    std::copy( vecto_fit, vecto_fit+5, vecto_fit_ );
+    std::copy( scalar_fit, scalar_fit+2, scalar_fit_ );
+    calibrated_ = true;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+//! Write the fits in a file that `readFit` can read
+// -----------------------------------------------------------------------------
+void SpeciesMetrics::writeFit( const std::string &file_name, const std::string &key )
+{
+    std::ofstream file( file_name.c_str() );
+    file.precision( 15 );
+    file << "# Time per particle vs. log(particles per cell), coefficients in increasing powers" << std::endl;
+    file << "# " << key << std::endl;
+    file << "vectorized";
+    for( unsigned int i=0; i<5; i++ ) {
+        file << " " << vecto_fit_[i];
+    }
+    file << std::endl << "scalar";
+    for( unsigned int i=0; i<2; i++ ) {
+        file << " " << scalar_fit_[i];
+    }
+    file << std::endl;
+}
@@ -29,8 +29,37 @@ public:
                                       float &vecto_time,
                                       float &scalar_time );
                                       
+    //! Replace the compiled fits by fits of measured times per particle.
+    //! \param log_particle_number log of the numbers of particles per cell of the measurements
+    //! \param vecto_time time per particle with vectorized operators
+    //! \param scalar_time time per particle with scalar operators
+    static void fit( const std::vector<double> &log_particle_number,
+                     const std::vector<double> &vecto_time,
+                     const std::vector<double> &scalar_time );
+                     
+    //! Description of the configuration that a calibration depends on, used as key of the fits file
+    //! (geometry, interpolation order, benchmarked species and its pusher, compilation flags)
+    static std::string fitKey( const std::string &geometry,
+                               unsigned int interpolation_order,
+                               const std::string &species_name,
+                               const std::string &pusher_name );
+                               
+    //! Read the fits from a file written by `writeFit`.
+    //! Returns false if the file cannot be used or was written with a different `key`.
+    static bool readFit( const std::string &file_name, const std::string &key );
+    
+    //! Write the current fits to a file, with their `key`
+    static void writeFit( const std::string &file_name, const std::string &key );
+    
 protected:
 
+    //! True when the fits below replace the compiled ones
+    static bool calibrated_;
+    
+    //! Coefficients of the calibrated fits, in increasing powers of the log of the number of particles
+    static double vecto_fit_[5];
+    static double scalar_fit_[2];
+    
     //! Evaluate the time necessary to compute `particle_number` particles
     //! using vectorized operators
     //static double get_particle_computation_time_vectorization(const double log_particle_number);
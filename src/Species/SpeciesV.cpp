@@ -209,6 +209,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                     // Radiation process
                     ( *Radiate )( *particles, this->photon_species, smpi,
                                   RadiationTables,
+                                  patch->rand_,
                                   first_index[scell], last_index[scell], ithread );
 
                     // Update scalar variable for diagnostics
@@ -237,6 +238,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                     ( *Multiphoton_Breit_Wheeler_process )( *particles,
                                                             smpi,
                                                             MultiphotonBreitWheelerTables,
+                                                            patch->rand_,
                                                             first_index[scell], last_index[scell], ithread );
 
                     // Update scalar variable for diagnostics
@@ -285,7 +287,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                     for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                         for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                             double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                                 nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                             }
                         }
@@ -295,7 +297,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                     // apply returns 0 if iPart is not in the local domain anymore
 
                     for( iPart=first_index[ipack*packsize_+scell] ; ( int )iPart<last_index[ipack*packsize_+scell]; iPart++ ) {
-                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                        if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                             addPartInExchList( iPart );
                             nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                             particles->cell_keys[iPart] = -1;
@@ -315,7 +317,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                     for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                         for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                             double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                                 nrj_lost_per_thd[tid] += ener_iPart;
                             }
                         }
@@ -324,7 +326,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                     // Boundary Condition may be physical or due to domain decomposition
                     // apply returns 0 if iPart is not in the local domain anymore
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                        if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                             addPartInExchList( iPart );
                             nrj_lost_per_thd[tid] += ener_iPart;
                             particles->cell_keys[iPart] = -1;
@@ -773,7 +775,7 @@ void SpeciesV::mergeParticles( double time_dual, unsigned int ispec,
 
         // For each cell, we apply independently the merging process
         for( scell = 0 ; scell < first_index.size() ; scell++ ) {
-            ( *Merge )( mass_, *particles, particles->cell_keys, smpi, first_index[scell],
+            ( *Merge )( mass_, *particles, particles->cell_keys, smpi, patch->rand_, first_index[scell],
                         last_index[scell], count[scell]);
         }
 
@@ -1133,7 +1135,7 @@ void SpeciesV::ponderomotiveUpdatePositionAndCurrents( double time_dual, unsigne
                     for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                         for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                             double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                                 nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                             }
                         }
@@ -1142,7 +1144,7 @@ void SpeciesV::ponderomotiveUpdatePositionAndCurrents( double time_dual, unsigne
                     // Boundary Condition may be physical or due to domain decomposition
                     // apply returns 0 if iPart is not in the local domain anymore
                     for( iPart=first_index[ipack*packsize_+scell] ; ( int )iPart<last_index[ipack*packsize_+scell]; iPart++ ) {
-                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                        if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                             addPartInExchList( iPart );
                             nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                             particles->cell_keys[iPart] = -1;
@@ -1204,3 +1206,94 @@ void SpeciesV::ponderomotiveUpdatePositionAndCurrents( double time_dual, unsigne
     }//END if time vs. time_frozen_
 
 } // end ponderomotiveUpdatePositionAndCurrents
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Measure the time per particle of the operators that the adaptive vectorization switches.
+//! The particles are created in the first cells of the patch, sorted as the species particles,
+//! and are pushed from the same state at each repetition. Currents are projected in the patch.
+// ---------------------------------------------------------------------------------------------------------------------
+double SpeciesV::benchmarkOperators( Params &params, Patch *patch, SmileiMPI *smpi,
+                                     unsigned int particles_per_cell, bool vectorized )
+{
+    int ithread;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#else
+    ithread = 0;
+#endif
+
+    // Limit the number of particles at large numbers of particles per cell
+    unsigned int ncells = first_index.size();
+    ncells = std::min( ncells, std::max( 1u, 32768u / particles_per_cell ) );
+    unsigned int npart = ncells * particles_per_cell;
+
+    std::vector<int> first( ncells ), last( ncells );
+    for( unsigned int icell=0; icell<ncells; icell++ ) {
+        first[icell] = icell * particles_per_cell;
+        last [icell] = first[icell] + particles_per_cell;
+    }
+
+    Particles bench;
+    bench.initialize( npart, *particles );
+
+    Interpolator *interp = InterpolatorFactory::create( params, patch, vectorized );
+    Projector *proj = ProjectorFactory::create( params, patch, vectorized );
+    smpi->dynamics_resize( ithread, nDim_field, npart, params.geometry=="AMcylindrical" );
+
+    // Enough repetitions to measure about 1e6 particle updates
+    unsigned int nrepetitions = std::min( 100u, std::max( 5u, 1000000u / npart ) );
+    double best_time = 0.;
+    for( unsigned int irep=0; irep<nrepetitions; irep++ ) {
+
+        // Quasi-random positions in each cell, particles at rest
+        for( unsigned int icell=0; icell<ncells; icell++ ) {
+            unsigned int index[3];
+            unsigned int rem = icell;
+            for( int idim=nDim_particle-1; idim>=0; idim-- ) {
+                index[idim] = rem % ( params.n_space[idim]+1 );
+                rem /= params.n_space[idim]+1;
+            }
+            for( int ip=first[icell]; ip<last[icell]; ip++ ) {
+                double r = ip - first[icell] + 0.5;
+                for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+                    double shift = r * ( idim==0 ? 0.7548776662 : ( idim==1 ? 0.5698402910 : 0.4301597090 ) );
+                    bench.position( idim, ip ) = min_loc_vec[idim] + ( index[idim] + shift - floor( shift ) - 0.5 ) * cell_length[idim];
+                    if( bench.Position_old.size() > 0 ) {
+                        bench.position_old( idim, ip ) = bench.position( idim, ip );
+                    }
+                }
+                for( unsigned int idim=0; idim<3; idim++ ) {
+                    bench.momentum( idim, ip ) = 0.;
+                }
+                bench.weight( ip ) = 1.;
+                bench.charge( ip ) = 1;
+            }
+        }
+
+        double time = MPI_Wtime();
+        if( vectorized ) {
+            for( unsigned int icell=0; icell<ncells; icell++ ) {
+                interp->fieldsWrapper( patch->EMfields, bench, smpi, &( first[icell] ), &( last[icell] ), ithread, 0 );
+            }
+            ( *Push )( bench, smpi, 0, npart, ithread, 0 );
+            for( unsigned int icell=0; icell<ncells; icell++ ) {
+                proj->currentsAndDensityWrapper( patch->EMfields, bench, smpi, first[icell], last[icell], ithread,
+                                                 false, params.is_spectral, species_number_, icell, 0 );
+            }
+        } else {
+            interp->fieldsWrapper( patch->EMfields, bench, smpi, &( first[0] ), &( last[ncells-1] ), ithread, 0 );
+            ( *Push )( bench, smpi, 0, npart, ithread, 0 );
+            proj->currentsAndDensityWrapper( patch->EMfields, bench, smpi, 0, npart, ithread,
+                                             false, params.is_spectral, species_number_ );
+        }
+        time = MPI_Wtime() - time;
+        if( irep == 0 || time < best_time ) {
+            best_time = time;
+        }
+    }
+
+    delete interp;
+    delete proj;
+
+    return best_time / npart;
+}
@@ -94,6 +94,12 @@ public:
                                  SmileiMPI *smpi,
                                  std::vector<Diagnostic *> &localDiags )override;
 
+    //! Time per particle of the interpolator, pusher and projector, measured on
+    //! synthetic particles with `particles_per_cell` particles in each cell,
+    //! with either the scalar or the vectorized operators
+    double benchmarkOperators( Params &params, Patch *patch, SmileiMPI *smpi,
+                               unsigned int particles_per_cell, bool vectorized );
+
 private:
 
     //! Number of packs of particles that divides the total number of particles
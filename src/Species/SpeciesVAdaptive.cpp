@@ -144,6 +144,7 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
                 // Radiation process
                 ( *Radiate )( *particles, this->photon_species, smpi,
                               RadiationTables,
+                              patch->rand_,
                               first_index[scell], last_index[scell], ithread );
 
                 // Update scalar variable for diagnostics
@@ -169,6 +170,7 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
                 ( *Multiphoton_Breit_Wheeler_process )( *particles,
                                                         smpi,
                                                         MultiphotonBreitWheelerTables,
+                                                        patch->rand_,
                                                         first_index[scell], last_index[scell], ithread );
 
                 // Update scalar variable for diagnostics
@@ -210,14 +212,14 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                             nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         }
                     }
                 }
 
                 for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         particles->cell_keys[iPart] = -1;
@@ -236,7 +238,7 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                             nrj_lost_per_thd[tid] += ener_iPart;
                         }
                     }
@@ -246,7 +248,7 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += ener_iPart;
                         particles->cell_keys[iPart] = -1;
@@ -603,7 +605,7 @@ void SpeciesVAdaptive::scalarPonderomotiveUpdatePositionAndCurrents( double time
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, patch->rand_, ener_iPart ) ) {
                             nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         }
                     }
@@ -613,7 +615,7 @@ void SpeciesVAdaptive::scalarPonderomotiveUpdatePositionAndCurrents( double time
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, patch->rand_, ener_iPart ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass_ * ener_iPart;
                         particles->cell_keys[iPart] = -1;
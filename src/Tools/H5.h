@@ -382,6 +382,27 @@ public:
         H5Dclose( did );
     }
     
+    //! Read a vector into an existing array of the given size
+    //! type is the h5 type (H5T_NATIVE_DOUBLE, H5T_NATIVE_INT, etc.)
+    template<class T>
+    static void getVect( hid_t locationId, std::string vect_name, T &v, unsigned int size, hid_t type )
+    {
+        hid_t did = H5Dopen( locationId, vect_name.c_str(), H5P_DEFAULT );
+        hid_t sid = H5Dget_space( did );
+        int sdim = H5Sget_simple_extent_ndims( sid );
+        if( sdim!=1 ) {
+            ERROR( "Reading vector " << vect_name << " is not 1D but " <<sdim << "D" );
+        }
+        hsize_t dim[1];
+        H5Sget_simple_extent_dims( sid, dim, NULL );
+        if( dim[0] != size ) {
+            ERROR( "Reading vector " << vect_name << " mismatch " << size << " != " << dim[0] );
+        }
+        H5Sclose( sid );
+        H5Dread( did, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, &v );
+        H5Dclose( did );
+    }
+    
     static int getVectSize( hid_t locationId, std::string vect_name )
     {
         if( H5Lexists( locationId, vect_name.c_str(), H5P_DEFAULT ) >0 ) {
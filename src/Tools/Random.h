@@ -0,0 +1,193 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+//! Counter-based random number generator (Philox4x32-10, Salmon et al., SC'11)
+//!
+//! Each patch owns one generator whose key is built from the namelist
+//! random_seed and the patch Hilbert index, so that the random sequence of a
+//! patch does not depend on the number of threads or on the patch owner.
+//! Patches created by the moving window reuse Hilbert indices: they are
+//! distinguished by a generation number stored in the third counter word.
+//! As the random numbers are a pure function of (key, counter), arrays of
+//! random numbers can be computed in vectorized loops (see the bulk methods).
+class Random
+{
+public:
+    //! Creator: the pair (seed, stream) defines the key of the generator
+    Random( unsigned int seed, unsigned int stream, unsigned int generation )
+    {
+        key_[0] = seed;
+        key_[1] = stream;
+        generation_ = generation;
+        counter_ = 0;
+        buffer_index_ = 4;
+    }
+
+    ~Random() {};
+
+    //! Philox4x32-10 bijection: computes 4 random integers from a counter and a key
+    #pragma omp declare simd uniform( generation, k0, k1 )
+    static inline void philox( uint64_t counter, uint32_t generation, uint32_t k0, uint32_t k1,
+                               uint32_t &r0, uint32_t &r1, uint32_t &r2, uint32_t &r3 )
+    {
+        uint32_t c0 = ( uint32_t )counter;
+        uint32_t c1 = ( uint32_t )( counter >> 32 );
+        uint32_t c2 = generation;
+        uint32_t c3 = 0;
+        for( int iround = 0 ; iround < 10 ; iround++ ) {
+            uint64_t p0 = ( uint64_t )0xD2511F53 * c0;
+            uint64_t p1 = ( uint64_t )0xCD9E8D57 * c2;
+            uint32_t hi0 = ( uint32_t )( p0 >> 32 );
+            uint32_t hi1 = ( uint32_t )( p1 >> 32 );
+            c0 = hi1 ^ c1 ^ k0;
+            c2 = hi0 ^ c3 ^ k1;
+            c1 = ( uint32_t )p1;
+            c3 = ( uint32_t )p0;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        r0 = c0;
+        r1 = c1;
+        r2 = c2;
+        r3 = c3;
+    }
+
+    //! Converts two random integers into a double in [0, 1[ with 53 random bits
+    #pragma omp declare simd
+    static inline double toDouble( uint32_t a, uint32_t b )
+    {
+        return ( ( double )( a >> 5 ) * 67108864. + ( double )( b >> 6 ) ) * ( 1. / 9007199254740992. );
+    }
+
+    //! Random integer in [0, 2^32[
+    inline uint32_t integer()
+    {
+        if( buffer_index_ > 3 ) {
+            philox( counter_, generation_, key_[0], key_[1], buffer_[0], buffer_[1], buffer_[2], buffer_[3] );
+            counter_++;
+            buffer_index_ = 0;
+        }
+        return buffer_[buffer_index_++];
+    }
+
+    //! Random double in [0, 1[
+    inline double uniform()
+    {
+        uint32_t a = integer();
+        uint32_t b = integer();
+        return toDouble( a, b );
+    }
+
+    //! Random double in [0, 1-1e-11[
+    inline double uniform1()
+    {
+        return uniform() * ( 1. - 1e-11 );
+    }
+
+    //! Random double in [-1, 1[
+    inline double uniform2()
+    {
+        return 2. * uniform() - 1.;
+    }
+
+    //! Random double in [0, 2pi[
+    inline double uniform_2pi()
+    {
+        return uniform() * 6.283185307179586;
+    }
+
+    //! Random double following a normal distribution of standard deviation `stddev` (Box-Muller)
+    inline double normal( double stddev )
+    {
+        double u1 = 1. - uniform();
+        double u2 = uniform();
+        return stddev * std::sqrt( -2. * std::log( u1 ) ) * std::cos( 6.283185307179586 * u2 );
+    }
+
+    //! Fills `n` doubles in [0, 1[ in a vectorized loop
+    inline void uniform( double *array, int n )
+    {
+        const uint32_t generation = generation_;
+        const uint32_t k0 = key_[0];
+        const uint32_t k1 = key_[1];
+        const uint64_t counter = counter_;
+        const int nblocks = n/2;
+        // The remaining buffered integers are dropped, so that the buffer
+        // always holds the block at counter_-1 (which setState relies on)
+        if( nblocks > 0 ) {
+            buffer_index_ = 4;
+        }
+        #pragma omp simd
+        for( int iblock = 0 ; iblock < nblocks ; iblock++ ) {
+            uint32_t r0, r1, r2, r3;
+            philox( counter + iblock, generation, k0, k1, r0, r1, r2, r3 );
+            array[2*iblock  ] = toDouble( r0, r1 );
+            array[2*iblock+1] = toDouble( r2, r3 );
+        }
+        counter_ += nblocks;
+        if( n%2 ) {
+            array[n-1] = uniform();
+        }
+    }
+
+    //! Fills `n` doubles in [-1, 1[ in a vectorized loop
+    inline void uniform2( double *array, int n )
+    {
+        uniform( array, n );
+        #pragma omp simd
+        for( int i = 0 ; i < n ; i++ ) {
+            array[i] = 2. * array[i] - 1.;
+        }
+    }
+
+    //! State of the generator, for checkpoints
+    std::vector<unsigned int> getState()
+    {
+        std::vector<unsigned int> state( 6 );
+        state[0] = key_[0];
+        state[1] = key_[1];
+        state[2] = generation_;
+        state[3] = ( uint32_t )counter_;
+        state[4] = ( uint32_t )( counter_ >> 32 );
+        state[5] = buffer_index_;
+        return state;
+    }
+
+    //! Restores the state of the generator, from checkpoints
+    void setState( std::vector<unsigned int> &state )
+    {
+        key_[0] = state[0];
+        key_[1] = state[1];
+        generation_ = state[2];
+        counter_ = ( ( uint64_t )state[4] << 32 ) | state[3];
+        buffer_index_ = state[5];
+        // Regenerate the partially consumed buffer
+        if( buffer_index_ < 4 && counter_ > 0 ) {
+            philox( counter_-1, generation_, key_[0], key_[1], buffer_[0], buffer_[1], buffer_[2], buffer_[3] );
+        } else {
+            buffer_index_ = 4;
+        }
+    }
+
+private:
+    //! Key of the generator
+    uint32_t key_[2];
+
+    //! Generation of the patch (fixed part of the counter)
+    uint32_t generation_;
+
+    //! Counter of the generator (number of 128-bit blocks generated so far)
+    uint64_t counter_;
+
+    //! Buffer of random integers for the scalar methods
+    uint32_t buffer_[4];
+
+    //! Index of the next unused integer in buffer_
+    unsigned int buffer_index_;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "TableCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "SmileiMPI.h"
+#include "Tools.h"
+
+// Identifier and version of the file format
+static const char cache_magic[8] = { 'S', 'M', 'I', 'T', 'A', 'B', 'L', '1' };
+
+TableCache::TableCache( std::string path, std::string name ) :
+    path_( path ),
+    name_( name ),
+    key_( name )
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 64-bit FNV-1a hash of the parameters
+// ---------------------------------------------------------------------------------------------------------------------
+uint64_t TableCache::hash() const
+{
+    uint64_t h = 14695981039346656037ULL;
+    for( unsigned int i=0; i<key_.size(); i++ ) {
+        h ^= ( uint64_t )( unsigned char )key_[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::string TableCache::filename() const
+{
+    std::ostringstream name;
+    name << path_ << "/" << name_ << "_" << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash() << ".bin";
+    return name.str();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// File layout: magic, key size, key, number of tables, size of each table, tables
+// Each rank maps the file and checks that the key and the sizes match before copying the tables
+// ---------------------------------------------------------------------------------------------------------------------
+bool TableCache::load( SmileiMPI *smpi, std::initializer_list<std::vector<double> *> tables )
+{
+    if( path_.empty() ) {
+        return false;
+    }
+
+    uint64_t expected_size = sizeof( cache_magic ) + sizeof( uint64_t ) + key_.size()
+                             + sizeof( uint64_t )*( 1 + tables.size() );
+    for( auto table : tables ) {
+        expected_size += table->size()*sizeof( double );
+    }
+
+    int ok = 0;
+    int fd = open( filename().c_str(), O_RDONLY );
+    if( fd >= 0 ) {
+        struct stat st;
+        if( fstat( fd, &st ) == 0 && ( uint64_t )st.st_size == expected_size ) {
+            void *map = mmap( NULL, expected_size, PROT_READ, MAP_SHARED, fd, 0 );
+            if( map != MAP_FAILED ) {
+                const char *p = static_cast<const char *>( map );
+                uint64_t n;
+                ok = memcmp( p, cache_magic, sizeof( cache_magic ) ) == 0;
+                p += sizeof( cache_magic );
+                memcpy( &n, p, sizeof( n ) );
+                p += sizeof( n );
+                ok = ok && n == key_.size() && memcmp( p, key_.data(), n ) == 0;
+                p += key_.size();
+                memcpy( &n, p, sizeof( n ) );
+                p += sizeof( n );
+                ok = ok && n == tables.size();
+                for( auto table : tables ) {
+                    memcpy( &n, p, sizeof( n ) );
+                    p += sizeof( n );
+                    ok = ok && n == table->size();
+                }
+                if( ok ) {
+                    for( auto table : tables ) {
+                        memcpy( table->data(), p, table->size()*sizeof( double ) );
+                        p += table->size()*sizeof( double );
+                    }
+                }
+                munmap( map, expected_size );
+            }
+        }
+        close( fd );
+    }
+
+    // The cache is used only if all ranks could read it
+    MPI_Allreduce( MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, smpi->getGlobalComm() );
+    return ok;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// The file is written under a temporary name then renamed,
+// so that concurrent runs never read a partial file
+// ---------------------------------------------------------------------------------------------------------------------
+void TableCache::store( SmileiMPI *smpi, std::initializer_list<const std::vector<double> *> tables )
+{
+    if( path_.empty() || smpi->getRank() != 0 ) {
+        return;
+    }
+
+    std::string final_name = filename();
+    std::ostringstream tmp_name;
+    tmp_name << final_name << ".tmp" << getpid();
+
+    std::ofstream file( tmp_name.str().c_str(), std::ios::binary );
+    if( ! file.is_open() ) {
+        WARNING( "Could not write the table cache `" << final_name << "`" );
+        return;
+    }
+
+    uint64_t n = key_.size();
+    file.write( cache_magic, sizeof( cache_magic ) );
+    file.write( ( char * )&n, sizeof( n ) );
+    file.write( key_.data(), key_.size() );
+    n = tables.size();
+    file.write( ( char * )&n, sizeof( n ) );
+    for( auto table : tables ) {
+        n = table->size();
+        file.write( ( char * )&n, sizeof( n ) );
+    }
+    for( auto table : tables ) {
+        file.write( ( char * )table->data(), table->size()*sizeof( double ) );
+    }
+    file.close();
+
+    if( file.fail() || rename( tmp_name.str().c_str(), final_name.c_str() ) != 0 ) {
+        remove( tmp_name.str().c_str() );
+        WARNING( "Could not write the table cache `" << final_name << "`" );
+        return;
+    }
+
+    MESSAGE( 2, "Tables stored in the cache `" << final_name << "`" );
+}
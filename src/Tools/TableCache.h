@@ -0,0 +1,61 @@
+#ifndef TABLECACHE_H
+#define TABLECACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <initializer_list>
+
+class SmileiMPI;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class TableCache
+//! On-disk cache of tables generated at startup (QED tables).
+//! The cache file is named after a hash of the parameters the tables depend on,
+//! so that a run with the same parameters reads the tables instead of computing them.
+//! All ranks map the file read-only: the tables are neither recomputed nor broadcast,
+//! and the file pages are shared by all the ranks of a node.
+//  --------------------------------------------------------------------------------------------------------------------
+class TableCache
+{
+public:
+    //! \param path directory of the cache (cache disabled if empty)
+    //! \param name name of the table(s)
+    TableCache( std::string path, std::string name );
+    ~TableCache() {};
+
+    //! Add a parameter the tables depend on
+    template<typename T>
+    TableCache &operator<<( const T &value )
+    {
+        const char *bytes = reinterpret_cast<const char *>( &value );
+        key_.append( bytes, sizeof( T ) );
+        return *this;
+    }
+
+    //! Name of the cache file
+    std::string filename() const;
+
+    //! Read the tables from the cache, on all ranks.
+    //! The tables must already have their final size.
+    //! Returns false (on all ranks) if the cache is disabled, missing or invalid.
+    bool load( SmileiMPI *smpi, std::initializer_list<std::vector<double> *> tables );
+
+    //! Write the tables in the cache (rank 0 only)
+    void store( SmileiMPI *smpi, std::initializer_list<const std::vector<double> *> tables );
+
+private:
+    //! Directory of the cache
+    std::string path_;
+
+    //! Name of the table(s)
+    std::string name_;
+
+    //! Raw bytes of the parameters
+    std::string key_;
+
+    //! 64-bit FNV-1a hash of the parameters
+    uint64_t hash() const;
+};
+
+#endif
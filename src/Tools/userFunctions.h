@@ -50,7 +50,29 @@ public:
     static int searchValuesInMonotonicArray( double *array,
                                      double elem,
                                      int nb_elems );
-                                     
+
+    //! \brief Same as searchValuesInMonotonicArray for array[0] < elem <= array[nb_elems-1],
+    //! without branches: the number of steps only depends on nb_elems,
+    //! so that it can be called in vectorized loops over particles.
+    //
+    //! \param array array in which to find the value
+    //! \param elem element to be found
+    //! \param nb_elem number of elements
+    #pragma omp declare simd uniform( nb_elems )
+    static inline int searchValuesInMonotonicArrayBranchless( const double *array,
+            double elem,
+            int nb_elems )
+    {
+        // Last index i <= nb_elems-2 such that array[i] <= elem
+        int imin = 0;
+        for( int length = nb_elems-1 ; length > 1 ; ) {
+            int half = length/2;
+            imin = ( array[imin+half] <= elem ) ? imin+half : imin;
+            length -= half;
+        }
+        return imin;
+    }
+
 private:
 
 
@@ -0,0 +1,28 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+def same(a, b):
+	return a.shape == b.shape and bool(np.all( (a==b) | (np.isnan(a) & np.isnan(b)) ))
+
+# COMPILED AND PYTHON FILTERS SELECT THE SAME PARTICLES AT ALL ITERATIONS
+compiled = S.TrackParticles.eon_compiled(axes=["x", "px", "Ex"])
+python   = S.TrackParticles.eon_python  (axes=["x", "px", "Ex"])
+Validate("Same timesteps for compiled and python filters", list(compiled.getTimesteps()) == list(python.getTimesteps()))
+compiled = compiled.getData()
+python   = python  .getData()
+Validate("Some particles are tracked", np.sum(~np.isnan(compiled["x"][-1])) > 0)
+for axis in ["x", "px", "Ex"]:
+	Validate("Compiled filter matches python filter for "+axis, same(compiled[axis], python[axis]))
+
+# FILTER DEPENDING ON Main.iteration: ions are frozen on a regular grid, so that
+# the number of tracked ions grows linearly with the iteration
+T = S.namelist.T
+ions = S.TrackParticles.ion(axes=["x"])
+timesteps = ions.getTimesteps()
+x = ions.getData()["x"]
+n_tracked = np.sum(~np.isnan(x), axis=1)
+n_expected = [ int(round(S.namelist.L / S.namelist.dx * t / T)) * 8 for t in timesteps ]
+Validate("Number of ions tracked by the iteration-dependent filter", list(n_tracked) == n_expected)
+Validate("All tracked ions are in the selected region", all([np.nanmax(x[i]) < S.namelist.L * t / T for i, t in enumerate(timesteps)]))
@@ -0,0 +1,39 @@
+import os, re, numpy as np, math, h5py
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+fields = S.namelist.fields
+timesteps = S.Field.Field0("Ey").getTimesteps()
+
+# SAME TIMESTEPS IN ALL FIELD DIAGS
+for diag in [1, 2, 3]:
+	Validate("Timesteps of Field"+str(diag)+" match Field0", list(S.Field(diag, "Ey").getTimesteps()) == list(timesteps))
+
+# THE FIELDS MUST NOT BE ZERO, OTHERWISE THE COMPARISONS BELOW ARE MEANINGLESS
+Validate("Laser and plasma fields are not zero", all([np.abs(S.Field.Field0(field, timesteps=timesteps[-1]).getData()[0]).max() > 0. for field in fields]))
+
+# LOSSLESS COMPRESSION GIVES THE SAME DATA
+for diag in [1, 2]:
+	for field in fields:
+		F0 = np.array(S.Field(0   , field).getData())
+		F  = np.array(S.Field(diag, field).getData())
+		Validate("Field"+str(diag)+" "+field+" matches the uncompressed data", np.array_equal(F0, F))
+
+# LOSSY COMPRESSION KEEPS compression_level DECIMAL DIGITS
+for field in fields:
+	F0 = np.array(S.Field(0, field).getData())
+	F  = np.array(S.Field(3, field).getData())
+	Validate("Field3 "+field+" within the scale-offset precision", np.abs(F-F0).max() < 1e-4)
+
+# THE DATASETS ARE ACTUALLY COMPRESSED
+with h5py.File("./restart000/Fields0.h5", "r") as f:
+	d = f["data/%010d/Ey" % timesteps[-1]]
+	Validate("Field0 is not compressed", d.compression is None and d.scaleoffset is None)
+for diag in [1, 2]:
+	with h5py.File("./restart000/Fields%d.h5" % diag, "r") as f:
+		d = f["data/%010d/Ey" % timesteps[-1]]
+		Validate("Field"+str(diag)+" is deflated", d.compression == "gzip" and d.shuffle)
+with h5py.File("./restart000/Fields3.h5", "r") as f:
+	d = f["data/%010d/Ey" % timesteps[-1]]
+	Validate("Field3 has the scale-offset filter", d.scaleoffset == 4)
@@ -0,0 +1,18 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The laser entering from xmin is tabulated, the one from xmax is not:
+# the fields must be mirrored with respect to x = Lx/2 (up to a sign that
+# depends on the propagation direction) within the interpolation error of the table
+timesteps = S.Field.Field0("Ey").getTimesteps()
+for field in ["Ey", "Ez"]:
+	errors = []
+	for t in timesteps[1:]:
+		F = S.Field.Field0(field, timesteps=t).getData()[0]
+		amplitude = np.abs(F).max()
+		mirror = F[::-1,:]
+		error = min(np.abs(F-mirror).max(), np.abs(F+mirror).max())
+		errors += [error / amplitude]
+	Validate("Tabulated and python "+field+" are symmetric", max(errors) < 0.02)
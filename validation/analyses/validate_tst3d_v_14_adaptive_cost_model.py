@@ -0,0 +1,28 @@
+# ____________________________________________________________________________
+#
+# This script validates the adaptive vectorization with a measured cost model
+#
+# _____________________________________________________________________________
+
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The cost model file is written with the key of the calibrated configuration
+with open("./restart000/cost_model.txt") as f:
+	lines = f.read().splitlines()
+Validate("Cost model file key", lines[1].startswith("# geometry 3Dcartesian, interpolation order 2, species positron, pusher boris, flags"))
+vectorized = lines[2].split()
+scalar     = lines[3].split()
+Validate("Cost model file fits", vectorized[0]=="vectorized" and len(vectorized)==6 and scalar[0]=="scalar" and len(scalar)==3)
+Validate("Cost model fits are finite", all([np.isfinite(float(c)) for c in vectorized[1:]+scalar[1:]]))
+
+# The operators benchmarked at startup must not affect the physics
+ntot = np.array(S.Scalar("Ntot_electron").getData())
+Validate("Number of electrons is constant", bool(np.all(ntot == ntot[0])))
+
+# (currents projected by the benchmark would break the energy balance)
+utot = np.array(S.Scalar("Utot").getData())
+Validate("Total energy is conserved", np.abs(utot/utot[0]-1.).max() < 1e-2)
+